@@ -0,0 +1,510 @@
+#!/usr/bin/env python3
+"""
+Synthetic ASUS TUF hardware tree for benchmarks and closed-loop tests.
+
+Builds a fake /sys + /proc (+ a little /etc) under ROOT that mirrors what the
+app reads on a real TUF laptop, then (optionally) animates it over time:
+
+    ./fake_hwtree.py /tmp/tuf --fans 2 --temps 4 --cpus 16 --animate
+    ASUS_TUF_SYSROOT=/tmp/tuf ./AsusTufFanControl_Linux
+    # or: ./AsusTufFanControl_Linux --sysroot=/tmp/tuf
+
+Animation is closed-loop: fan RPM follows the throttle_thermal_policy and
+pwmN/pwmN_enable values the app writes, temperatures follow a synthetic load,
+/proc/stat and /proc/net/dev counters advance at the simulated rates.
+
+Files are always rewritten in place (truncate + write), never replaced by
+rename, because the app keeps sysfs descriptors open and re-reads them.
+
+Other scripts can import this module and call build_tree() / Simulator.step()
+directly, or simply write to the generated files.
+"""
+
+import argparse
+import json
+import math
+import os
+import random
+import time
+
+POLICY_BALANCED, POLICY_TURBO, POLICY_SILENT = 0, 1, 2
+
+
+def write(root, rel, value):
+    """Create or rewrite a file in place (keeps the inode stable)."""
+    path = os.path.join(root, rel.lstrip('/'))
+    os.makedirs(os.path.dirname(path), exist_ok=True)
+    fd = os.open(path, os.O_WRONLY | os.O_CREAT | os.O_TRUNC, 0o644)
+    try:
+        os.write(fd, str(value).encode())
+    finally:
+        os.close(fd)
+
+
+def write_bytes(root, rel, data):
+    """Like write(), for binary content."""
+    path = os.path.join(root, rel.lstrip('/'))
+    os.makedirs(os.path.dirname(path), exist_ok=True)
+    fd = os.open(path, os.O_WRONLY | os.O_CREAT | os.O_TRUNC, 0o644)
+    try:
+        os.write(fd, data)
+    finally:
+        os.close(fd)
+
+
+def read(root, rel, default=''):
+    try:
+        with open(os.path.join(root, rel.lstrip('/'))) as f:
+            return f.read().strip()
+    except OSError:
+        return default
+
+
+def read_int(root, rel, default=0):
+    try:
+        return int(read(root, rel, str(default)).split()[0])
+    except (ValueError, IndexError):
+        return default
+
+
+def symlink(root, link_rel, target_rel):
+    link = os.path.join(root, link_rel.lstrip('/'))
+    target = os.path.join(root, target_rel.lstrip('/'))
+    os.makedirs(os.path.dirname(link), exist_ok=True)
+    if os.path.islink(link) or os.path.exists(link):
+        return
+    os.symlink(os.path.relpath(target, os.path.dirname(link)), link)
+
+
+class Config:
+    def __init__(self, args):
+        self.fans = args.fans
+        self.temps = args.temps
+        self.cpus = args.cpus
+        self.batteries = [b for b in args.batteries.split(',') if b]
+        self.gpu = args.gpu
+        self.interfaces = [i for i in args.interfaces.split(',') if i]
+        self.model = args.model
+        self.ec_map = getattr(args, 'ec_map', False)
+
+
+# --- Tree construction ---
+
+WMI_DIR = '/sys/devices/platform/asus-nb-wmi'
+WMI_HWMON = WMI_DIR + '/hwmon/hwmon1'
+LEDS_DIR = '/sys/class/leds/asus::kbd_backlight'
+GPU_DEV = '/sys/devices/pci0000:00/0000:03:00.0'
+EC_MAP_FILE = '/etc/asus_tuf_ec_registers.json'
+FAKE_VRAM_TOTAL = 4 << 30
+FAKE_VRAM_IDLE = 256 << 20
+FAKE_EC_REGISTERS = {'cpuDuty': '0x10', 'gpuDuty': '0x11', 'maxDuty': 255,
+                     'mode': '0x12', 'modeManual': 1, 'modeAuto': 0}
+
+
+def build_tree(root, cfg):
+    # CPU package temperature (coretemp)
+    write(root, '/sys/class/hwmon/hwmon0/name', 'coretemp\n')
+    for i in range(1, cfg.temps + 1):
+        write(root, '/sys/class/hwmon/hwmon0/temp%d_input' % i, '45000\n')
+        write(root, '/sys/class/hwmon/hwmon0/temp%d_label' % i,
+              'Package id 0\n' if i == 1 else 'Core %d\n' % (i - 2))
+    write(root, '/sys/class/thermal/thermal_zone0/type', 'x86_pkg_temp\n')
+    write(root, '/sys/class/thermal/thermal_zone0/temp', '45000\n')
+
+    # asus-nb-wmi: thermal policy + fan hwmon (class entry is a symlink, like real sysfs)
+    write(root, WMI_DIR + '/throttle_thermal_policy', '%d\n' % POLICY_BALANCED)
+    write(root, WMI_HWMON + '/name', 'asus\n')
+    for i in range(1, cfg.fans + 1):
+        write(root, WMI_HWMON + '/fan%d_input' % i, '0\n')
+        write(root, WMI_HWMON + '/fan%d_label' % i, 'cpu_fan\n' if i == 1 else 'gpu_fan\n')
+        write(root, WMI_HWMON + '/pwm%d' % i, '0\n')
+        write(root, WMI_HWMON + '/pwm%d_enable' % i, '2\n')
+    symlink(root, '/sys/class/hwmon/hwmon1', WMI_HWMON)
+
+    # GPU: DRM card + hwmon for amdgpu, DRM card for i915, stand-in nvidia-smi for nvidia
+    if cfg.gpu == 'amdgpu':
+        write(root, GPU_DEV + '/vendor', '0x1002\n')
+        write(root, GPU_DEV + '/power/runtime_status', 'active\n')
+        write(root, GPU_DEV + '/gpu_busy_percent', '0\n')
+        write(root, GPU_DEV + '/pp_dpm_sclk', '0: 500Mhz *\n1: 1400Mhz\n2: 2200Mhz\n')
+        write(root, GPU_DEV + '/mem_info_vram_total', '%d\n' % FAKE_VRAM_TOTAL)
+        write(root, GPU_DEV + '/mem_info_vram_used', '%d\n' % FAKE_VRAM_IDLE)
+        write(root, GPU_DEV + '/hwmon/hwmon2/name', 'amdgpu\n')
+        write(root, GPU_DEV + '/hwmon/hwmon2/temp1_input', '40000\n')
+        write(root, GPU_DEV + '/hwmon/hwmon2/freq1_input', '500000000\n')
+        symlink(root, '/sys/class/hwmon/hwmon2', GPU_DEV + '/hwmon/hwmon2')
+        write(root, '/sys/bus/pci/drivers/amdgpu/.keep', '')
+        symlink(root, GPU_DEV + '/driver', '/sys/bus/pci/drivers/amdgpu')
+        symlink(root, '/sys/class/drm/card0/device', GPU_DEV)
+    elif cfg.gpu == 'i915':
+        write(root, GPU_DEV + '/vendor', '0x8086\n')
+        write(root, GPU_DEV + '/power/runtime_status', 'active\n')
+        write(root, '/sys/bus/pci/drivers/i915/.keep', '')
+        symlink(root, GPU_DEV + '/driver', '/sys/bus/pci/drivers/i915')
+        symlink(root, '/sys/class/drm/card0/device', GPU_DEV)
+        write(root, '/sys/class/drm/card0/gt_act_freq_mhz', '0\n')
+        write(root, '/sys/class/drm/card0/gt_cur_freq_mhz', '300\n')
+        write(root, '/sys/class/drm/card0/gt/gt0/rc6_residency_ms', '0\n')
+    elif cfg.gpu == 'nvidia':
+        write_nvidia_smi(root)
+
+    # CPU frequency
+    for c in range(cfg.cpus):
+        write(root, '/sys/devices/system/cpu/cpu%d/cpufreq/scaling_cur_freq' % c, '800000\n')
+
+    # Keyboard backlight
+    write(root, LEDS_DIR + '/kbd_rgb_mode', '1 0 255 0 0 0\n')
+    write(root, LEDS_DIR + '/kbd_rgb_state', '1 1 1 1 1\n')
+    write(root, LEDS_DIR + '/brightness', '2\n')
+    write(root, LEDS_DIR + '/max_brightness', '3\n')
+
+    # Batteries
+    for bat in cfg.batteries:
+        base = '/sys/class/power_supply/' + bat
+        write(root, base + '/type', 'Battery\n')
+        write(root, base + '/capacity', '75\n')
+        write(root, base + '/status', 'Discharging\n')
+        write(root, base + '/charge_control_end_threshold', '100\n')
+
+    # DMI / OS identity
+    write(root, '/sys/class/dmi/id/product_name', cfg.model + '\n')
+    write(root, '/sys/class/dmi/id/board_name', cfg.model.split()[-1] + '\n')
+    write(root, '/etc/os-release', 'PRETTY_NAME="Fake TUF Linux"\n')
+
+    # procfs
+    write(root, '/proc/cpuinfo', ''.join(
+        'processor\t: %d\nmodel name\t: Fake(R) Core(TM) i7-11800H @ 2.30GHz\n\n' % c
+        for c in range(cfg.cpus)))
+    write(root, '/proc/meminfo',
+          'MemTotal:       16303032 kB\nMemFree:         8000000 kB\n'
+          'MemAvailable:   10000000 kB\n')
+    write_proc_stat(root, [[0] * 10 for _ in range(cfg.cpus)])
+    write_net_dev(root, {name: (0, 0) for name in ['lo'] + cfg.interfaces})
+    write_block_devices(root)
+
+    # acpi_call: a plain file simply echoes the last command back, which the
+    # app treats as success. Tests can put canned replies in call.replies
+    # (see AcpiCallTransport.h).
+    write(root, '/proc/acpi/call', '')
+
+    # ec_sys debugfs: the 256 EC registers as plain bytes at their offsets
+    write(root, '/sys/module/ec_sys/parameters/write_support', 'Y\n')
+    write_bytes(root, '/sys/kernel/debug/ec/ec0/io', bytes(256))
+    if cfg.ec_map:
+        # Made-up offsets, only meaningful in this tree: the fans don't follow them
+        write(root, EC_MAP_FILE, json.dumps({'models': [dict(FAKE_EC_REGISTERS,
+                                                                  boards=[cfg.model.split()[-1]])]},
+                                             indent=2) + '\n')
+
+
+def write_proc_stat(root, per_cpu):
+    fields = len(per_cpu[0])
+    total = [sum(c[i] for c in per_cpu) for i in range(fields)]
+    lines = ['cpu  ' + ' '.join(str(v) for v in total)]
+    for n, c in enumerate(per_cpu):
+        lines.append('cpu%d ' % n + ' '.join(str(v) for v in c))
+    lines.append('intr 0')
+    lines.append('ctxt 0')
+    lines.append('btime %d' % int(time.time()))
+    write(root, '/proc/stat', '\n'.join(lines) + '\n')
+
+
+def write_net_dev(root, counters):
+    out = ['Inter-|   Receive                                                |  Transmit',
+           ' face |bytes    packets errs drop fifo frame compressed multicast|'
+           'bytes    packets errs drop fifo colls carrier compressed']
+    for name, (rx, tx) in counters.items():
+        out.append('%6s: %d 0 0 0 0 0 0 0 %d 0 0 0 0 0 0 0' % (name, rx, tx))
+    write(root, '/proc/net/dev', '\n'.join(out) + '\n')
+
+
+# name, major:minor, sectors, partitions [(name, minor, sectors, fstype, label, partlabel, mount)]
+BLOCK_DEVICES = [
+    ('nvme0n1', '259:0', 1000215216, [
+        ('nvme0n1p1', '259:1', 1048576, 'vfat', 'EFI', 'EFI system partition', '/boot/efi'),
+        ('nvme0n1p2', '259:2', 999164560, 'ext4', '', '', '/'),
+    ]),
+    ('sda', '8:0', 60063744, [
+        ('sda1', '8:1', 60061696, 'exfat', 'USB STICK', '', ''),
+    ]),
+]
+
+
+def write_block_devices(root):
+    """sysfs block devices, udev db, by-label links and mountinfo.
+    Mount points are host paths, so statvfs() reports the host's free space."""
+    mounts = []
+    for disk, devnum, sectors, parts in BLOCK_DEVICES:
+        base = '/sys/devices/virtual/block/' + disk
+        write(root, base + '/dev', devnum + '\n')
+        write(root, base + '/size', '%d\n' % sectors)
+        symlink(root, '/sys/block/' + disk, base)
+        symlink(root, '/sys/dev/block/' + devnum, base)
+        for number, (name, pnum, psectors, fstype, label, partlabel, mount) in enumerate(parts, 1):
+            write(root, base + '/' + name + '/dev', pnum + '\n')
+            write(root, base + '/' + name + '/size', '%d\n' % psectors)
+            write(root, base + '/' + name + '/partition', '%d\n' % number)
+            symlink(root, '/sys/dev/block/' + pnum, base + '/' + name)
+            write(root, '/run/udev/data/b' + pnum, 'E:ID_FS_TYPE=%s\n' % fstype)
+            if label:
+                symlink(root, '/dev/disk/by-label/' + label.replace(' ', '\\x20'), '/dev/' + name)
+            if partlabel:
+                symlink(root, '/dev/disk/by-partlabel/' + partlabel.replace(' ', '\\x20'), '/dev/' + name)
+            if mount:
+                mounts.append('%d 1 %s / %s rw,relatime - %s /dev/%s rw'
+                              % (20 + len(mounts), pnum, mount, fstype, name))
+    write(root, '/proc/self/mountinfo', '\n'.join(mounts) + '\n')
+    write(root, '/proc/swaps', 'Filename\tType\tSize\tUsed\tPriority\n')
+
+
+NVIDIA_SMI = r'''#!/usr/bin/env python3
+# Stand-in for `nvidia-smi --query-gpu=index,clocks.gr,utilization.gpu,temperature.gpu
+#   --format=csv,noheader,nounits --loop-ms=N`. Follows the fake tree's CPU
+# temperature so the GPU readings move with the simulation.
+import sys, time
+period = 1.0
+for arg in sys.argv[1:]:
+    if arg.startswith('--loop-ms='):
+        period = int(arg.split('=', 1)[1]) / 1000.0
+while True:
+    try:
+        temp = int(open(%(zone)r).read()) // 1000 - 5
+    except (OSError, ValueError):
+        temp = 45
+    load = max(0, min(100, (temp - 35) * 2))
+    print('0, %%d, %%d, %%d' %% (300 + load * 15, load, temp), flush=True)
+    time.sleep(period)
+'''
+
+
+def write_nvidia_smi(root):
+    path = os.path.join(root, 'usr/bin/nvidia-smi')
+    write(root, '/usr/bin/nvidia-smi',
+          NVIDIA_SMI % {'zone': os.path.join(root, 'sys/class/thermal/thermal_zone0/temp')})
+    os.chmod(path, 0o755)
+
+
+# --- Animation ---
+
+class Simulator:
+    """Advances the fake hardware state. Reads back what the app wrote."""
+
+    USER_HZ = 100
+
+    def __init__(self, root, cfg, seed=0):
+        self.root = root
+        self.cfg = cfg
+        self.rng = random.Random(seed)
+        self.t = 0.0
+        self.temp = 45.0
+        self.rpm = [0.0] * cfg.fans
+        self.jiffies = [[0] * 10 for _ in range(cfg.cpus)]
+        self.net = {name: [0, 0] for name in ['lo'] + cfg.interfaces}
+        self.capacity = 75.0
+        self.rc6_ms = 0.0
+        self.sample = {}
+
+    def load(self):
+        # Slow sine "workload" with bursts, 0..1
+        base = 0.35 + 0.3 * math.sin(self.t / 20.0)
+        burst = 0.4 if int(self.t / 15.0) % 4 == 3 else 0.0
+        return max(0.0, min(1.0, base + burst + self.rng.uniform(-0.05, 0.05)))
+
+    def fan_target(self, index, policy):
+        enable = read_int(self.root, WMI_HWMON + '/pwm%d_enable' % (index + 1), 2)
+        if enable == 1:
+            return read_int(self.root, WMI_HWMON + '/pwm%d' % (index + 1), 0) / 255.0 * 6000
+        if policy == POLICY_TURBO:
+            return 2500 + max(0.0, self.temp - 50) * 90
+        if self.temp < 60:
+            return 0  # Silent and Balanced keep fans off below 60°C
+        slope = 50 if policy == POLICY_SILENT else 80
+        return 1800 + (self.temp - 60) * slope
+
+    def step(self, dt):
+        self.t += dt
+        load = self.load()
+        policy = read_int(self.root, WMI_DIR + '/throttle_thermal_policy', POLICY_BALANCED)
+
+        # Temperature: heated by load, cooled by airflow
+        airflow = sum(self.rpm) / max(1, len(self.rpm)) / 6000.0
+        target = 40 + load * 55 - airflow * 15
+        self.temp += (target - self.temp) * min(1.0, dt / 8.0)
+        for i in range(1, self.cfg.temps + 1):
+            jitter = 0 if i == 1 else self.rng.uniform(-3, 3)
+            write(self.root, '/sys/class/hwmon/hwmon0/temp%d_input' % i,
+                  '%d\n' % int((self.temp + jitter) * 1000))
+        write(self.root, '/sys/class/thermal/thermal_zone0/temp', '%d\n' % int(self.temp * 1000))
+        if self.cfg.gpu == 'amdgpu':
+            busy = int(load * 100)
+            sclk = 500 + int(load * 1700)
+            write(self.root, GPU_DEV + '/hwmon/hwmon2/temp1_input', '%d\n' % int((self.temp - 5) * 1000))
+            write(self.root, GPU_DEV + '/hwmon/hwmon2/freq1_input', '%d\n' % (sclk * 1000000))
+            write(self.root, GPU_DEV + '/gpu_busy_percent', '%d\n' % busy)
+            write(self.root, GPU_DEV + '/mem_info_vram_used', '%d\n' % (FAKE_VRAM_IDLE + int(load * (2 << 30))))
+            levels = [500, 1400, 2200]
+            current = min(range(3), key=lambda i: abs(levels[i] - sclk))
+            write(self.root, GPU_DEV + '/pp_dpm_sclk', ''.join(
+                '%d: %dMhz%s\n' % (i, mhz, ' *' if i == current else '') for i, mhz in enumerate(levels)))
+        elif self.cfg.gpu == 'i915':
+            self.rc6_ms += dt * 1000 * (1.0 - load)
+            write(self.root, '/sys/class/drm/card0/gt/gt0/rc6_residency_ms', '%d\n' % int(self.rc6_ms))
+            write(self.root, '/sys/class/drm/card0/gt_act_freq_mhz', '%d\n' % int(300 + load * 1000))
+            write(self.root, '/sys/class/drm/card0/gt_cur_freq_mhz', '%d\n' % int(300 + load * 1000))
+
+        # Fans spin up/down towards their target (spin-up lag like real EC curves)
+        rpms = []
+        for i in range(self.cfg.fans):
+            tgt = self.fan_target(i, policy)
+            self.rpm[i] += (tgt - self.rpm[i]) * min(1.0, dt / 3.0)
+            rpm = 0 if self.rpm[i] < 300 and tgt == 0 else int(self.rpm[i])
+            rpms.append(rpm)
+            write(self.root, WMI_HWMON + '/fan%d_input' % (i + 1), '%d\n' % rpm)
+
+        # CPU counters and frequency
+        ticks = int(dt * self.USER_HZ)
+        busy_ticks = 0
+        freq0 = 0
+        for c, cpu in enumerate(self.jiffies):
+            busy = max(0.0, min(1.0, load + self.rng.uniform(-0.2, 0.2)))
+            user = int(ticks * busy * 0.7)
+            system = int(ticks * busy * 0.2)
+            iowait = int(ticks * busy * 0.05)
+            irq = int(ticks * busy * 0.03)
+            steal = int(ticks * busy * 0.02)
+            cpu[0] += user
+            cpu[2] += system
+            cpu[4] += iowait
+            cpu[5] += irq
+            cpu[7] += steal
+            cpu[3] += max(0, ticks - user - system - iowait - irq - steal)
+            busy_ticks += user + system + irq + steal
+            freq = int(800000 + busy * 3800000)
+            if c == 0:
+                freq0 = freq
+            write(self.root, '/sys/devices/system/cpu/cpu%d/cpufreq/scaling_cur_freq' % c, '%d\n' % freq)
+        write_proc_stat(self.root, self.jiffies)
+
+        # Memory follows the load loosely
+        total_kb = 16303032
+        avail_kb = int(10000000 - load * 3000000 + self.rng.uniform(-50000, 50000))
+        write(self.root, '/proc/meminfo',
+              'MemTotal:       %d kB\nMemFree:         %d kB\nMemAvailable:   %d kB\n'
+              % (total_kb, avail_kb - 2000000, avail_kb))
+
+        # Network
+        rx = tx = 0
+        for name, ctr in self.net.items():
+            if name == 'lo':
+                continue
+            drx = int(dt * (200000 + load * 2000000))
+            dtx = int(dt * (20000 + load * 200000))
+            ctr[0] += drx
+            ctr[1] += dtx
+            rx += drx
+            tx += dtx
+        write_net_dev(self.root, {k: tuple(v) for k, v in self.net.items()})
+
+        # Battery drifts towards the charge limit the app enforces
+        status = None
+        for bat in self.cfg.batteries:
+            base = '/sys/class/power_supply/' + bat
+            limit = read_int(self.root, base + '/charge_control_end_threshold', 100)
+            if self.capacity < limit:
+                self.capacity = min(limit, self.capacity + dt * 0.05)
+                status = 'Charging'
+            else:
+                status = 'Not charging'
+            write(self.root, base + '/capacity', '%d\n' % int(self.capacity))
+            write(self.root, base + '/status', status + '\n')
+
+        # What the app's telemetry would record for this step
+        self.sample = {
+            'cpuUsage': 100.0 * busy_ticks / max(1, ticks * len(self.jiffies)),
+            'cpuFreq': freq0 / 1000.0,
+            'memoryUsage': 100.0 * (total_kb - avail_kb) / total_kb,
+            'gpuUsage': load * 100 if self.cfg.gpu != 'none' else 0.0,
+            'gpuFreq': 500 + load * 1700 if self.cfg.gpu != 'none' else 0.0,
+            'diskUsage': 61.4,
+            'netDown': rx / dt / 1024.0 if dt > 0 else 0.0,
+            'netUp': tx / dt / 1024.0 if dt > 0 else 0.0,
+            'cpuTemp': int(self.temp),
+            'gpuTemp': int(self.temp - 5) if self.cfg.gpu != 'none' else 0,
+            'cpuFanRpm': rpms[0] if rpms else 0,
+            'gpuFanRpm': rpms[1] if len(rpms) > 1 else 0,
+            'thermalPolicy': policy,
+            'batteryPercent': int(self.capacity),
+            'batteryState': {'Charging': 1, 'Not charging': 3}.get(status, 0),
+        }
+
+
+TRACE_COLUMNS = ['cpuUsage', 'cpuFreq', 'memoryUsage', 'gpuUsage', 'gpuFreq', 'diskUsage', 'netDown',
+                 'netUp', 'cpuTemp', 'gpuTemp', 'cpuFanRpm', 'gpuFanRpm', 'thermalPolicy',
+                 'batteryPercent', 'batteryState']
+
+
+def record_trace(sim, path, duration, interval, start_ms=1760000000000):
+    """Run the simulator without sleeping and write one telemetry record per
+    step as CSV (the TelemetryJournal::Record fields), for the benchmarks.
+    Timestamps get a few ms of timer jitter, like the app's sampling timer."""
+    with open(path, 'w') as out:
+        out.write('# Synthetic trace from fake_hwtree.py, not recorded on hardware\n')
+        out.write('timestampMs,' + ','.join(TRACE_COLUMNS) + '\n')
+        steps = int(duration / interval)
+        for n in range(steps):
+            sim.step(interval)
+            ts = start_ms + int(n * interval * 1000) + sim.rng.randint(0, 3)
+            row = [str(ts)]
+            for name in TRACE_COLUMNS:
+                value = sim.sample[name]
+                row.append('%.2f' % value if isinstance(value, float) else str(value))
+            out.write(','.join(row) + '\n')
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument('root', help='Directory to build the fake tree in')
+    ap.add_argument('--fans', type=int, default=2)
+    ap.add_argument('--temps', type=int, default=4, help='coretemp channels')
+    ap.add_argument('--cpus', type=int, default=8)
+    ap.add_argument('--batteries', default='BAT1', help='Comma list, e.g. BAT0,BAT1')
+    ap.add_argument('--gpu', choices=['none', 'amdgpu', 'i915', 'nvidia'], default='none')
+    ap.add_argument('--interfaces', default='wlan0,eth0')
+    ap.add_argument('--model', default='ASUS TUF Gaming F15 FX506HM')
+    ap.add_argument('--ec-map', action='store_true',
+                    help='Also write a (synthetic) EC register map, enabling the EC backend')
+    ap.add_argument('--animate', action='store_true', help='Keep updating values')
+    ap.add_argument('--interval', type=float, default=0.5, help='Seconds between updates')
+    ap.add_argument('--speedup', type=float, default=1.0, help='Simulated seconds per real second')
+    ap.add_argument('--duration', type=float, default=0, help='Stop after N seconds (0 = forever)')
+    ap.add_argument('--seed', type=int, default=0)
+    ap.add_argument('--trace', metavar='CSV',
+                    help='Simulate --duration seconds (default 3600) at --interval without sleeping '
+                         'and write the telemetry records to CSV')
+    args = ap.parse_args()
+
+    cfg = Config(args)
+    root = os.path.abspath(args.root)
+    build_tree(root, cfg)
+    print('Fake TUF tree ready at', root)
+
+    if args.trace:
+        record_trace(Simulator(root, cfg, args.seed), args.trace, args.duration or 3600, args.interval)
+        print('Trace written to', args.trace)
+        return
+
+    if not args.animate:
+        return
+
+    sim = Simulator(root, cfg, args.seed)
+    start = time.monotonic()
+    try:
+        while args.duration <= 0 or time.monotonic() - start < args.duration:
+            sim.step(args.interval * args.speedup)
+            time.sleep(args.interval)
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == '__main__':
+    main()
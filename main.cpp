@@ -13,6 +13,15 @@
 #include "src/SystemStatsMonitor.h"
 #include "src/AuraController.h"
 #include "src/FanCurveController.h"
+#include "src/SysRoot.h"
+#include "src/SensorHub.h"
+#include "src/MetricHistory.h"
+#include "src/TelemetryChart.h"
+#include "src/ArcGauge.h"
+#include "src/TelemetryHistory.h"
+#include "src/TelemetryQuery.h"
+#include "src/WindowedStats.h"
+#include "src/HardwareWriteQueue.h"
 
 #include <stdio.h>
 
@@ -91,9 +100,24 @@ int main(int argc, char *argv[])
     QSurfaceFormat format;
     format.setSwapBehavior(QSurfaceFormat::DoubleBuffer);
     format.setSwapInterval(1);  // VSync on
+    format.setSamples(4);       // MSAA for the scene-graph charts and gauges (no vertex antialiasing)
     QSurfaceFormat::setDefaultFormat(format);
 
     QGuiApplication app(argc, argv);
+
+    // Relocatable hardware root for benchmarks and fake trees (see fake_hwtree.py).
+    // --sysroot=<dir> overrides ASUS_TUF_SYSROOT; must be set before any controller exists.
+    const QStringList args = app.arguments();
+    for (int i = 1; i < args.size(); ++i) {
+        if (args[i].startsWith("--sysroot=")) {
+            SysRoot::setRoot(args[i].mid(10));
+        } else if (args[i] == "--sysroot" && i + 1 < args.size()) {
+            SysRoot::setRoot(args[++i]);
+        }
+    }
+    if (SysRoot::isRelocated()) {
+        qInfo() << "Using synthetic hardware root:" << SysRoot::root();
+    }
     
     // Fix: Set fonts with proper multi-script support (Tamil, Hindi, Arabic, etc.)
     // Using font families that include all script variants reduces fallback lag
@@ -163,8 +187,25 @@ int main(int argc, char *argv[])
     qmlRegisterType<SystemStatsMonitor>("AsusTufFanControl", 1, 0, "SystemStatsMonitor");
     qmlRegisterType<AuraController>("AsusTufFanControl", 1, 0, "AuraController");
     qmlRegisterType<FanCurveController>("AsusTufFanControl", 1, 0, "FanCurveController");
+    qmlRegisterUncreatableType<MetricHistory>("AsusTufFanControl", 1, 0, "MetricHistory",
+                                              "MetricHistory is provided by SystemStatsMonitor");
+    qmlRegisterType<TelemetryChart>("AsusTufFanControl", 1, 0, "TelemetryChart");
+    qmlRegisterType<ArcGauge>("AsusTufFanControl", 1, 0, "ArcGauge");
+    qmlRegisterUncreatableType<TelemetryHistory>("AsusTufFanControl", 1, 0, "TelemetryHistory",
+                                                 "TelemetryHistory is provided by SystemStatsMonitor");
+    qmlRegisterUncreatableType<TelemetryQuery>("AsusTufFanControl", 1, 0, "TelemetryQuery",
+                                               "TelemetryQuery is provided by SystemStatsMonitor");
+    qmlRegisterUncreatableType<WindowedStats>("AsusTufFanControl", 1, 0, "WindowedStats",
+                                              "WindowedStats is provided by SystemStatsMonitor");
+
+    // One sensor discovery + sampling pass for every controller. Declared before
+    // the engine so it outlives the QML-created controllers that read it.
+    SensorHub sensorHub;
+    SensorHub::setCurrent(&sensorHub);
 
     QQmlApplicationEngine engine;
+    engine.rootContext()->setContextProperty("sensorHub", &sensorHub);
+    engine.rootContext()->setContextProperty("hardwareWrites", &HardwareWriteQueue::instance());
     const QUrl url(QStringLiteral("qrc:/ui/Main.qml"));
     QObject::connect(&engine, &QQmlApplicationEngine::objectCreated,
                      &app, [url](QObject *obj, const QUrl &objUrl) {
@@ -153,6 +153,24 @@ modprobe asus_wmi 2>/dev/null || true
 # Load required modules
 modprobe coretemp
 modprobe i2c-dev
+# In-process EC access (debugfs io file); /dev/port is the fallback.
+# Write support opens every EC register, so it is only enabled for a model
+# that has an entry in the register map (see README, "EC Register Map")
+ec_map_has_model() {
+    local map=/etc/asus_tuf_ec_registers.json
+    [ -f "$map" ] || return 1
+    local ids
+    ids="$(cat /sys/class/dmi/id/board_name /sys/class/dmi/id/product_name 2>/dev/null)"
+    [ -n "$ids" ] || return 1
+    local name
+    while read -r name; do
+        [ -n "$name" ] && echo "$ids" | grep -qiF -- "$name" && return 0
+    done < <(tr -d '\n' < "$map" | grep -o '"boards"[^]]*' | grep -o '"[^"]*"' | tr -d '"' | grep -v '^boards$')
+    return 1
+}
+if ec_map_has_model; then
+    modprobe ec_sys write_support=1 2>/dev/null || true
+fi
 
 echo "ASUS Fan Control: System prepared"
 EOF
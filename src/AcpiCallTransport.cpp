@@ -0,0 +1,240 @@
+#include "AcpiCallTransport.h"
+#include "SysRoot.h"
+#include <QFile>
+#include <QMutexLocker>
+#include <QStringList>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+// acpi_call formats a reply into a buffer of this size
+static const int kMaxReply = 4096;
+static const int kMaxCommand = 512;
+
+AcpiCallTransport &AcpiCallTransport::instance()
+{
+    static AcpiCallTransport transport;
+    return transport;
+}
+
+AcpiCallTransport::~AcpiCallTransport()
+{
+    closeLocked();
+}
+
+void AcpiCallTransport::setPath(const QString &path)
+{
+    QMutexLocker locker(&m_mutex);
+    closeLocked();
+    m_path = path;
+}
+
+QString AcpiCallTransport::path() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_path.isEmpty() ? SysRoot::path("/proc/acpi/call") : m_path;
+}
+
+bool AcpiCallTransport::isAvailable() const
+{
+    return QFile::exists(path());
+}
+
+bool AcpiCallTransport::openLocked()
+{
+    const QByteArray file = (m_path.isEmpty() ? SysRoot::path("/proc/acpi/call") : m_path).toLocal8Bit();
+    struct stat st;
+    if (m_fd >= 0) {
+        // A plain file never fails a write when replaced: compare inodes
+        if (!m_plainFile) return true;
+        if (::stat(file.constData(), &st) == 0 && st.st_dev == m_device && st.st_ino == m_inode) return true;
+        closeLocked();
+    }
+
+    m_fd = ::open(file.constData(), O_RDWR | O_CLOEXEC);
+    if (m_fd < 0) return false;
+
+    m_plainFile = ::fstat(m_fd, &st) == 0 && S_ISREG(st.st_mode);
+    if (m_plainFile) {
+        m_device = st.st_dev;
+        m_inode = st.st_ino;
+    }
+    return true;
+}
+
+void AcpiCallTransport::closeLocked()
+{
+    if (m_fd >= 0) ::close(m_fd);
+    m_fd = -1;
+}
+
+static AcpiCallTransport::Reply errorReply(const char *code)
+{
+    AcpiCallTransport::Reply reply;
+    reply.type = AcpiCallTransport::Reply::Error;
+    reply.data = code;
+    return reply;
+}
+
+AcpiCallTransport::Reply AcpiCallTransport::callLocked(const Call &call)
+{
+    char command[kMaxCommand];
+    int length = call.method.size();
+    if (length + 1 + call.args.size() >= kMaxCommand) return errorReply("command too long");
+    memcpy(command, call.method.constData(), length);
+    if (!call.args.isEmpty()) {
+        command[length++] = ' ';
+        memcpy(command + length, call.args.constData(), call.args.size());
+        length += call.args.size();
+    }
+
+    // Two attempts: the open descriptor, then a fresh one if it went stale
+    // (module reloaded)
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        if (!openLocked()) {
+            return errorReply(errno == ENOENT ? "acpi_call not available" : "Cannot open acpi_call");
+        }
+
+        ssize_t written;
+        do {
+            written = ::pwrite(m_fd, command, length, 0);
+        } while (written < 0 && errno == EINTR);
+
+        if (written == length) {
+            if (m_plainFile) {
+                if (::ftruncate(m_fd, length) != 0) return errorReply("Cannot write acpi_call");
+                QByteArray canned;
+                if (cannedReply(command, length, &canned)) return parse(canned.constData(), canned.size());
+            }
+
+            char buf[kMaxReply];
+            ssize_t n;
+            do {
+                n = ::pread(m_fd, buf, sizeof(buf) - 1, 0);
+            } while (n < 0 && errno == EINTR);
+            if (n >= 0) {
+                buf[n] = '\0';
+                return parse(buf, static_cast<int>(n));
+            }
+        }
+
+        closeLocked();
+    }
+    return errorReply("Cannot write acpi_call");
+}
+
+bool AcpiCallTransport::cannedReply(const char *command, int length, QByteArray *reply) const
+{
+    QFile file((m_path.isEmpty() ? SysRoot::path("/proc/acpi/call") : m_path) + ".replies");
+    if (!file.open(QIODevice::ReadOnly)) return false;
+
+    const QByteArray text(command, length);
+    for (const QByteArray &line : file.readAll().split('\n')) {
+        const int tab = line.indexOf('\t');
+        if (tab <= 0 || !text.startsWith(line.left(tab))) continue;
+        *reply = line.mid(tab + 1);
+        return true;
+    }
+    return false;
+}
+
+AcpiCallTransport::Reply AcpiCallTransport::call(const QByteArray &method, const QByteArray &args)
+{
+    QMutexLocker locker(&m_mutex);
+    return callLocked({ method, args });
+}
+
+QVector<AcpiCallTransport::Reply> AcpiCallTransport::batch(const QVector<Call> &calls, bool stopOnError)
+{
+    QVector<Reply> replies;
+    replies.reserve(calls.size());
+
+    QMutexLocker locker(&m_mutex);
+    for (const Call &call : calls) {
+        replies.append(callLocked(call));
+        if (stopOnError && !replies.last().ok()) break;
+    }
+    return replies;
+}
+
+static bool isSpace(char c)
+{
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\0';
+}
+
+AcpiCallTransport::Reply AcpiCallTransport::parse(const char *text, int length)
+{
+    while (length > 0 && isSpace(text[length - 1])) --length;
+    while (length > 0 && isSpace(*text)) { ++text; --length; }
+
+    Reply reply;
+    const auto startsWith = [&](const char *prefix) {
+        const int n = static_cast<int>(strlen(prefix));
+        return length >= n && memcmp(text, prefix, n) == 0;
+    };
+
+    if (startsWith("Error: ")) {
+        reply.type = Reply::Error;
+        reply.data = QByteArray(text + 7, length - 7);
+    } else if (length == 0 || startsWith("not called")) {
+        // Nothing ran: the write never reached the module
+        reply.type = Reply::Error;
+        reply.data = "not called";
+    } else if (startsWith("0x")) {
+        char digits[24];
+        const int n = qMin(length - 2, static_cast<int>(sizeof(digits)) - 1);
+        memcpy(digits, text + 2, n);
+        digits[n] = '\0';
+        char *end = nullptr;
+        reply.integer = strtoull(digits, &end, 16);
+        reply.type = (n > 0 && *end == '\0') ? Reply::Integer : Reply::Raw;
+        if (reply.type == Reply::Raw) reply.data = QByteArray(text, length);
+    } else if (text[0] == '{' && text[length - 1] == '}') {
+        // {0x01, 0x02, ...}
+        reply.type = Reply::Buffer;
+        for (int i = 1; i < length - 1; ++i) {
+            if (text[i] == '0' && i + 1 < length && text[i + 1] == 'x') {
+                char *end = nullptr;
+                reply.data.append(static_cast<char>(strtoul(text + i + 2, &end, 16)));
+                i = static_cast<int>(end - text) - 1;
+            }
+        }
+    } else if (text[0] == '"' && length >= 2 && text[length - 1] == '"') {
+        reply.type = Reply::String;
+        reply.data = QByteArray(text + 1, length - 2);
+    } else if (text[0] == '[') {
+        reply.type = Reply::Package;
+        reply.data = QByteArray(text, length);
+    } else {
+        reply.type = Reply::Raw;
+        reply.data = QByteArray(text, length);
+    }
+    return reply;
+}
+
+QString AcpiCallTransport::Reply::toString() const
+{
+    switch (type) {
+    case Integer:
+        return "0x" + QString::number(integer, 16);
+    case Buffer: {
+        QStringList bytes;
+        for (char byte : data) {
+            bytes << QString("0x%1").arg(static_cast<uchar>(byte), 2, 16, QChar('0'));
+        }
+        return '{' + bytes.join(", ") + '}';
+    }
+    case String:
+        return '"' + QString::fromLatin1(data) + '"';
+    case Package:
+    case Raw:
+        return QString::fromLatin1(data);
+    case Error:
+        break;
+    }
+    return "Error: " + QString::fromLatin1(data);
+}
@@ -0,0 +1,87 @@
+#ifndef ACPICALLTRANSPORT_H
+#define ACPICALLTRANSPORT_H
+
+#include <QByteArray>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+#include <sys/types.h>
+
+// Process-wide channel to the acpi_call module.
+//
+// acpi_call has a single reply buffer shared by every caller: a command is
+// written to /proc/acpi/call and its reply read back from the same file,
+// so two callers must never interleave. The old path opened the file
+// twice per call through QFile + QTextStream (open, write, close, open,
+// read, read (EOF), close). Here the file is opened once and each call is
+// pwrite + pread at offset 0 under the lock, with the command built and
+// the reply parsed in stack buffers.
+//
+// The path can be redirected (setPath) to a plain file. It then holds the
+// last command, and the reply comes from "<path>.replies" if that has a
+// line for the command: "<command prefix><TAB><reply as acpi_call prints
+// it>", the first line whose prefix starts the command wins. Without one
+// the command itself reads back, as a Raw reply. A plain file that is
+// replaced or removed counts as a stale descriptor, like a module reload.
+class AcpiCallTransport
+{
+public:
+    struct Reply {
+        enum Type {
+            Integer,    // 0x1234
+            Buffer,     // {0x01, 0x02}
+            String,     // "text"
+            Package,    // [...], kept as is
+            Raw,        // Anything else (a plain file echoing the command)
+            Error       // Error: AE_NOT_FOUND, not called, or no acpi_call
+        };
+
+        Type type = Error;
+        quint64 integer = 0;
+        QByteArray data;    // Buffer bytes, string text, package/raw reply, or error code
+
+        bool ok() const { return type != Error; }
+        QString toString() const;   // The reply as acpi_call printed it
+    };
+
+    struct Call {
+        QByteArray method;      // \_SB.PCI0.LPCB.EC0.SFNV
+        QByteArray args;        // "0 255"; may be empty
+    };
+
+    static AcpiCallTransport &instance();
+    ~AcpiCallTransport();
+
+    // Defaults to SysRoot::path("/proc/acpi/call"). Changing it closes the
+    // open descriptor.
+    void setPath(const QString &path);
+    QString path() const;
+    bool isAvailable() const;
+
+    Reply call(const QByteArray &method, const QByteArray &args = QByteArray());
+
+    // Runs the calls back to back under one lock, so nothing else can get
+    // in between. With stopOnError the first failure ends the batch, and
+    // the replies stop there too.
+    QVector<Reply> batch(const QVector<Call> &calls, bool stopOnError = false);
+
+    static Reply parse(const char *text, int length);
+
+private:
+    AcpiCallTransport() = default;
+    Q_DISABLE_COPY(AcpiCallTransport)
+
+    Reply callLocked(const Call &call);
+    bool cannedReply(const char *command, int length, QByteArray *reply) const;
+    bool openLocked();
+    void closeLocked();
+
+    mutable QMutex m_mutex;
+    QString m_path;             // Empty: the default, resolved on first use
+    int m_fd = -1;
+    bool m_plainFile = false;   // Redirected to a regular file: truncate after writing
+    dev_t m_device = 0;         // The plain file opened, to notice it being replaced
+    ino_t m_inode = 0;
+};
+
+#endif // ACPICALLTRANSPORT_H
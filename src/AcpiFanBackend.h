@@ -0,0 +1,36 @@
+#ifndef ACPIFANBACKEND_H
+#define ACPIFANBACKEND_H
+
+#include "FanBackend.h"
+
+// An ASUS fan method called through the acpi_call module. SFNV-style
+// methods take (fan index, 0-255), FANL one 0-255 level for both fans and
+// SPLV a 0-10 level. Nothing can be read back.
+class AcpiFanBackend : public FanBackend
+{
+public:
+    QString name() const override { return "acpi-call"; }
+    int capabilities() const override;
+
+    void apply(int percentage, QObject *context = nullptr,
+               HardwareWriteQueue::Callback onResult = HardwareWriteQueue::Callback()) override;
+    void revertToAuto() override;
+    int readback() const override { return -1; }
+    QString describe(int percentage) const override;
+    QString readyMessage() const override;
+
+    QString method() const { return m_method; }
+
+protected:
+    // Probes the known method paths with harmless arguments; this is the
+    // one backend whose detection has to write
+    bool detect() override;
+    Probe measure() override;
+
+private:
+    QString m_method;           // First method that answered
+    bool m_perFan = false;      // Takes a fan index and index 1 (GPU) answered too
+    qint64 m_probeLatencyUs = -1;
+};
+
+#endif // ACPIFANBACKEND_H
@@ -0,0 +1,376 @@
+#include "ArcGauge.h"
+
+#include <QSGNode>
+#include <QSGGeometryNode>
+#include <QSGOpacityNode>
+#include <QSGTransformNode>
+#include <QSGVertexColorMaterial>
+#include <QVector>
+#include <QMatrix4x4>
+#include <algorithm>
+#include <cmath>
+
+static const double kStartAngle = 0.70 * M_PI;
+static const double kSweepAngle = 1.60 * M_PI;
+static const int kArcSegments = 96;
+static const int kCapSegments = 8;
+static const int kKnobSegments = 24;
+static const int kShadowSegments = 64;
+
+// Strip layout: start cap | (outer, inner) per arc step + exact end pair | end cap | repeat | collapsed tail
+static const int kStartCapVertices = 2 * kCapSegments;
+static const int kEndVertices = 2 + 2 * kCapSegments + 1;
+static const int kStripVertices = kStartCapVertices + 2 * (kArcSegments + 1) + kEndVertices;
+
+typedef QSGGeometry::ColoredPoint2D Vertex;
+
+// QSGVertexColorMaterial expects premultiplied colours
+static void setVertex(Vertex &v, float x, float y, const QColor &color, qreal opacity)
+{
+    const float a = static_cast<float>(color.alphaF() * opacity);
+    v.set(x, y,
+          static_cast<uchar>(color.redF() * a * 255 + 0.5f),
+          static_cast<uchar>(color.greenF() * a * 255 + 0.5f),
+          static_cast<uchar>(color.blueF() * a * 255 + 0.5f),
+          static_cast<uchar>(a * 255 + 0.5f));
+}
+
+// Filled circle as a triangle list; returns the vertex count written
+static int writeDisc(Vertex *v, float cx, float cy, float radius, int segments, const QColor &color)
+{
+    for (int i = 0; i < segments; ++i) {
+        const double a0 = 2 * M_PI * i / segments;
+        const double a1 = 2 * M_PI * (i + 1) / segments;
+        setVertex(v[i * 3], cx, cy, color, 1.0);
+        setVertex(v[i * 3 + 1], cx + radius * std::cos(a0), cy + radius * std::sin(a0), color, 1.0);
+        setVertex(v[i * 3 + 2], cx + radius * std::cos(a1), cy + radius * std::sin(a1), color, 1.0);
+    }
+    return segments * 3;
+}
+
+static QSGGeometryNode *makeNode(unsigned int mode)
+{
+    QSGGeometry *geometry = new QSGGeometry(QSGGeometry::defaultAttributes_ColoredPoint2D(), 0);
+    geometry->setDrawingMode(mode);
+    QSGGeometryNode *node = new QSGGeometryNode;
+    node->setGeometry(geometry);
+    node->setMaterial(new QSGVertexColorMaterial);
+    node->setFlags(QSGNode::OwnsGeometry | QSGNode::OwnsMaterial);
+    return node;
+}
+
+// One round-capped arc stroke with its full-length tessellation cached
+struct ArcGauge::ArcStrip
+{
+    QSGGeometryNode *node = nullptr;
+    QVector<Vertex> pairs;      // (outer, inner) at every arc step
+    float halfWidth = 0;
+    bool gradient = false;
+    qreal opacity = 1.0;
+    int steps = -1;             // Arc steps currently in the geometry, -1 = none
+    int usedEnd = 0;            // Vertices in use before the collapsed tail
+};
+
+class ArcGauge::GaugeNode : public QSGNode
+{
+public:
+    GaugeNode()
+    {
+        shadow = makeNode(QSGGeometry::DrawTriangles);
+        appendChildNode(shadow);
+
+        track.node = makeNode(QSGGeometry::DrawTriangleStrip);
+        appendChildNode(track.node);
+
+        // Hidden as a whole below 1% progress, like the Canvas gauges
+        progress = new QSGOpacityNode;
+        appendChildNode(progress);
+
+        main.node = makeNode(QSGGeometry::DrawTriangleStrip);
+        progress->appendChildNode(main.node);
+        glow.node = makeNode(QSGGeometry::DrawTriangleStrip);
+        progress->appendChildNode(glow.node);
+
+        knobTransform = new QSGTransformNode;
+        progress->appendChildNode(knobTransform);
+        knob = makeNode(QSGGeometry::DrawTriangles);
+        knobTransform->appendChildNode(knob);
+
+        ticks = makeNode(QSGGeometry::DrawTriangles);
+        appendChildNode(ticks);
+    }
+
+    QSGGeometryNode *shadow;
+    QSGOpacityNode *progress;
+    QSGTransformNode *knobTransform;
+    QSGGeometryNode *knob;
+    QSGGeometryNode *ticks;
+    ArcStrip track;
+    ArcStrip main;
+    ArcStrip glow;
+};
+
+ArcGauge::ArcGauge(QQuickItem *parent)
+    : QQuickItem(parent)
+{
+    setFlag(ItemHasContents, true);
+}
+
+void ArcGauge::setValue(qreal value)
+{
+    if (m_value == value) return;
+    m_value = value;
+    m_sweepDirty = true;
+    update();
+    emit valueChanged();
+}
+
+void ArcGauge::setMaxValue(qreal value)
+{
+    if (m_maxValue == value) return;
+    m_maxValue = value;
+    m_sweepDirty = true;
+    update();
+    emit maxValueChanged();
+}
+
+void ArcGauge::geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry)
+{
+    QQuickItem::geometryChange(newGeometry, oldGeometry);
+    if (newGeometry.size() == oldGeometry.size()) return;
+    m_layoutDirty = true;
+    update();
+}
+
+double ArcGauge::progress() const
+{
+    if (m_maxValue <= 0) return 0.0;
+    return qBound(0.0, static_cast<double>(m_value / m_maxValue), 1.0);
+}
+
+QColor ArcGauge::gradientAt(float x, float y) const
+{
+    // Diagonal gradient across the item: colour -> highlight at the middle -> colour
+    const double w = width();
+    const double h = height();
+    const double len2 = w * w + h * h;
+    const double t = len2 > 0 ? qBound(0.0, (x * w + y * h) / len2, 1.0) : 0.0;
+    const double f = t < 0.5 ? t * 2 : (1 - t) * 2;
+
+    return QColor::fromRgbF(m_progressColor.redF() + (m_highlightColor.redF() - m_progressColor.redF()) * f,
+                            m_progressColor.greenF() + (m_highlightColor.greenF() - m_progressColor.greenF()) * f,
+                            m_progressColor.blueF() + (m_highlightColor.blueF() - m_progressColor.blueF()) * f,
+                            m_progressColor.alphaF() + (m_highlightColor.alphaF() - m_progressColor.alphaF()) * f);
+}
+
+void ArcGauge::buildStrip(ArcStrip *strip, qreal halfWidth, bool gradient, qreal opacity)
+{
+    const float cx = static_cast<float>(width() / 2);
+    const float cy = static_cast<float>(height() / 2);
+    const float r = static_cast<float>(m_arcRadius);
+    const float hw = static_cast<float>(halfWidth);
+
+    strip->halfWidth = hw;
+    strip->gradient = gradient;
+    strip->opacity = opacity;
+    auto colorAt = [&](float x, float y) { return gradient ? gradientAt(x, y) : m_trackColor; };
+
+    // Full-length tessellation; sweep changes copy ranges out of this
+    strip->pairs.resize(2 * (kArcSegments + 1));
+    for (int i = 0; i <= kArcSegments; ++i) {
+        const double a = kStartAngle + kSweepAngle * i / kArcSegments;
+        const float nx = static_cast<float>(std::cos(a));
+        const float ny = static_cast<float>(std::sin(a));
+        const float ox = cx + (r + hw) * nx, oy = cy + (r + hw) * ny;
+        const float ix = cx + (r - hw) * nx, iy = cy + (r - hw) * ny;
+        setVertex(strip->pairs[i * 2], ox, oy, colorAt(ox, oy), opacity);
+        setVertex(strip->pairs[i * 2 + 1], ix, iy, colorAt(ix, iy), opacity);
+    }
+
+    QSGGeometry *geometry = strip->node->geometry();
+    geometry->allocate(kStripVertices);
+    Vertex *v = geometry->vertexDataAsColoredPoint2D();
+
+    // Start cap: half disc from the inner edge round the back to the outer
+    // edge, alternating with its centre so the strip stays a fan
+    const float sx = static_cast<float>(std::cos(kStartAngle));
+    const float sy = static_cast<float>(std::sin(kStartAngle));
+    const float capX = cx + r * sx, capY = cy + r * sy;
+    for (int j = 0; j < kCapSegments; ++j) {
+        const double t = M_PI * j / kCapSegments;
+        // -normal * cos(t) - tangent * sin(t); tangent = (-sy, sx)
+        const float px = capX + hw * static_cast<float>(-sx * std::cos(t) + sy * std::sin(t));
+        const float py = capY + hw * static_cast<float>(-sy * std::cos(t) - sx * std::sin(t));
+        setVertex(v[j * 2], px, py, colorAt(px, py), opacity);
+        setVertex(v[j * 2 + 1], capX, capY, colorAt(capX, capY), opacity);
+    }
+
+    // Everything past the start cap collapses onto one transparent point
+    for (int i = kStartCapVertices; i < kStripVertices; ++i) {
+        v[i].set(cx, cy, 0, 0, 0, 0);
+    }
+    strip->steps = -1;
+    strip->usedEnd = kStartCapVertices;
+    strip->node->markDirty(QSGNode::DirtyGeometry);
+}
+
+void ArcGauge::setStripSweep(ArcStrip *strip, double progress)
+{
+    const float cx = static_cast<float>(width() / 2);
+    const float cy = static_cast<float>(height() / 2);
+    const float r = static_cast<float>(m_arcRadius);
+    const float hw = strip->halfWidth;
+    auto colorAt = [&](float x, float y) { return strip->gradient ? gradientAt(x, y) : m_trackColor; };
+
+    Vertex *v = strip->node->geometry()->vertexDataAsColoredPoint2D();
+    const int steps = qMin(kArcSegments, static_cast<int>(progress * kArcSegments));
+
+    // Only the steps the sweep grew into come from the cache; shrinking
+    // leaves the prefix as it is
+    const int from = strip->steps + 1;
+    if (steps >= from) {
+        std::copy(strip->pairs.constBegin() + from * 2, strip->pairs.constBegin() + (steps + 1) * 2,
+                  v + kStartCapVertices + from * 2);
+    }
+
+    // Exact end pair, then the end cap round the front, then a repeat of the
+    // last vertex so the step into the collapsed tail is degenerate
+    const double a = kStartAngle + kSweepAngle * progress;
+    const float nx = static_cast<float>(std::cos(a));
+    const float ny = static_cast<float>(std::sin(a));
+    const float ex = cx + r * nx, ey = cy + r * ny;
+    Vertex *e = v + kStartCapVertices + (steps + 1) * 2;
+
+    const float ox = ex + hw * nx, oy = ey + hw * ny;
+    const float ix = ex - hw * nx, iy = ey - hw * ny;
+    setVertex(e[0], ox, oy, colorAt(ox, oy), strip->opacity);
+    setVertex(e[1], ix, iy, colorAt(ix, iy), strip->opacity);
+    const QColor centerColor = colorAt(ex, ey);
+    for (int j = 1; j <= kCapSegments; ++j) {
+        const double t = M_PI * j / kCapSegments;
+        // -normal * cos(t) + tangent * sin(t)
+        const float px = ex + hw * static_cast<float>(-nx * std::cos(t) - ny * std::sin(t));
+        const float py = ey + hw * static_cast<float>(-ny * std::cos(t) + nx * std::sin(t));
+        setVertex(e[j * 2], ex, ey, centerColor, strip->opacity);
+        setVertex(e[j * 2 + 1], px, py, colorAt(px, py), strip->opacity);
+    }
+    e[kEndVertices - 1] = e[kEndVertices - 2];
+
+    // Collapse what the previous, longer sweep used
+    const int usedEnd = static_cast<int>(e - v) + kEndVertices;
+    for (int i = usedEnd; i < strip->usedEnd; ++i) {
+        v[i].set(cx, cy, 0, 0, 0, 0);
+    }
+
+    strip->steps = steps;
+    strip->usedEnd = usedEnd;
+    strip->node->markDirty(QSGNode::DirtyGeometry);
+}
+
+void ArcGauge::buildTicks(GaugeNode *node)
+{
+    const int count = qMax(0, m_tickCount) + 1;
+    QSGGeometry *geometry = node->ticks->geometry();
+    geometry->allocate(count * 6);
+    Vertex *v = geometry->vertexDataAsColoredPoint2D();
+
+    const double cx = width() / 2;
+    const double cy = height() / 2;
+    const double hw = m_tickWidth / 2;
+    for (int i = 0; i < count; ++i) {
+        const double a = kStartAngle + kSweepAngle * i / qMax(1, m_tickCount);
+        const bool major = m_majorTickInterval > 0 && i % m_majorTickInterval == 0;
+        const double r1 = m_arcRadius + m_tickOffset;
+        const double r2 = r1 + (major ? m_majorTickLength : m_minorTickLength);
+        const double nx = std::cos(a), ny = std::sin(a);
+        const double tx = -ny * hw, ty = nx * hw;
+
+        const float x1 = cx + r1 * nx, y1 = cy + r1 * ny;
+        const float x2 = cx + r2 * nx, y2 = cy + r2 * ny;
+        Vertex *q = v + i * 6;
+        setVertex(q[0], x1 - tx, y1 - ty, m_tickColor, 1.0);
+        setVertex(q[1], x1 + tx, y1 + ty, m_tickColor, 1.0);
+        setVertex(q[2], x2 - tx, y2 - ty, m_tickColor, 1.0);
+        q[3] = q[2];
+        q[4] = q[1];
+        setVertex(q[5], x2 + tx, y2 + ty, m_tickColor, 1.0);
+    }
+    node->ticks->markDirty(QSGNode::DirtyGeometry);
+}
+
+void ArcGauge::buildKnob(GaugeNode *node)
+{
+    // Drawn around the origin; updateSweep() only moves the transform
+    QSGGeometry *geometry = node->knob->geometry();
+    geometry->allocate(kKnobSegments * 3 * 2);
+    Vertex *v = geometry->vertexDataAsColoredPoint2D();
+    const int written = writeDisc(v, 0, 0, m_knobRadius, kKnobSegments, m_knobColor);
+    writeDisc(v + written, 0, 0, m_knobInnerRadius, kKnobSegments, m_progressColor);
+    node->knob->markDirty(QSGNode::DirtyGeometry);
+}
+
+void ArcGauge::buildShadow(GaugeNode *node)
+{
+    QSGGeometry *geometry = node->shadow->geometry();
+    if (m_shadowColor.alpha() == 0) {
+        geometry->allocate(0);
+    } else {
+        geometry->allocate(kShadowSegments * 3);
+        writeDisc(geometry->vertexDataAsColoredPoint2D(), width() / 2, height() / 2 + 3,
+                  m_arcRadius, kShadowSegments, m_shadowColor);
+    }
+    node->shadow->markDirty(QSGNode::DirtyGeometry);
+}
+
+void ArcGauge::buildLayout(GaugeNode *node)
+{
+    buildShadow(node);
+
+    buildStrip(&node->track, m_trackWidth / 2, false, 1.0);
+    setStripSweep(&node->track, 1.0);
+
+    buildStrip(&node->main, m_progressWidth / 2, true, 1.0);
+    buildStrip(&node->glow, m_glowWidth / 2, true, m_glowOpacity);
+
+    buildKnob(node);
+    buildTicks(node);
+}
+
+void ArcGauge::updateSweep(GaugeNode *node)
+{
+    const double p = progress();
+    const bool visible = p > 0.01;
+    node->progress->setOpacity(visible ? 1.0 : 0.0);
+    if (!visible) return;
+
+    setStripSweep(&node->main, p);
+    setStripSweep(&node->glow, p);
+
+    const double a = kStartAngle + kSweepAngle * p;
+    QMatrix4x4 matrix;
+    matrix.translate(static_cast<float>(width() / 2 + m_arcRadius * std::cos(a)),
+                     static_cast<float>(height() / 2 + m_arcRadius * std::sin(a)));
+    node->knobTransform->setMatrix(matrix);
+}
+
+QSGNode *ArcGauge::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *)
+{
+    GaugeNode *node = static_cast<GaugeNode *>(oldNode);
+    if (!node) {
+        node = new GaugeNode;
+        m_layoutDirty = true;
+    }
+
+    if (m_layoutDirty) {
+        buildLayout(node);
+        m_layoutDirty = false;
+        m_sweepDirty = true;
+    }
+
+    if (m_sweepDirty) {
+        updateSweep(node);
+        m_sweepDirty = false;
+    }
+
+    return node;
+}
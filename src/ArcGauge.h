@@ -0,0 +1,154 @@
+#ifndef ARCGAUGE_H
+#define ARCGAUGE_H
+
+#include <QQuickItem>
+#include <QColor>
+
+// Scene-graph arc gauge (replaces the threaded Canvas arcs in CircularGauge
+// and StatsCard).
+//
+// The track, ticks and the full-length progress arc are tessellated once per
+// size/style change. A value change only moves the end of the progress
+// strip: the vertex range between the old and new sweep end is copied from
+// the cached tessellation, the round end cap is rewritten and the knob is
+// translated. Unused vertices are collapsed into degenerate triangles, so
+// the geometry is never reallocated while animating.
+//
+// The arc runs clockwise from 0.7 pi to 2.3 pi around the item centre, the
+// same layout the Canvas gauges used.
+class ArcGauge : public QQuickItem
+{
+    Q_OBJECT
+    Q_PROPERTY(qreal value READ value WRITE setValue NOTIFY valueChanged)
+    Q_PROPERTY(qreal maxValue READ maxValue WRITE setMaxValue NOTIFY maxValueChanged)
+    // Radius of the arc centre line; the widths are full stroke widths
+    Q_PROPERTY(qreal arcRadius READ arcRadius WRITE setArcRadius NOTIFY styleChanged)
+    Q_PROPERTY(qreal trackWidth READ trackWidth WRITE setTrackWidth NOTIFY styleChanged)
+    Q_PROPERTY(qreal progressWidth READ progressWidth WRITE setProgressWidth NOTIFY styleChanged)
+    Q_PROPERTY(qreal glowWidth READ glowWidth WRITE setGlowWidth NOTIFY styleChanged)
+    Q_PROPERTY(qreal glowOpacity READ glowOpacity WRITE setGlowOpacity NOTIFY styleChanged)
+    Q_PROPERTY(QColor trackColor READ trackColor WRITE setTrackColor NOTIFY styleChanged)
+    // Progress is a diagonal gradient: progressColor -> highlightColor -> progressColor
+    Q_PROPERTY(QColor progressColor READ progressColor WRITE setProgressColor NOTIFY styleChanged)
+    Q_PROPERTY(QColor highlightColor READ highlightColor WRITE setHighlightColor NOTIFY styleChanged)
+    Q_PROPERTY(QColor knobColor READ knobColor WRITE setKnobColor NOTIFY styleChanged)
+    Q_PROPERTY(qreal knobRadius READ knobRadius WRITE setKnobRadius NOTIFY styleChanged)
+    Q_PROPERTY(qreal knobInnerRadius READ knobInnerRadius WRITE setKnobInnerRadius NOTIFY styleChanged)
+    Q_PROPERTY(QColor tickColor READ tickColor WRITE setTickColor NOTIFY styleChanged)
+    Q_PROPERTY(int tickCount READ tickCount WRITE setTickCount NOTIFY styleChanged)
+    Q_PROPERTY(int majorTickInterval READ majorTickInterval WRITE setMajorTickInterval NOTIFY styleChanged)
+    // Ticks start this far outside the arc centre line
+    Q_PROPERTY(qreal tickOffset READ tickOffset WRITE setTickOffset NOTIFY styleChanged)
+    Q_PROPERTY(qreal majorTickLength READ majorTickLength WRITE setMajorTickLength NOTIFY styleChanged)
+    Q_PROPERTY(qreal minorTickLength READ minorTickLength WRITE setMinorTickLength NOTIFY styleChanged)
+    Q_PROPERTY(qreal tickWidth READ tickWidth WRITE setTickWidth NOTIFY styleChanged)
+    // Filled disc under the arc, offset slightly down (transparent = none)
+    Q_PROPERTY(QColor shadowColor READ shadowColor WRITE setShadowColor NOTIFY styleChanged)
+
+public:
+    explicit ArcGauge(QQuickItem *parent = nullptr);
+
+    qreal value() const { return m_value; }
+    void setValue(qreal value);
+    qreal maxValue() const { return m_maxValue; }
+    void setMaxValue(qreal value);
+
+    qreal arcRadius() const { return m_arcRadius; }
+    void setArcRadius(qreal radius) { setStyle(m_arcRadius, radius); }
+    qreal trackWidth() const { return m_trackWidth; }
+    void setTrackWidth(qreal width) { setStyle(m_trackWidth, width); }
+    qreal progressWidth() const { return m_progressWidth; }
+    void setProgressWidth(qreal width) { setStyle(m_progressWidth, width); }
+    qreal glowWidth() const { return m_glowWidth; }
+    void setGlowWidth(qreal width) { setStyle(m_glowWidth, width); }
+    qreal glowOpacity() const { return m_glowOpacity; }
+    void setGlowOpacity(qreal opacity) { setStyle(m_glowOpacity, opacity); }
+    QColor trackColor() const { return m_trackColor; }
+    void setTrackColor(const QColor &color) { setStyle(m_trackColor, color); }
+    QColor progressColor() const { return m_progressColor; }
+    void setProgressColor(const QColor &color) { setStyle(m_progressColor, color); }
+    QColor highlightColor() const { return m_highlightColor; }
+    void setHighlightColor(const QColor &color) { setStyle(m_highlightColor, color); }
+    QColor knobColor() const { return m_knobColor; }
+    void setKnobColor(const QColor &color) { setStyle(m_knobColor, color); }
+    qreal knobRadius() const { return m_knobRadius; }
+    void setKnobRadius(qreal radius) { setStyle(m_knobRadius, radius); }
+    qreal knobInnerRadius() const { return m_knobInnerRadius; }
+    void setKnobInnerRadius(qreal radius) { setStyle(m_knobInnerRadius, radius); }
+    QColor tickColor() const { return m_tickColor; }
+    void setTickColor(const QColor &color) { setStyle(m_tickColor, color); }
+    int tickCount() const { return m_tickCount; }
+    void setTickCount(int count) { setStyle(m_tickCount, count); }
+    int majorTickInterval() const { return m_majorTickInterval; }
+    void setMajorTickInterval(int interval) { setStyle(m_majorTickInterval, interval); }
+    qreal tickOffset() const { return m_tickOffset; }
+    void setTickOffset(qreal offset) { setStyle(m_tickOffset, offset); }
+    qreal majorTickLength() const { return m_majorTickLength; }
+    void setMajorTickLength(qreal length) { setStyle(m_majorTickLength, length); }
+    qreal minorTickLength() const { return m_minorTickLength; }
+    void setMinorTickLength(qreal length) { setStyle(m_minorTickLength, length); }
+    qreal tickWidth() const { return m_tickWidth; }
+    void setTickWidth(qreal width) { setStyle(m_tickWidth, width); }
+    QColor shadowColor() const { return m_shadowColor; }
+    void setShadowColor(const QColor &color) { setStyle(m_shadowColor, color); }
+
+signals:
+    void valueChanged();
+    void maxValueChanged();
+    void styleChanged();
+
+protected:
+    QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data) override;
+    void geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry) override;
+
+private:
+    class GaugeNode;
+    struct ArcStrip;
+
+    template<typename T>
+    void setStyle(T &field, const T &value)
+    {
+        if (field == value) return;
+        field = value;
+        m_layoutDirty = true;
+        update();
+        emit styleChanged();
+    }
+
+    double progress() const;
+    void buildLayout(GaugeNode *node);
+    void buildStrip(ArcStrip *strip, qreal halfWidth, bool gradient, qreal opacity);
+    void setStripSweep(ArcStrip *strip, double progress);
+    void buildTicks(GaugeNode *node);
+    void buildKnob(GaugeNode *node);
+    void buildShadow(GaugeNode *node);
+    void updateSweep(GaugeNode *node);
+    QColor gradientAt(float x, float y) const;
+
+    qreal m_value = 0;
+    qreal m_maxValue = 100;
+    qreal m_arcRadius = 80;
+    qreal m_trackWidth = 18;
+    qreal m_progressWidth = 14;
+    qreal m_glowWidth = 20;
+    qreal m_glowOpacity = 0.3;
+    QColor m_trackColor = QColor(64, 64, 64, 204);
+    QColor m_progressColor = QColor("#0078d4");
+    QColor m_highlightColor = QColor("#4da3e6");
+    QColor m_knobColor = QColor("#ffffff");
+    qreal m_knobRadius = 11;
+    qreal m_knobInnerRadius = 9;
+    QColor m_tickColor = QColor("#666666");
+    int m_tickCount = 10;
+    int m_majorTickInterval = 5;
+    qreal m_tickOffset = 17;
+    qreal m_majorTickLength = 9;
+    qreal m_minorTickLength = 5;
+    qreal m_tickWidth = 3;
+    QColor m_shadowColor = QColor(0, 0, 0, 0);
+
+    bool m_layoutDirty = true;
+    bool m_sweepDirty = true;
+};
+
+#endif // ARCGAUGE_H
@@ -1,6 +1,8 @@
 #include "AuraController.h"
 #include <QSettings>
 #include <QRegularExpression>
+#include "SysRoot.h"
+#include "HardwareWriteQueue.h"
 
 AuraController::AuraController(QObject *parent) : QObject(parent), m_initThread(nullptr) {
     m_isAvailable = false;
@@ -67,9 +69,12 @@ void AuraController::initializeController() {
 void AuraController::initializeControllerImpl() {
     // 1. Kill conflicting ASUS services 
     // This mimics the "exclusive control" requirement
-    QProcess::execute("systemctl", QStringList() << "stop" << "asusd");
-    QProcess::execute("pkill", QStringList() << "-f" << "rog-control-center");
-    QProcess::execute("killall", QStringList() << "asusd");
+    // (skipped against a synthetic root so benchmarks never touch the host)
+    if (!SysRoot::isRelocated()) {
+        QProcess::execute("systemctl", QStringList() << "stop" << "asusd");
+        QProcess::execute("pkill", QStringList() << "-f" << "rog-control-center");
+        QProcess::execute("killall", QStringList() << "asusd");
+    }
 
     bool avail = false;
     bool sysfs = false;
@@ -78,18 +83,17 @@ void AuraController::initializeControllerImpl() {
     QString rogauraPath = "";
 
     // 2. Try Sysfs (Native)
-    QString testPath = "/sys/class/leds/asus::kbd_backlight/kbd_rgb_mode";
+    QString testPath = SysRoot::path("/sys/class/leds/asus::kbd_backlight/kbd_rgb_mode");
     if (QFile::exists(testPath)) {
         sysfs = true;
         avail = true;
         // Wake up sequence
-        QFile f("/sys/class/leds/asus::kbd_backlight/kbd_rgb_state");
-        if (f.open(QIODevice::WriteOnly | QIODevice::Text)) {
-            QTextStream out(&f);
-            out << "1 1 1 0 1" << Qt::endl;
-            f.close();
-        }
+        writeSysfs(SysRoot::path("/sys/class/leds/asus::kbd_backlight/kbd_rgb_state"), "1 1 1 0 1");
     } 
+    // (A synthetic root without kbd_rgb_mode has no vendor tools either)
+    else if (SysRoot::isRelocated()) {
+        avail = false;
+    }
     // 3. Try asusctl
     else if (QFile::exists("/usr/bin/asusctl") || QFile::exists("/usr/local/bin/asusctl")) {
         asusCtlPath = QFile::exists("/usr/bin/asusctl") ? "/usr/bin/asusctl" : "/usr/local/bin/asusctl";
@@ -149,21 +153,23 @@ void AuraController::restoreServices(const QString &mode, const QString &color)
     
     // 1. Reset Hardware to Known State (Static) to prevent asusd confusion
     // This removes our 'Mode 10' or 'Mode 4' overrides.
-    writeSysfs("/sys/class/leds/asus::kbd_backlight/kbd_rgb_mode", "0");
+    writeSysfs(SysRoot::path("/sys/class/leds/asus::kbd_backlight/kbd_rgb_mode"), "0");
     
     // 2. Update Config File Directly (The "Deep Research" Fix)
     updateAsusdConfig(mode, color);
     
     // 3. Start Services Detached (Fixes "Lag on Close")
     // We restart the system daemon only - user service will auto-sync
-    QProcess::startDetached("systemctl", QStringList() << "start" << "asusd");
+    if (!SysRoot::isRelocated()) {
+        QProcess::startDetached("systemctl", QStringList() << "start" << "asusd");
+    }
     
     // Note: User service (asusd-user) should auto-detect changes via dbus
     // Removed manual restart as it caused crashes with signal issues
 }
 
 void AuraController::updateAsusdConfig(const QString &mode, const QString &color) {
-    QFile f("/etc/asusd/aura_tuf.ron");
+    QFile f(SysRoot::path("/etc/asusd/aura_tuf.ron"));
     if (!f.open(QIODevice::ReadWrite | QIODevice::Text)) {
         qDebug() << "Failed to open /etc/asusd/aura_tuf.ron";
         return;
@@ -259,7 +265,7 @@ void AuraController::updateAsusdConfig(const QString &mode, const QString &color
 
 int AuraController::getSystemBrightness() {
     // Try to read generic LED brightness
-    QFile f("/sys/class/leds/asus::kbd_backlight/brightness");
+    QFile f(SysRoot::path("/sys/class/leds/asus::kbd_backlight/brightness"));
     if (f.open(QIODevice::ReadOnly)) {
         QByteArray val = f.readAll().trimmed();
         f.close();
@@ -267,7 +273,7 @@ int AuraController::getSystemBrightness() {
         int b = val.toInt();
         // Map 0-3 (or 0-255? Asus usually 0-3)
         // Check max brightness to be sure
-        QFile fmax("/sys/class/leds/asus::kbd_backlight/max_brightness");
+        QFile fmax(SysRoot::path("/sys/class/leds/asus::kbd_backlight/max_brightness"));
         if (fmax.open(QIODevice::ReadOnly)) {
             int max = fmax.readAll().trimmed().toInt();
             fmax.close();
@@ -374,7 +380,7 @@ void AuraController::setBrightness(int level) {
         // Levels 0-3
         int lvl = level;
         if (lvl > 3) lvl = 3; 
-        writeSysfs("/sys/class/leds/asus::kbd_backlight/brightness", QString::number(lvl));
+        writeSysfs(SysRoot::path("/sys/class/leds/asus::kbd_backlight/brightness"), QString::number(lvl));
     } else {
         runCommand(QStringList() << "brightness" << QString::number(level));
     }
@@ -382,14 +388,13 @@ void AuraController::setBrightness(int level) {
 
 // Helpers
 void AuraController::writeSysfs(const QString &path, const QString &val) {
-    QFile f(path);
-    if (f.open(QIODevice::WriteOnly | QIODevice::Text)) {
-        QTextStream out(&f);
-        out << val << Qt::endl; // Mandatory newline for sysfs
-        f.close();
-    } else {
-        qDebug() << "AuraController: Failed to write to" << path;
-    }
+    // Queued off the GUI thread; a newer value for the same file replaces
+    // one that hasn't been written yet
+    HardwareWriteQueue::instance().submit(
+            HardwareWriteQueue::LedMode, path, val + '\n', this, // Mandatory newline for sysfs
+            [path](const HardwareWriteQueue::Result &result) {
+        if (!result.ok && !result.superseded) qDebug() << "AuraController: Failed to write to" << path;
+    });
 }
 
 void AuraController::setSysfsColor(int mode, const QString &hex, int speed) {
@@ -411,7 +416,7 @@ void AuraController::setSysfsColor(int mode, const QString &hex, int speed) {
     qDebug() << "AuraController: Writing Sysfs Mode (RGB):" << modeVal;
     
     // Write to kbd_rgb_mode (NOT state) for immediate effect
-    writeSysfs("/sys/class/leds/asus::kbd_backlight/kbd_rgb_mode", modeVal);
+    writeSysfs(SysRoot::path("/sys/class/leds/asus::kbd_backlight/kbd_rgb_mode"), modeVal);
 }
 
 void AuraController::saveState(const QString &mode, const QString &color) {
@@ -0,0 +1,216 @@
+#include "BlockDeviceScanner.h"
+#include "SysRoot.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <algorithm>
+#include <sys/statvfs.h>
+
+namespace {
+
+struct MountEntry {
+    QString mountPoint;
+    QString fsType;
+};
+
+QByteArray readSmallFile(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) return QByteArray();
+    return file.readAll();
+}
+
+// mountinfo escapes space, tab, newline and backslash as \ooo
+QString unescapeMountField(const QByteArray &field)
+{
+    if (!field.contains('\\')) return QString::fromUtf8(field);
+
+    QByteArray out;
+    out.reserve(field.size());
+    for (int i = 0; i < field.size(); ++i) {
+        if (field[i] == '\\' && i + 3 < field.size()) {
+            bool ok = false;
+            int c = field.mid(i + 1, 3).toInt(&ok, 8);
+            if (ok) {
+                out.append(static_cast<char>(c));
+                i += 3;
+                continue;
+            }
+        }
+        out.append(field[i]);
+    }
+    return QString::fromUtf8(out);
+}
+
+// udev encodes unsafe characters in symlink names as \xHH
+QString decodeUdevName(const QString &name)
+{
+    if (!name.contains(QLatin1String("\\x"))) return name;
+
+    QByteArray in = name.toUtf8();
+    QByteArray out;
+    out.reserve(in.size());
+    for (int i = 0; i < in.size(); ++i) {
+        if (in[i] == '\\' && i + 3 < in.size() && in[i + 1] == 'x') {
+            bool ok = false;
+            int c = in.mid(i + 2, 2).toInt(&ok, 16);
+            if (ok) {
+                out.append(static_cast<char>(c));
+                i += 3;
+                continue;
+            }
+        }
+        out.append(in[i]);
+    }
+    return QString::fromUtf8(out);
+}
+
+// Kernel device name -> decoded symlink name, e.g. nvme0n1p3 -> "Data Drive"
+QHash<QString, QString> readLinkNames(const QString &dirPath)
+{
+    QHash<QString, QString> names;
+    QDir dir(dirPath);
+    const QFileInfoList links = dir.entryInfoList(QDir::System | QDir::Files | QDir::NoDotAndDotDot);
+    for (const QFileInfo &link : links) {
+        if (!link.isSymLink()) continue;
+        const QString device = QFileInfo(link.symLinkTarget()).fileName();
+        if (!device.isEmpty()) names.insert(device, decodeUdevName(link.fileName()));
+    }
+    return names;
+}
+
+// Mounts keyed by "major:minor" and by source device name. Filesystems such
+// as btrfs report an anonymous 0:N device number, so the source is needed too.
+void readMounts(QHash<QString, MountEntry> &byDevnum, QHash<QString, MountEntry> &bySource)
+{
+    const QByteArray content = readSmallFile(SysRoot::path("/proc/self/mountinfo"));
+    const QList<QByteArray> lines = content.split('\n');
+
+    for (const QByteArray &line : lines) {
+        // 36 35 98:0 /mnt1 /mnt2 rw,noatime master:1 - ext3 /dev/root rw,errors=continue
+        const QList<QByteArray> fields = line.split(' ');
+        const int sep = fields.indexOf("-");
+        if (sep < 6 || sep + 2 >= fields.size()) continue;
+
+        MountEntry entry;
+        entry.mountPoint = unescapeMountField(fields[4]);
+        entry.fsType = QString::fromUtf8(fields[sep + 1]);
+
+        // A device mounted twice (bind mounts, btrfs subvolumes) shows "/" if
+        // that is one of them, otherwise its first mount
+        auto insert = [&entry](QHash<QString, MountEntry> &map, const QString &key) {
+            auto it = map.find(key);
+            if (it == map.end()) map.insert(key, entry);
+            else if (entry.mountPoint == QLatin1String("/")) it.value() = entry;
+        };
+
+        insert(byDevnum, QString::fromLatin1(fields[2]));
+
+        const QByteArray source = fields[sep + 2];
+        if (source.startsWith("/dev/") && !source.startsWith("/dev/mapper/")) {
+            insert(bySource, QFileInfo(unescapeMountField(source)).fileName());
+        }
+    }
+}
+
+// Active swap devices (lsblk reports their mount point as [SWAP])
+QStringList readSwaps()
+{
+    QStringList devices;
+    const QList<QByteArray> lines = readSmallFile(SysRoot::path("/proc/swaps")).split('\n');
+    for (int i = 1; i < lines.size(); ++i) {
+        const QByteArray source = lines[i].left(lines[i].indexOf(' '));
+        if (source.startsWith("/dev/")) devices << QFileInfo(QString::fromUtf8(source)).fileName();
+    }
+    return devices;
+}
+
+QString udevFsType(const QString &devnum)
+{
+    const QByteArray db = readSmallFile(SysRoot::path("/run/udev/data/b") + devnum);
+    const int pos = db.indexOf("E:ID_FS_TYPE=");
+    if (pos < 0) return QString();
+    const int start = pos + 13;
+    const int end = db.indexOf('\n', start);
+    return QString::fromUtf8(db.mid(start, end < 0 ? -1 : end - start));
+}
+
+QString diskType(const QString &name)
+{
+    if (name.startsWith(QLatin1String("loop"))) return QStringLiteral("loop");
+    if (name.startsWith(QLatin1String("sr"))) return QStringLiteral("rom");
+    if (name.startsWith(QLatin1String("dm-"))) return QStringLiteral("dm");
+    if (name.startsWith(QLatin1String("md"))) return QStringLiteral("raid");
+    return QStringLiteral("disk");
+}
+
+} // namespace
+
+QVector<BlockDevice> BlockDeviceScanner::scan()
+{
+    QHash<QString, MountEntry> mountsByDevnum;
+    QHash<QString, MountEntry> mountsBySource;
+    readMounts(mountsByDevnum, mountsBySource);
+
+    const QStringList swaps = readSwaps();
+    const QHash<QString, QString> labels = readLinkNames(SysRoot::path("/dev/disk/by-label"));
+    const QHash<QString, QString> partLabels = readLinkNames(SysRoot::path("/dev/disk/by-partlabel"));
+
+    auto describe = [&](const QString &sysDir, const QString &name, const QString &type) {
+        BlockDevice dev;
+        dev.name = name;
+        dev.path = QStringLiteral("/dev/") + name;
+        dev.type = type;
+        dev.label = labels.value(name);
+        dev.partLabel = partLabels.value(name);
+
+        // Sizes in sysfs are always in 512-byte sectors
+        dev.sizeBytes = readSmallFile(sysDir + "/size").trimmed().toDouble() * 512.0;
+
+        const QString devnum = QString::fromLatin1(readSmallFile(sysDir + "/dev").trimmed());
+        MountEntry mount = mountsByDevnum.value(devnum);
+        if (mount.mountPoint.isEmpty()) mount = mountsBySource.value(name);
+
+        dev.fsType = udevFsType(devnum);
+        if (dev.fsType.isEmpty()) dev.fsType = mount.fsType;
+
+        if (!mount.mountPoint.isEmpty()) {
+            dev.mountPoint = mount.mountPoint;
+            struct statvfs st;
+            if (statvfs(QFile::encodeName(mount.mountPoint).constData(), &st) == 0) {
+                dev.hasAvail = true;
+                dev.availBytes = static_cast<double>(st.f_bavail) * st.f_frsize;
+            }
+        } else if (swaps.contains(name)) {
+            dev.mountPoint = QStringLiteral("[SWAP]");
+        }
+        return dev;
+    };
+
+    QVector<BlockDevice> devices;
+    QDir blockDir(SysRoot::path("/sys/block"));
+    const QStringList disks = blockDir.entryList(QDir::Dirs | QDir::System | QDir::NoDotAndDotDot, QDir::Name);
+
+    for (const QString &disk : disks) {
+        const QString diskDir = blockDir.filePath(disk);
+        devices.append(describe(diskDir, disk, diskType(disk)));
+
+        // Partitions are subdirectories carrying a "partition" number
+        QVector<QPair<int, QString>> parts;
+        const QStringList children = QDir(diskDir).entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+        for (const QString &child : children) {
+            if (!child.startsWith(disk)) continue;
+            const QByteArray number = readSmallFile(diskDir + "/" + child + "/partition").trimmed();
+            if (number.isEmpty()) continue;
+            parts.append(qMakePair(number.toInt(), child));
+        }
+        std::sort(parts.begin(), parts.end());
+
+        for (const auto &part : parts) {
+            devices.append(describe(diskDir + "/" + part.second, part.second, QStringLiteral("part")));
+        }
+    }
+    return devices;
+}
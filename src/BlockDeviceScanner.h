@@ -0,0 +1,36 @@
+#ifndef BLOCKDEVICESCANNER_H
+#define BLOCKDEVICESCANNER_H
+
+#include <QString>
+#include <QVector>
+
+// One row of what `lsblk -P -b -o NAME,LABEL,PARTLABEL,MOUNTPOINT,FSTYPE,SIZE,TYPE,FSAVAIL,PATH`
+// used to print.
+struct BlockDevice {
+    QString name;           // Kernel name (nvme0n1p2)
+    QString path;           // Device node (/dev/nvme0n1p2)
+    QString type;           // disk, part, loop, rom, dm, raid
+    QString label;          // Filesystem label
+    QString partLabel;      // GPT partition name
+    QString fsType;
+    QString mountPoint;     // Empty when not mounted
+    double sizeBytes = 0;
+    bool hasAvail = false;  // Mounted and statvfs() succeeded
+    double availBytes = 0;
+};
+
+// In-process replacement for the lsblk subprocess:
+//   /sys/block/*            disks, partitions, sizes
+//   /proc/self/mountinfo    mount points and fstype
+//   /run/udev/data/b*       fstype of unmounted filesystems
+//   /dev/disk/by-label      filesystem labels
+//   /dev/disk/by-partlabel  partition labels
+//   statvfs()               free space of mounted filesystems
+// Devices are listed disk first, then its partitions, like lsblk.
+class BlockDeviceScanner
+{
+public:
+    static QVector<BlockDevice> scan();
+};
+
+#endif // BLOCKDEVICESCANNER_H
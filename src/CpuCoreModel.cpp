@@ -0,0 +1,60 @@
+#include "CpuCoreModel.h"
+#include <algorithm>
+
+CpuCoreModel::CpuCoreModel(QObject *parent) : QAbstractListModel(parent)
+{
+}
+
+int CpuCoreModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_cores.size();
+}
+
+QVariant CpuCoreModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_cores.size()) return QVariant();
+
+    const CpuLoad &core = m_cores.at(index.row());
+    switch (role) {
+    case CoreRole: return index.row();
+    case UsageRole: return core.usage;
+    case UserRole: return core.user;
+    case SystemRole: return core.system;
+    case IowaitRole: return core.iowait;
+    case IrqRole: return core.irq;
+    case StealRole: return core.steal;
+    case OnlineRole: return core.online;
+    }
+    return QVariant();
+}
+
+QHash<int, QByteArray> CpuCoreModel::roleNames() const
+{
+    return {
+        { CoreRole, "core" },
+        { UsageRole, "usage" },
+        { UserRole, "user" },
+        { SystemRole, "system" },
+        { IowaitRole, "iowait" },
+        { IrqRole, "irq" },
+        { StealRole, "steal" },
+        { OnlineRole, "online" }
+    };
+}
+
+void CpuCoreModel::update(const QVector<CpuLoad> &cores)
+{
+    if (cores.size() != m_cores.size()) {
+        beginResetModel();
+        m_cores = cores;
+        m_cores.detach();
+        endResetModel();
+        emit countChanged();
+        return;
+    }
+    if (m_cores.isEmpty()) return;
+
+    // Same shape: copy in place so neither side has to detach each tick
+    std::copy(cores.constBegin(), cores.constEnd(), m_cores.begin());
+    emit dataChanged(index(0), index(m_cores.size() - 1));
+}
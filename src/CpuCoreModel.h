@@ -0,0 +1,43 @@
+#ifndef CPUCOREMODEL_H
+#define CPUCOREMODEL_H
+
+#include <QAbstractListModel>
+#include <QVector>
+#include "ProcStatParser.h"
+
+// Per-core CPU utilisation for QML (one row per logical CPU).
+// Rows are updated in place every sample; the model is only reset when the
+// number of CPUs changes.
+class CpuCoreModel : public QAbstractListModel
+{
+    Q_OBJECT
+    Q_PROPERTY(int count READ rowCount NOTIFY countChanged)
+
+public:
+    enum Roles {
+        CoreRole = Qt::UserRole + 1,
+        UsageRole,
+        UserRole,
+        SystemRole,
+        IowaitRole,
+        IrqRole,
+        StealRole,
+        OnlineRole
+    };
+
+    explicit CpuCoreModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    void update(const QVector<CpuLoad> &cores);
+
+signals:
+    void countChanged();
+
+private:
+    QVector<CpuLoad> m_cores;
+};
+
+#endif // CPUCOREMODEL_H
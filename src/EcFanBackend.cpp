@@ -0,0 +1,172 @@
+#include "EcFanBackend.h"
+#include "SysRoot.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+// Every batch goes to the queue under this target, so a newer one
+// replaces one that hasn't been written yet
+static const char *kQueueTarget = "fan";
+
+int EcFanBackend::capabilities() const
+{
+    return m_registers.gpuDuty >= 0 ? DutyCycle | PerFan | Readback : DutyCycle | Readback;
+}
+
+static QString readLine(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) return QString();
+    return QString::fromUtf8(file.readAll().trimmed());
+}
+
+// Registers are written as numbers or as "0x.." strings
+static int registerValue(const QJsonObject &entry, const char *key, int fallback)
+{
+    const QJsonValue value = entry.value(QLatin1String(key));
+    if (value.isDouble()) return value.toInt(-1);
+    if (value.isString()) {
+        bool ok = false;
+        const int parsed = value.toString().toInt(&ok, 0);
+        return ok ? parsed : -1;
+    }
+    return fallback;
+}
+
+EcFanBackend::Registers EcFanBackend::lookup(const QString &description, const QString &boardName,
+                                             const QString &productName)
+{
+    Registers registers;
+    QFile file(description);
+    if (!file.open(QIODevice::ReadOnly)) return registers;
+
+    QJsonParseError error;
+    const QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &error);
+    if (error.error != QJsonParseError::NoError) {
+        qWarning() << "EcFanBackend:" << description << error.errorString();
+        return registers;
+    }
+
+    for (const QJsonValue &model : doc.object().value("models").toArray()) {
+        const QJsonObject entry = model.toObject();
+        bool matches = false;
+        for (const QJsonValue &board : entry.value("boards").toArray()) {
+            const QString name = board.toString();
+            if (!name.isEmpty() && (boardName.contains(name, Qt::CaseInsensitive) ||
+                                    productName.contains(name, Qt::CaseInsensitive))) {
+                matches = true;
+                break;
+            }
+        }
+        if (!matches) continue;
+
+        registers.cpuDuty = registerValue(entry, "cpuDuty", -1);
+        registers.gpuDuty = registerValue(entry, "gpuDuty", -1);
+        registers.maxDuty = registerValue(entry, "maxDuty", 255);
+        registers.mode = registerValue(entry, "mode", -1);
+        registers.modeManual = registerValue(entry, "modeManual", 0);
+        registers.modeAuto = registerValue(entry, "modeAuto", 0);
+
+        // A typo must not turn into a write somewhere else
+        const auto isByte = [](int value) { return value >= 0 && value <= 255; };
+        if (!isByte(registers.cpuDuty) || !isByte(registers.mode) ||
+            !(registers.gpuDuty == -1 || isByte(registers.gpuDuty)) ||
+            registers.maxDuty < 1 || registers.maxDuty > 255 ||
+            !isByte(registers.modeManual) || !isByte(registers.modeAuto)) {
+            qWarning() << "EcFanBackend: ignoring bad register map entry for" << boardName;
+            return Registers();
+        }
+        return registers;
+    }
+    return registers;
+}
+
+bool EcFanBackend::detect()
+{
+    if (!m_registers.isValid()) {
+        const QString board = readLine(SysRoot::path("/sys/class/dmi/id/board_name"));
+        m_registers = lookup(SysRoot::path("/etc/asus_tuf_ec_registers.json"), board,
+                             readLine(SysRoot::path("/sys/class/dmi/id/product_name")));
+        if (!m_registers.isValid()) {
+            qInfo() << "EcFanBackend: no EC register map for this model" << board;
+            return false;
+        }
+    }
+
+    // Only now: without a map there's no reason to open the EC at all
+    const EmbeddedController::Method method = EmbeddedController::instance().method();
+    if (method == EmbeddedController::None) {
+        qInfo() << "EcFanBackend: no EC access (load ec_sys with write_support=1, or run as root)";
+        return false;
+    }
+    qInfo() << "✓ EC reachable through" << (method == EmbeddedController::DebugFs ? "ec_sys" : "/dev/port")
+            << "- enabling Force EC Mode";
+    return true;
+}
+
+FanBackend::Probe EcFanBackend::measure()
+{
+    // The fans start out in auto, so restating that changes nothing
+    Probe probe;
+    QElapsedTimer timer;
+    timer.start();
+    const bool ok = writeNow(HardwareWriteQueue::EcRegister, kQueueTarget,
+                             QString("%1 %2").arg(m_registers.mode).arg(m_registers.modeAuto));
+    probe.latencyUs = timer.nsecsElapsed() / 1000;
+    probe.faithful = ok && EmbeddedController::instance().read(m_registers.mode) == m_registers.modeAuto;
+    return probe;
+}
+
+int EcFanBackend::readback() const
+{
+    return EmbeddedController::instance().read(m_registers.cpuDuty);
+}
+
+void EcFanBackend::submit(const QVector<EmbeddedController::Write> &writes, QObject *context,
+                          HardwareWriteQueue::Callback onResult)
+{
+    QStringList lines;
+    for (const EmbeddedController::Write &write : writes) {
+        lines << QString("%1 %2").arg(write.reg).arg(write.value);
+    }
+
+    HardwareWriteQueue::Command command;
+    command.kind = HardwareWriteQueue::EcRegister;
+    command.target = kQueueTarget;
+    command.value = lines.join('\n');
+    // As in submitIfChanged: a repeat of the last batch is only written if
+    // the worker finds the registers changed since
+    command.skipIfHeld = command.value == m_lastBatch;
+
+    m_lastBatch = command.value;
+    HardwareWriteQueue::instance().submit(command, context, onResult);
+}
+
+void EcFanBackend::apply(int percentage, QObject *context, HardwareWriteQueue::Callback onResult)
+{
+    const int duty = scale(percentage, m_registers.maxDuty);
+    QVector<EmbeddedController::Write> writes;
+    writes.append({ m_registers.mode, m_registers.modeManual });
+    writes.append({ m_registers.cpuDuty, duty });
+    if (m_registers.gpuDuty >= 0) writes.append({ m_registers.gpuDuty, duty });
+    submit(writes, context, onResult);
+}
+
+void EcFanBackend::revertToAuto()
+{
+    submit({ { m_registers.mode, m_registers.modeAuto } }, nullptr, HardwareWriteQueue::Callback());
+}
+
+QString EcFanBackend::describe(int percentage) const
+{
+    return QString("Manual (EC): %1%").arg(percentage);
+}
+
+QString EcFanBackend::readyMessage() const
+{
+    return QCoreApplication::translate("FanController", "Ready - Using Direct EC Injection (Driverless)");
+}
@@ -0,0 +1,58 @@
+#ifndef ECFANBACKEND_H
+#define ECFANBACKEND_H
+
+#include "FanBackend.h"
+#include "EmbeddedController.h"
+
+// Writes the embedded controller's fan registers directly, in-process
+// through EmbeddedController. Needs the register layout of the machine,
+// taken from its entry in the register map description
+// (/etc/asus_tuf_ec_registers.json, see README); without one it stays
+// unavailable rather than poke guessed offsets.
+class EcFanBackend : public FanBackend
+{
+public:
+    struct Registers {
+        int cpuDuty = -1;       // Duty cycle registers, 0..maxDuty
+        int gpuDuty = -1;
+        int maxDuty = 255;
+        int mode = -1;          // Manual/auto switch
+        int modeManual = 0;
+        int modeAuto = 0;
+
+        bool isValid() const { return cpuDuty >= 0 && mode >= 0; }
+    };
+
+    // The entry of `description` whose "boards" names the DMI board or
+    // product; invalid Registers if there is none
+    static Registers lookup(const QString &description, const QString &boardName,
+                            const QString &productName);
+
+    EcFanBackend() {}
+    explicit EcFanBackend(const Registers &registers) : m_registers(registers) {}
+
+    QString name() const override { return "embedded-controller"; }
+    int capabilities() const override;
+
+    void apply(int percentage, QObject *context = nullptr,
+               HardwareWriteQueue::Callback onResult = HardwareWriteQueue::Callback()) override;
+    void revertToAuto() override;
+    int readback() const override;
+    QString describe(int percentage) const override;
+    QString readyMessage() const override;
+
+protected:
+    bool detect() override;
+    Probe measure() override;
+
+private:
+    // Queues the writes as one EC batch; a repeat of the last batch is
+    // skipped by the queue's worker if the registers still hold it
+    void submit(const QVector<EmbeddedController::Write> &writes, QObject *context,
+                HardwareWriteQueue::Callback onResult);
+
+    Registers m_registers;
+    QString m_lastBatch;
+};
+
+#endif // ECFANBACKEND_H
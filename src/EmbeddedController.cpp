@@ -0,0 +1,240 @@
+#include "EmbeddedController.h"
+#include "SysRoot.h"
+#include <QElapsedTimer>
+#include <QMutexLocker>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+
+static const int kRegisters = 256;
+
+// ACPI EC interface (ACPI spec, "Embedded Controller Interface")
+static const int kDataPort = 0x62;
+static const int kCommandPort = 0x66;       // Status on read
+static const quint8 kStatusObf = 0x01;      // Output buffer full: a byte to read
+static const quint8 kStatusIbf = 0x02;      // Input buffer full: EC hasn't taken the last byte
+static const quint8 kReadCommand = 0x80;
+static const quint8 kWriteCommand = 0x81;
+
+// ec_probe gave up after 10000 x 10 us; an EC that is alive answers in a
+// few microseconds, so poll without sleeping for a while before backing off
+static const qint64 kWaitTimeoutMs = 100;
+static const int kBusyPolls = 64;
+
+static QString debugFsPath()
+{
+    return SysRoot::path("/sys/kernel/debug/ec/ec0/io");
+}
+
+static bool fail(QString *error, const char *message)
+{
+    if (error) *error = QString::fromLatin1(message);
+    return false;
+}
+
+EmbeddedController &EmbeddedController::instance()
+{
+    static EmbeddedController controller;
+    return controller;
+}
+
+EmbeddedController::~EmbeddedController()
+{
+    closeLocked();
+}
+
+void EmbeddedController::setPath(const QString &path)
+{
+    QMutexLocker locker(&m_mutex);
+    closeLocked();
+    m_path = path;
+}
+
+void EmbeddedController::setPortPath(const QString &path)
+{
+    QMutexLocker locker(&m_mutex);
+    closeLocked();
+    m_portPath = path;
+}
+
+QString EmbeddedController::path() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_path.isEmpty() ? debugFsPath() : m_path;
+}
+
+EmbeddedController::Method EmbeddedController::method()
+{
+    QMutexLocker locker(&m_mutex);
+    openLocked();
+    return m_method;
+}
+
+static bool writeSupportEnabled()
+{
+    int fd = ::open(SysRoot::path("/sys/module/ec_sys/parameters/write_support").toLocal8Bit().constData(),
+                    O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+    char c = 0;
+    const bool enabled = ::read(fd, &c, 1) == 1 && (c == 'Y' || c == '1');
+    ::close(fd);
+    return enabled;
+}
+
+bool EmbeddedController::openLocked()
+{
+    if (m_fd >= 0) return true;
+
+    if (!m_portPath.isEmpty()) {
+        m_fd = ::open(m_portPath.toLocal8Bit().constData(), O_RDWR | O_CLOEXEC);
+        m_method = m_fd >= 0 ? PortIo : None;
+        return m_fd >= 0;
+    }
+
+    // ec_sys's io file only accepts writes when loaded with write_support=1
+    if (!m_path.isEmpty() || writeSupportEnabled()) {
+        const QByteArray file = (m_path.isEmpty() ? debugFsPath() : m_path).toLocal8Bit();
+        m_fd = ::open(file.constData(), O_RDWR | O_CLOEXEC);
+        if (m_fd >= 0) {
+            m_method = DebugFs;
+            return true;
+        }
+    }
+
+    // Raw port I/O would reach the real EC even under a synthetic root
+    if (m_path.isEmpty() && !SysRoot::isRelocated()) {
+        m_fd = ::open("/dev/port", O_RDWR | O_CLOEXEC);
+        if (m_fd >= 0) {
+            m_method = PortIo;
+            return true;
+        }
+    }
+
+    m_method = None;
+    return false;
+}
+
+void EmbeddedController::closeLocked()
+{
+    if (m_fd >= 0) ::close(m_fd);
+    m_fd = -1;
+    m_method = None;
+}
+
+int EmbeddedController::read(int reg)
+{
+    if (reg < 0 || reg >= kRegisters) return -1;
+
+    QMutexLocker locker(&m_mutex);
+    if (!openLocked()) return -1;
+
+    if (m_method == PortIo) return portReadRegister(reg);
+
+    quint8 value = 0;
+    ssize_t n;
+    do {
+        n = ::pread(m_fd, &value, 1, reg);
+    } while (n < 0 && errno == EINTR);
+    return n == 1 ? value : -1;
+}
+
+bool EmbeddedController::write(int reg, int value, QString *error)
+{
+    return batch({ { reg, value } }, error);
+}
+
+bool EmbeddedController::batch(const QVector<Write> &writes, QString *error)
+{
+    for (const Write &w : writes) {
+        if (w.reg < 0 || w.reg >= kRegisters || w.value < 0 || w.value > 255)
+            return fail(error, "EC register or value out of range");
+    }
+
+    QMutexLocker locker(&m_mutex);
+    // Two attempts: the open descriptor, then a fresh one if it went stale
+    // (ec_sys reloaded). Rewriting the registers that did land is harmless.
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        if (!openLocked()) return fail(error, "No EC access (ec_sys write_support or /dev/port)");
+        if (batchLocked(writes, error)) return true;
+        if (m_method == PortIo) return false;   // A handshake timeout isn't fixed by reopening
+        closeLocked();
+    }
+    return false;
+}
+
+bool EmbeddedController::batchLocked(const QVector<Write> &writes, QString *error)
+{
+    if (m_method == PortIo) {
+        for (const Write &w : writes) {
+            if (!portWriteRegister(w.reg, static_cast<quint8>(w.value)))
+                return fail(error, "EC handshake timed out");
+        }
+        return true;
+    }
+
+    // Runs of consecutive registers go out as one write
+    quint8 run[kRegisters];
+    for (int i = 0; i < writes.size();) {
+        const int start = writes[i].reg;
+        int length = 0;
+        while (i < writes.size() && writes[i].reg == start + length) {
+            run[length++] = static_cast<quint8>(writes[i++].value);
+        }
+
+        ssize_t written;
+        do {
+            written = ::pwrite(m_fd, run, length, start);
+        } while (written < 0 && errno == EINTR);
+        if (written != length) return fail(error, "Cannot write EC register");
+    }
+    return true;
+}
+
+bool EmbeddedController::portRead(int port, quint8 *value)
+{
+    ssize_t n;
+    do {
+        n = ::pread(m_fd, value, 1, port);
+    } while (n < 0 && errno == EINTR);
+    return n == 1;
+}
+
+bool EmbeddedController::portWrite(int port, quint8 value)
+{
+    ssize_t n;
+    do {
+        n = ::pwrite(m_fd, &value, 1, port);
+    } while (n < 0 && errno == EINTR);
+    return n == 1;
+}
+
+bool EmbeddedController::waitStatus(quint8 mask, quint8 want)
+{
+    QElapsedTimer timer;
+    timer.start();
+    for (int polls = 0;; ++polls) {
+        quint8 status;
+        if (!portRead(kCommandPort, &status)) return false;
+        if ((status & mask) == want) return true;
+        if (timer.hasExpired(kWaitTimeoutMs)) return false;
+        if (polls >= kBusyPolls) ::usleep(10);
+    }
+}
+
+int EmbeddedController::portReadRegister(int reg)
+{
+    quint8 value = 0;
+    if (!waitStatus(kStatusIbf, 0) || !portWrite(kCommandPort, kReadCommand)) return -1;
+    if (!waitStatus(kStatusIbf, 0) || !portWrite(kDataPort, static_cast<quint8>(reg))) return -1;
+    if (!waitStatus(kStatusObf, kStatusObf) || !portRead(kDataPort, &value)) return -1;
+    return value;
+}
+
+bool EmbeddedController::portWriteRegister(int reg, quint8 value)
+{
+    return waitStatus(kStatusIbf, 0) && portWrite(kCommandPort, kWriteCommand) &&
+           waitStatus(kStatusIbf, 0) && portWrite(kDataPort, static_cast<quint8>(reg)) &&
+           waitStatus(kStatusIbf, 0) && portWrite(kDataPort, value) &&
+           waitStatus(kStatusIbf, 0);
+}
@@ -0,0 +1,89 @@
+#ifndef EMBEDDEDCONTROLLER_H
+#define EMBEDDEDCONTROLLER_H
+
+#include <QMutex>
+#include <QString>
+#include <QVector>
+
+// Process-wide access to the embedded controller's 256 byte register space.
+//
+// Every EC write used to fork /bin/ec_probe, which then waited up to 500 ms
+// for it, one process per register. Here the registers are reached from
+// inside the process, in order of preference:
+//
+//   DebugFs  /sys/kernel/debug/ec/ec0/io (ec_sys loaded with write_support=1).
+//            pread/pwrite at the register offset; the kernel runs the EC
+//            transaction under its own EC lock.
+//   PortIo   /dev/port, doing the ACPI EC handshake on ports 0x62/0x66 (what
+//            ec_probe did with inb/outb). Races the kernel's own EC traffic,
+//            so it is only the fallback.
+//
+// The descriptor stays open. A batch runs all of its writes as one session
+// under the lock, and consecutive registers go out in one pwrite on DebugFs.
+//
+// setPath() redirects to a plain 256 byte file (no write_support check and
+// no /dev/port fallback), so the register traffic can be checked without an
+// EC. A relocated SysRoot never falls back to /dev/port either.
+// setPortPath() points PortIo at a plain file standing in for /dev/port, so
+// the handshake can be run the same way.
+class EmbeddedController
+{
+public:
+    enum Method {
+        None,
+        DebugFs,
+        PortIo
+    };
+
+    struct Write {
+        int reg;        // 0..255
+        int value;      // 0..255
+    };
+
+    static EmbeddedController &instance();
+    ~EmbeddedController();
+
+    // Defaults to SysRoot::path("/sys/kernel/debug/ec/ec0/io"). Changing it
+    // closes the open descriptor.
+    void setPath(const QString &path);
+    QString path() const;
+
+    // A file of at least 0x67 bytes: 0x62 is the data port, 0x66 status on
+    // read and command on write. Takes precedence over the DebugFs path;
+    // empty goes back to it.
+    void setPortPath(const QString &path);
+
+    // Opens the EC if it isn't already; None if there is no way in
+    Method method();
+    bool isAvailable() { return method() != None; }
+
+    // The register's value, -1 if it can't be read
+    int read(int reg);
+    bool write(int reg, int value, QString *error = nullptr);
+
+    // Writes in order as one session; stops at the first failure
+    bool batch(const QVector<Write> &writes, QString *error = nullptr);
+
+private:
+    EmbeddedController() = default;
+    Q_DISABLE_COPY(EmbeddedController)
+
+    bool openLocked();
+    void closeLocked();
+    bool batchLocked(const QVector<Write> &writes, QString *error);
+
+    // ACPI EC handshake over /dev/port
+    bool portRead(int port, quint8 *value);
+    bool portWrite(int port, quint8 value);
+    bool waitStatus(quint8 mask, quint8 want);
+    int portReadRegister(int reg);
+    bool portWriteRegister(int reg, quint8 value);
+
+    mutable QMutex m_mutex;
+    QString m_path;             // Empty: the default, resolved on first use
+    QString m_portPath;         // Stand-in for /dev/port, empty if none
+    int m_fd = -1;
+    Method m_method = None;
+};
+
+#endif // EMBEDDEDCONTROLLER_H
@@ -0,0 +1,69 @@
+#include "FanBackend.h"
+#include "SysfsReader.h"
+#include "SysRoot.h"
+#include <QDebug>
+
+const FanBackend::Probe &FanBackend::probe()
+{
+    m_probe = Probe();
+    if (!detect()) return m_probe;
+
+    m_probe = measure();
+    m_probe.available = true;
+    qInfo() << "FanBackend:" << name() << "round trip" << m_probe.latencyUs << "us,"
+            << (m_probe.faithful ? "reads back" : "no read-back");
+    return m_probe;
+}
+
+int FanBackend::scale(int percentage, int max)
+{
+    percentage = qBound(0, percentage, 100);
+    if (percentage >= 100) return max;
+
+    int value = static_cast<int>((percentage / 100.0) * max);
+    if (percentage > 0 && value == 0) value = 1;
+    return value;
+}
+
+int FanBackend::readInt(const QString &path)
+{
+    if (path.isEmpty()) return -1;
+    return static_cast<int>(SysfsReader::instance().readInt(path, -1));
+}
+
+bool FanBackend::writeNow(HardwareWriteQueue::Kind kind, const QString &target, const QString &value)
+{
+    HardwareWriteQueue::Command command;
+    command.kind = kind;
+    command.target = target;
+    command.value = value;
+    return HardwareWriteQueue::instance().execute(command).ok;
+}
+
+bool FanBackend::isControlPath(const QString &path)
+{
+    if (path.startsWith(SysRoot::path("/sys/devices/platform/asus")) ||
+        path.startsWith(SysRoot::path("/sys/class/hwmon"))) {
+        return true;
+    }
+    qWarning() << "Security Block: Attempted write to unauthorized path:" << path;
+    return false;
+}
+
+bool FanBackend::submitIfChanged(HardwareWriteQueue::Kind kind, const QString &path, int value,
+                                 QObject *context, HardwareWriteQueue::Callback onResult)
+{
+    HardwareWriteQueue::Command command;
+    command.kind = kind;
+    command.target = path;
+    command.value = QString::number(value);
+
+    // A new value is written as is; a repeat only if something (the BIOS)
+    // changed the attribute since, which the worker checks
+    const bool changed = m_submitted.value(path, -1) != value;
+    command.skipIfHeld = !changed;
+
+    m_submitted.insert(path, value);
+    HardwareWriteQueue::instance().submit(command, context, onResult);
+    return changed;
+}
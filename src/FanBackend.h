@@ -0,0 +1,92 @@
+#ifndef FANBACKEND_H
+#define FANBACKEND_H
+
+#include <QHash>
+#include <QObject>
+#include <QString>
+#include "HardwareWriteQueue.h"
+
+// One way of driving the fans: asus-wmi thermal policy, hwmon PWM, an
+// acpi_call method or the EC directly.
+//
+// FanController probes every backend at startup. Each backend it finds gets
+// one round trip timed, and is checked for whether it reads back what was
+// written. Requests then go to the backend that honours them most closely,
+// the fastest of those.
+//
+// Writes go through HardwareWriteQueue, so apply() and revertToAuto()
+// return before the hardware is touched. Every path goes through SysRoot,
+// so a backend can be probed on its own against a fake tree.
+class FanBackend
+{
+public:
+    enum Capability {
+        DutyCycle = 0x1,    // Sets a fan speed
+        Profiles  = 0x2,    // Only picks a firmware profile (silent/balanced/turbo)
+        PerFan    = 0x4,    // CPU and GPU fans are written separately
+        Readback  = 0x8     // The hardware reports the value back
+    };
+
+    struct Probe {
+        bool available = false;
+        qint64 latencyUs = -1;      // One write + read-back through the queue
+        bool faithful = false;      // Read back what was written
+    };
+
+    virtual ~FanBackend() {}
+
+    virtual QString name() const = 0;
+    virtual int capabilities() const = 0;
+
+    // detect(), then measure() if the machine has this backend
+    const Probe &probe();
+    const Probe &probeResult() const { return m_probe; }
+
+    // Queues the writes for `percentage`; a backend that can read back
+    // skips (on the write queue's thread) what the hardware already holds,
+    // so re-applying is cheap.
+    // `onResult` is called (on `context`'s thread) for each write.
+    virtual void apply(int percentage, QObject *context = nullptr,
+                       HardwareWriteQueue::Callback onResult = HardwareWriteQueue::Callback()) = 0;
+    virtual void revertToAuto() = 0;
+
+    // Raw value the hardware holds now, -1 where it can't be read
+    virtual int readback() const = 0;
+
+    // What `percentage` means on this backend, for the status line
+    virtual QString describe(int percentage) const = 0;
+    virtual QString readyMessage() const = 0;
+
+    // 0-100 % onto 0..max. Anything above 0 % stays above 0 (on some TUF
+    // models 0 means auto) and 100 % is always max.
+    static int scale(int percentage, int max);
+
+protected:
+    // Looks for the device or method, without writing anything if it can
+    virtual bool detect() = 0;
+    // Writes what the hardware already holds back to it and times that
+    virtual Probe measure() = 0;
+
+    static int readInt(const QString &path);
+    // One write through the queue, waited for
+    static bool writeNow(HardwareWriteQueue::Kind kind, const QString &target, const QString &value);
+
+    // Only asus-wmi and hwmon attributes may be written, so a bad path
+    // can't be used to overwrite an arbitrary file
+    static bool isControlPath(const QString &path);
+
+    // Queues value for an attribute. Repeating the last value queued is
+    // cheap: the queue's worker reads the attribute back and writes only
+    // if it no longer holds value, so the GUI thread never reads sysfs and
+    // nothing queued in between can undo the check. Returns true if value
+    // differs from the last one queued.
+    bool submitIfChanged(HardwareWriteQueue::Kind kind, const QString &path, int value,
+                         QObject *context, HardwareWriteQueue::Callback onResult);
+    void forgetSubmitted() { m_submitted.clear(); }
+
+private:
+    Probe m_probe;
+    QHash<QString, int> m_submitted;    // Last value queued per attribute
+};
+
+#endif // FANBACKEND_H
@@ -5,17 +5,20 @@
 #include <QString>
 #include <QStringList>
 #include <QTimer>
-#include <QProcess>
-#include <QProcess>
+#include <QVector>
+
+class SensorHub;
+class FanBackend;
 
 class FanController : public QObject
 {
     Q_OBJECT
     // Properties readable by QML UI
-    Q_PROPERTY(int cpuFanRpm READ getCpuFanRpm NOTIFY statsUpdated)
-    Q_PROPERTY(int gpuFanRpm READ getGpuFanRpm NOTIFY statsUpdated)
-    Q_PROPERTY(int cpuTemp READ getCpuTemp NOTIFY statsUpdated)
-    Q_PROPERTY(int gpuTemp READ getGpuTemp NOTIFY statsUpdated)
+    // Each notifies only on a real change (RPM with hysteresis, see updateStats)
+    Q_PROPERTY(int cpuFanRpm READ getCpuFanRpm NOTIFY cpuFanRpmChanged)
+    Q_PROPERTY(int gpuFanRpm READ getGpuFanRpm NOTIFY gpuFanRpmChanged)
+    Q_PROPERTY(int cpuTemp READ getCpuTemp NOTIFY cpuTempChanged)
+    Q_PROPERTY(int gpuTemp READ getGpuTemp NOTIFY gpuTempChanged)
     Q_PROPERTY(QString statusMessage READ getStatusMessage NOTIFY statusMessageChanged)
     Q_PROPERTY(bool isManualModeActive READ isManualModeActive NOTIFY manualModeChanged)
 
@@ -39,7 +42,10 @@ public:
     Q_INVOKABLE bool isManualModeActive() const { return m_manualMode; }
 
 signals:
-    void statsUpdated();
+    void cpuFanRpmChanged();
+    void gpuFanRpmChanged();
+    void cpuTempChanged();
+    void gpuTempChanged();
     void statusMessageChanged();
     void manualModeChanged();
 
@@ -48,56 +54,34 @@ private:
     bool m_manualMode;
     int m_currentFanSpeed;
     QString m_statusMessage;
-    QTimer *m_enforcementTimer;
+    int m_enforcementTask;   // SamplingScheduler task, enabled in manual mode
 
-    // --- Control Method Flags ---
-    bool m_useACPICalls;
-    bool m_hasPWMControl;
-    bool m_hasThermalPolicy;
-    bool m_useDirectEC;
-
-    // --- Paths ---
-    QString m_tempPath;      // Path to CPU temp (coretemp)
-    QString m_rpmPath;       // Path to fan RPM (asus-wmi)
-    QString m_gpuTempPath;   // Path to GPU temp
-    
-    QString m_wmiBasePath;   // Base path for WMI thermal policy
-    QString m_wmiHwmonPath;  // Path for WMI PWM control
-    
-    QString m_acpiMethod; // The specific ACPI method found for fan control
-    QStringList m_acpiPaths; // List of detected valid ACPI methods
+    // --- Control Backends ---
+    QVector<FanBackend *> m_backends;  // Every kind this build knows, owned
+    FanBackend *m_backend;              // Best available one, nullptr if none
 
     // --- Private Helper Methods ---
-    void findPaths();
-    bool findWMIPaths();
-    void detectACPIMethods();
-    
-    // ACPI Interaction
-    QString callACPI(const QString &command);
-    bool setFanSpeedACPI(int percentage);
+    void probeBackends();
+    // Available backend with any of the capabilities: ones that read back
+    // what they wrote, then duty cycle control over profiles (when asked
+    // for), then the fastest
+    FanBackend *selectBackend(int anyOf) const;
     
-    // File I/O Helpers
-    int readIntFromFile(QString path);
-    bool writeToSysfs(const QString &path, int value);
-    bool writeECRegister(int reg, int value);
-    
-    // Internal Logic
     // Internal Logic
     void setStatusMessage(const QString &msg);
     void enforceManualMode(); // Called by timer to fight BIOS auto-control
     
-    // Cached Stats (Async Updates)
+    // Shared sensor readings (discovery and sampling live in the hub)
+    SensorHub *m_sensorHub;
+
+    // Readings as last announced to QML
     int m_cachedCpuFanRpm = 0;
     int m_cachedGpuFanRpm = 0;
     int m_cachedCpuTemp = 0;
     int m_cachedGpuTemp = 0;
-    
-    QTimer *m_statsTimer;
-    QProcess *m_gpuProcess;
 
 private slots:
     void updateStats();
-    void onGpuProcessFinished(int exitCode, QProcess::ExitStatus status);
 };
 
 #endif // FANCONTROLLER_H
\ No newline at end of file
@@ -1,8 +1,12 @@
 #include "FanCurveController.h"
+#include "SysRoot.h"
+#include "SensorHub.h"
+#include "HardwareWriteQueue.h"
 #include <QDir>
 
 FanCurveController::FanCurveController(QObject *parent)
-    : QObject(parent)
+    : QObject(parent),
+      m_sensorHub(SensorHub::current())
 {
     // Find system paths
     findPaths();
@@ -10,47 +14,29 @@ FanCurveController::FanCurveController(QObject *parent)
     // Load saved settings
     loadSettings();
     
-    // Create evaluation timer (1 second interval)
-    m_evalTimer = new QTimer(this);
-    m_evalTimer->setInterval(1000);
-    connect(m_evalTimer, &QTimer::timeout, this, &FanCurveController::evaluateTemperature);
-    
-    // Start timer if auto curve was previously enabled
-    if (m_autoCurveEnabled) {
-        m_evalTimer->start();
-    }
+    // Sensor passes come every 500 ms; only re-evaluate when the temperature
+    // moved, or to retry a policy write that failed
+    connect(m_sensorHub, &SensorHub::snapshotUpdated, this, [this]() {
+        if (!m_autoCurveEnabled) return;
+        if (readCpuTemp() == m_currentCpuTemp && m_lastPolicy != -1) return;
+        evaluateTemperature();
+    });
 }
 
 FanCurveController::~FanCurveController()
 {
     saveSettings();
-    if (m_evalTimer) {
-        m_evalTimer->stop();
-    }
 }
 
 void FanCurveController::findPaths()
 {
     // Find thermal policy path
-    QString basePath = "/sys/devices/platform/asus-nb-wmi";
+    QString basePath = SysRoot::path("/sys/devices/platform/asus-nb-wmi");
     if (QFile::exists(basePath + "/throttle_thermal_policy")) {
         m_thermalPolicyPath = basePath + "/throttle_thermal_policy";
     }
     
-    // Find CPU temperature path (check multiple possible locations)
-    QStringList tempPaths = {
-        "/sys/class/thermal/thermal_zone0/temp",
-        "/sys/class/hwmon/hwmon0/temp1_input",
-        "/sys/class/hwmon/hwmon1/temp1_input",
-        "/sys/class/hwmon/hwmon2/temp1_input"
-    };
-    
-    for (const QString &path : tempPaths) {
-        if (QFile::exists(path)) {
-            m_cpuTempPath = path;
-            break;
-        }
-    }
+    // CPU temperature is discovered by driver name in SensorHub
 }
 
 void FanCurveController::setAutoCurveEnabled(bool enabled)
@@ -61,11 +47,9 @@ void FanCurveController::setAutoCurveEnabled(bool enabled)
     
     if (enabled) {
         m_lastPolicy = -1;  // Reset to force first evaluation
-        m_evalTimer->start();
         evaluateTemperature();  // Evaluate immediately
         qDebug() << "Auto Fan Curve ENABLED";
     } else {
-        m_evalTimer->stop();
         m_currentAutoMode = "Manual";
         emit currentAutoModeChanged();
         qDebug() << "Auto Fan Curve DISABLED - Manual mode";
@@ -113,22 +97,11 @@ void FanCurveController::setBalancedThreshold(int temp)
 
 int FanCurveController::readCpuTemp()
 {
-    if (m_cpuTempPath.isEmpty()) return 50;  // Default fallback
-    
-    QFile file(m_cpuTempPath);
-    if (!file.open(QIODevice::ReadOnly)) return 50;
-    
-    QString content = file.readAll().trimmed();
-    file.close();
+    // Same reading FanController shows; already converted from millidegrees
+    const SensorSnapshot snapshot = m_sensorHub->snapshot();
+    if (!snapshot.hasCpuTemp) return 50;  // Default fallback
     
-    int temp = content.toInt();
-    
-    // Most temp files report in millidegrees (e.g., 65000 = 65°C)
-    if (temp > 1000) {
-        temp = temp / 1000;
-    }
-    
-    return temp;
+    return snapshot.cpuTemp;
 }
 
 void FanCurveController::setThermalPolicy(int policy)
@@ -141,14 +114,14 @@ void FanCurveController::setThermalPolicy(int policy)
     // Avoid redundant writes
     if (policy == m_lastPolicy) return;
     
-    QFile file(m_thermalPolicyPath);
-    if (!file.open(QIODevice::WriteOnly)) {
-        qDebug() << "Failed to open thermal policy for writing:" << m_thermalPolicyPath;
-        return;
-    }
-    
-    file.write(QString::number(policy).toUtf8());
-    file.close();
+    // Queued; if it fails, forget it so the next evaluation tries again
+    HardwareWriteQueue::instance().submit(
+            HardwareWriteQueue::ThermalPolicy, m_thermalPolicyPath, QString::number(policy), this,
+            [this](const HardwareWriteQueue::Result &result) {
+        if (result.ok || result.superseded) return;
+        qDebug() << "Failed to write thermal policy:" << m_thermalPolicyPath;
+        m_lastPolicy = -1;
+    });
     
     m_lastPolicy = policy;
     m_currentAutoMode = policyToString(policy);
@@ -171,8 +144,11 @@ void FanCurveController::evaluateTemperature()
 {
     if (!m_autoCurveEnabled) return;
     
-    m_currentCpuTemp = readCpuTemp();
-    emit currentCpuTempChanged();
+    const int temp = readCpuTemp();
+    if (temp != m_currentCpuTemp) {
+        m_currentCpuTemp = temp;
+        emit currentCpuTempChanged();
+    }
     
     int targetPolicy;
     
@@ -8,6 +8,8 @@
 #include <QSettings>
 #include <QDebug>
 
+class SensorHub;
+
 class FanCurveController : public QObject
 {
     Q_OBJECT
@@ -61,12 +63,11 @@ private:
     int m_currentCpuTemp = 0;
     int m_lastPolicy = -1;         // Track last applied policy to avoid redundant writes
     
-    // Timer for temperature polling
-    QTimer *m_evalTimer;
+    // Shared sensor readings; evaluation follows the hub's sampling pass
+    SensorHub *m_sensorHub;
     
     // Paths
     QString m_thermalPolicyPath;
-    QString m_cpuTempPath;
     
     // Helper methods
     int readCpuTemp();
@@ -0,0 +1,204 @@
+#include "GpuSampler.h"
+#include "SysfsReader.h"
+#include "SysRoot.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static qint64 monotonicNs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<qint64>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+static QByteArray readSmallFile(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) return QByteArray();
+    return file.readAll().trimmed();
+}
+
+// Attach only attributes that exist, so missing ones cost nothing per tick
+static int attachIfExists(const QString &path)
+{
+    return QFile::exists(path) ? SysfsReader::instance().attach(path) : -1;
+}
+
+GpuSampler &GpuSampler::instance()
+{
+    static GpuSampler sampler;
+    return sampler;
+}
+
+GpuSampler::GpuSampler()
+{
+    discover();
+}
+
+void GpuSampler::discover()
+{
+    QDir drm(SysRoot::path("/sys/class/drm"));
+    const QStringList cards = drm.entryList(QStringList() << "card*",
+                                            QDir::Dirs | QDir::System | QDir::NoDotAndDotDot, QDir::Name);
+
+    QString amdCard, intelCard, intelDriver;
+    for (const QString &card : cards) {
+        if (card.contains('-')) continue;  // Connectors (card0-eDP-1)
+
+        const QString dir = drm.filePath(card);
+        const QByteArray vendor = readSmallFile(dir + "/device/vendor");
+        QString driver = QFileInfo(QFileInfo(dir + "/device/driver").symLinkTarget()).fileName();
+
+        if (vendor == "0x1002" && driver == "amdgpu" && amdCard.isEmpty()) {
+            amdCard = dir;
+        } else if (vendor == "0x8086" && (driver == "i915" || driver == "xe") && intelCard.isEmpty()) {
+            intelCard = dir;
+            intelDriver = driver;
+        }
+    }
+
+    if (!amdCard.isEmpty()) {
+        m_vendor = Amd;
+        m_driver = "amdgpu";
+        m_cardDir = amdCard;
+    } else if (!intelCard.isEmpty()) {
+        m_vendor = Intel;
+        m_driver = intelDriver;
+        m_cardDir = intelCard;
+    } else {
+        return;
+    }
+
+    const QString device = m_cardDir + "/device";
+    m_runtimeStatusHandle = attachIfExists(device + "/power/runtime_status");
+
+    QString hwmon;
+    const QStringList hwmons = QDir(device + "/hwmon").entryList(QStringList() << "hwmon*", QDir::Dirs | QDir::NoDotAndDotDot);
+    if (!hwmons.isEmpty()) hwmon = device + "/hwmon/" + hwmons.first();
+    if (!hwmon.isEmpty()) m_tempHandle = attachIfExists(hwmon + "/temp1_input");
+
+    if (m_vendor == Amd) {
+        m_busyHandle = attachIfExists(device + "/gpu_busy_percent");
+        if (!hwmon.isEmpty()) m_freqHandle = attachIfExists(hwmon + "/freq1_input");
+        m_dpmSclkHandle = attachIfExists(device + "/pp_dpm_sclk");
+        m_vramUsedHandle = attachIfExists(device + "/mem_info_vram_used");
+        m_vramTotalHandle = attachIfExists(device + "/mem_info_vram_total");
+    } else if (m_driver == "xe") {
+        m_actFreqHandle = attachIfExists(device + "/tile0/gt0/freq0/act_freq");
+        m_curFreqHandle = attachIfExists(device + "/tile0/gt0/freq0/cur_freq");
+        m_idleResidencyHandle = attachIfExists(device + "/tile0/gt0/gtidle/idle_residency_ms");
+    } else {
+        m_actFreqHandle = attachIfExists(m_cardDir + "/gt_act_freq_mhz");
+        m_curFreqHandle = attachIfExists(m_cardDir + "/gt_cur_freq_mhz");
+        m_idleResidencyHandle = attachIfExists(m_cardDir + "/gt/gt0/rc6_residency_ms");
+        if (m_idleResidencyHandle < 0) {
+            m_idleResidencyHandle = attachIfExists(m_cardDir + "/power/rc6_residency_ms");
+        }
+    }
+
+    qInfo() << "GpuSampler: using" << m_driver << "at" << m_cardDir;
+}
+
+bool GpuSampler::isSuspended()
+{
+    if (m_runtimeStatusHandle < 0) return false;
+    char status[32];
+    if (SysfsReader::instance().readText(m_runtimeStatusHandle, status, sizeof(status)) < 0) return false;
+    return strcmp(status, "suspended") == 0;
+}
+
+double GpuSampler::amdClock()
+{
+    SysfsReader &reader = SysfsReader::instance();
+
+    long long hz;
+    if (reader.tryReadInt(m_freqHandle, &hz) && hz > 0) return hz / 1000000.0;
+
+    // pp_dpm_sclk: "0: 500Mhz\n1: 1200Mhz *\n2: 2200Mhz\n" - '*' marks the current level
+    char buf[512];
+    if (reader.read(m_dpmSclkHandle, buf, sizeof(buf)) <= 0) return 0;
+    for (char *line = buf; *line; ) {
+        char *end = strchr(line, '\n');
+        if (end) *end = '\0';
+        if (strchr(line, '*')) {
+            const char *p = strchr(line, ':');
+            if (p) {
+                ++p;
+                while (*p == ' ') ++p;
+                return atof(p);
+            }
+        }
+        if (!end) break;
+        line = end + 1;
+    }
+    return 0;
+}
+
+bool GpuSampler::sample(double *clockMhz, double *usagePercent)
+{
+    if (m_vendor == NoVendor) return false;
+
+    // Reading busy/clock attributes resumes a runtime-suspended dGPU
+    if (isSuspended()) {
+        *clockMhz = 0;
+        *usagePercent = 0;
+        m_prevIdleMs = -1;
+        return true;
+    }
+
+    SysfsReader &reader = SysfsReader::instance();
+
+    if (m_vendor == Amd) {
+        *clockMhz = amdClock();
+        *usagePercent = static_cast<double>(reader.readInt(m_busyHandle, 0));
+        return true;
+    }
+
+    // Intel: actual clock if exposed (it is 0 while in RC6), else the requested one
+    long long mhz;
+    if (!reader.tryReadInt(m_actFreqHandle, &mhz)) mhz = reader.readInt(m_curFreqHandle, 0);
+    *clockMhz = static_cast<double>(mhz);
+
+    // No busy counter: derive it from how long the GT sat in its idle state
+    long long idleMs;
+    const qint64 now = monotonicNs();
+    if (reader.tryReadInt(m_idleResidencyHandle, &idleMs)) {
+        if (m_prevIdleMs >= 0 && now > m_prevSampleNs && idleMs >= m_prevIdleMs) {
+            const double elapsedMs = (now - m_prevSampleNs) / 1e6;
+            const double idleFraction = (idleMs - m_prevIdleMs) / elapsedMs;
+            *usagePercent = qBound(0.0, (1.0 - idleFraction) * 100.0, 100.0);
+        } else {
+            *usagePercent = 0;
+        }
+        m_prevIdleMs = idleMs;
+        m_prevSampleNs = now;
+    } else {
+        *usagePercent = 0;
+    }
+    return true;
+}
+
+int GpuSampler::temperature()
+{
+    if (m_tempHandle < 0 || isSuspended()) return 0;
+    return static_cast<int>(SysfsReader::instance().readInt(m_tempHandle, 0) / 1000);
+}
+
+bool GpuSampler::vram(qint64 *usedBytes, qint64 *totalBytes)
+{
+    if (m_vramTotalHandle < 0 || isSuspended()) return false;
+
+    SysfsReader &reader = SysfsReader::instance();
+    long long used, total;
+    if (!reader.tryReadInt(m_vramUsedHandle, &used) || !reader.tryReadInt(m_vramTotalHandle, &total) || total <= 0)
+        return false;
+    *usedBytes = used;
+    *totalBytes = total;
+    return true;
+}
@@ -0,0 +1,73 @@
+#ifndef GPUSAMPLER_H
+#define GPUSAMPLER_H
+
+#include <QString>
+#include <QtGlobal>
+
+// Native GPU telemetry for AMD and Intel GPUs, read straight from sysfs
+// (no subprocesses). NVIDIA stays on NvidiaSmiStream.
+//
+// The card is picked from /sys/class/drm/card* by PCI vendor ID
+// (AMD 0x1002 before Intel 0x8086):
+//   amdgpu   usage  device/gpu_busy_percent
+//            clock  device/hwmon/*/freq1_input, else the '*' row of pp_dpm_sclk
+//            temp   device/hwmon/*/temp1_input
+//            vram   device/mem_info_vram_used, mem_info_vram_total
+//   i915     clock  gt_act_freq_mhz, else gt_cur_freq_mhz
+//            usage  1 - RC6 residency delta / elapsed time
+//   xe       clock  device/tile0/gt0/freq0/act_freq
+//            usage  1 - gtidle idle_residency_ms delta / elapsed time
+//
+// A runtime-suspended card is reported idle without touching its
+// attributes, so sampling never wakes a sleeping dGPU.
+class GpuSampler
+{
+public:
+    enum Vendor { NoVendor, Amd, Intel };
+
+    static GpuSampler &instance();
+
+    bool isAvailable() const { return m_vendor != NoVendor; }
+    QString driver() const { return m_driver; }
+
+    // Current clock (MHz) and busy percentage. Returns false if no card.
+    bool sample(double *clockMhz, double *usagePercent);
+
+    // GPU temperature in °C, or 0 when the card has no sensor (most iGPUs)
+    int temperature();
+
+    // Dedicated memory in use and in total, in bytes. False when the card
+    // has no VRAM of its own (Intel iGPUs share system memory) or is
+    // suspended.
+    bool vram(qint64 *usedBytes, qint64 *totalBytes);
+
+private:
+    GpuSampler();
+    Q_DISABLE_COPY(GpuSampler)
+
+    void discover();
+    bool isSuspended();
+    double amdClock();
+
+    Vendor m_vendor = NoVendor;
+    QString m_driver;
+    QString m_cardDir;
+
+    // SysfsReader handles (-1 = not present)
+    int m_runtimeStatusHandle = -1;
+    int m_busyHandle = -1;
+    int m_freqHandle = -1;         // amdgpu hwmon freq1_input (Hz)
+    int m_dpmSclkHandle = -1;      // amdgpu pp_dpm_sclk
+    int m_actFreqHandle = -1;      // i915/xe actual clock (MHz)
+    int m_curFreqHandle = -1;      // i915 requested clock (MHz)
+    int m_idleResidencyHandle = -1;
+    int m_tempHandle = -1;
+    int m_vramUsedHandle = -1;     // amdgpu mem_info_vram_used (bytes)
+    int m_vramTotalHandle = -1;
+
+    // Idle-residency based usage (Intel)
+    long long m_prevIdleMs = -1;
+    qint64 m_prevSampleNs = 0;
+};
+
+#endif // GPUSAMPLER_H
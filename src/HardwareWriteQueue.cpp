@@ -0,0 +1,330 @@
+#include "HardwareWriteQueue.h"
+#include "EmbeddedController.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QProcess>
+#include <QVariantMap>
+#include <algorithm>
+#include <memory>
+
+HardwareWriteQueue &HardwareWriteQueue::instance()
+{
+    static HardwareWriteQueue queue;
+    return queue;
+}
+
+HardwareWriteQueue::HardwareWriteQueue(QObject *parent) : QObject(parent)
+{
+    // latenciesChanged is queued to this object: keep it on the GUI thread
+    // even when a background thread is the first to submit
+    if (QCoreApplication::instance()) moveToThread(QCoreApplication::instance()->thread());
+
+    m_running = true;
+    m_thread = QThread::create([this]() { run(); });
+    m_thread->setObjectName("HardwareWriteQueue");
+    m_thread->start();
+}
+
+HardwareWriteQueue::~HardwareWriteQueue()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_running = false;
+        m_wake.wakeAll();
+    }
+    // The worker empties the queue before it returns
+    m_thread->wait();
+    delete m_thread;
+}
+
+QString HardwareWriteQueue::key(const Command &command)
+{
+    return QString::number(command.kind) + ':' + command.target;
+}
+
+quint64 HardwareWriteQueue::submit(Kind kind, const QString &target, const QString &value,
+                                   QObject *context, Callback callback)
+{
+    Command command;
+    command.kind = kind;
+    command.target = target;
+    command.value = value;
+    return submit(command, context, callback);
+}
+
+quint64 HardwareWriteQueue::submit(const Command &command, QObject *context, Callback callback)
+{
+    Pending pending;
+    pending.command = command;
+    pending.context = context;
+    pending.hasContext = context != nullptr;
+    pending.callback = callback;
+
+    const QString k = key(command);
+    Pending replaced;
+    {
+        QMutexLocker locker(&m_mutex);
+        pending.ticket = m_nextTicket++;
+
+        if (m_pending.contains(k)) {
+            replaced = m_pending.value(k);
+            m_order.removeOne(k);
+        }
+        m_pending.insert(k, pending);
+        m_order.append(k);
+        m_wake.wakeOne();
+    }
+
+    if (replaced.ticket) {
+        Result result;
+        result.ticket = replaced.ticket;
+        result.command = replaced.command;
+        result.superseded = true;
+        deliver(replaced, result);
+    }
+    return pending.ticket;
+}
+
+HardwareWriteQueue::Result HardwareWriteQueue::execute(const Command &command)
+{
+    struct Waiter {
+        QMutex mutex;
+        QWaitCondition done;
+        bool finished = false;
+        Result result;
+    };
+    auto waiter = std::make_shared<Waiter>();
+
+    submit(command, nullptr, [waiter](const Result &result) {
+        QMutexLocker locker(&waiter->mutex);
+        waiter->result = result;
+        waiter->finished = true;
+        waiter->done.wakeAll();
+    });
+
+    QMutexLocker locker(&waiter->mutex);
+    while (!waiter->finished) waiter->done.wait(&waiter->mutex);
+    return waiter->result;
+}
+
+void HardwareWriteQueue::drain()
+{
+    QMutexLocker locker(&m_mutex);
+    while (!m_order.isEmpty() || !m_inFlight.isEmpty()) m_idle.wait(&m_mutex);
+}
+
+void HardwareWriteQueue::run()
+{
+    forever {
+        Pending pending;
+        {
+            QMutexLocker locker(&m_mutex);
+            while (m_running && m_order.isEmpty()) m_wake.wait(&m_mutex);
+            if (m_order.isEmpty()) break;  // Stopping and nothing left to write
+
+            m_inFlight = m_order.takeFirst();
+            pending = m_pending.take(m_inFlight);
+        }
+
+        Result result = perform(pending.command);
+        result.ticket = pending.ticket;
+        // ACPI probes are expected to fail; their callers judge the response
+        if (!result.ok && pending.command.kind != AcpiCall) {
+            qWarning() << "HardwareWriteQueue: write failed:" << pending.command.target
+                       << pending.command.value << result.response;
+        }
+
+        if (!result.unchanged) {
+            emit writeFinished(result.ticket, result.command.kind, result.command.target,
+                               result.ok, result.latencyUs);
+        }
+        deliver(pending, result);
+
+        {
+            QMutexLocker locker(&m_mutex);
+            if (!result.unchanged) record(result);
+            m_inFlight.clear();
+            if (m_order.isEmpty()) m_idle.wakeAll();
+        }
+
+        if (!result.unchanged && !m_notifyPending.exchange(true)) {
+            QMetaObject::invokeMethod(this, [this]() {
+                m_notifyPending = false;
+                emit latenciesChanged();
+            }, Qt::QueuedConnection);
+        }
+    }
+}
+
+void HardwareWriteQueue::deliver(const Pending &pending, const Result &result)
+{
+    if (!pending.callback) return;
+    if (!pending.hasContext) {
+        pending.callback(result);   // No context: answer right here
+        return;
+    }
+    if (pending.context.isNull()) return;
+
+    Callback callback = pending.callback;
+    QMetaObject::invokeMethod(pending.context.data(), [callback, result]() {
+        callback(result);
+    }, Qt::QueuedConnection);
+}
+
+static bool attributeHolds(const QString &path, const QString &value)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) return false;
+    return file.readAll().trimmed() == value.trimmed().toUtf8();
+}
+
+// Writes the attribute straight through, so a value the driver rejects
+// fails here rather than later in a buffered close()
+static bool writeAttribute(const QString &path, const QString &value)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Unbuffered)) return false;
+    const QByteArray data = value.toUtf8();
+    return file.write(data) == data.size();
+}
+
+HardwareWriteQueue::Result HardwareWriteQueue::perform(const Command &command) const
+{
+    Result result;
+    result.command = command;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    switch (command.kind) {
+    case AcpiCall: {
+        const QByteArray method = command.target.toLatin1();
+        const QStringList lines = command.value.split('\n');
+        QVector<AcpiCallTransport::Call> calls;
+        calls.reserve(lines.size());
+        for (const QString &args : lines) calls.append({ method, args.toLatin1() });
+
+        const QVector<AcpiCallTransport::Reply> replies = AcpiCallTransport::instance().batch(calls, true);
+        result.acpi = replies.last();
+        result.ok = replies.size() == calls.size() && result.acpi.ok();
+        result.response = result.acpi.toString();
+        break;
+    }
+    case EcRegister: {
+        // One "<reg> <value>" per line, decimal or 0x
+        QVector<EmbeddedController::Write> writes;
+        for (const QString &line : command.value.split('\n', Qt::SkipEmptyParts)) {
+            const QStringList fields = line.split(' ', Qt::SkipEmptyParts);
+            bool regOk = false, valueOk = false;
+            if (fields.size() == 2) {
+                writes.append({ fields[0].toInt(&regOk, 0), fields[1].toInt(&valueOk, 0) });
+            }
+            if (!regOk || !valueOk) {
+                result.response = "Bad EC write: " + line;
+                writes.clear();
+                break;
+            }
+        }
+        if (writes.isEmpty()) break;
+
+        EmbeddedController &ec = EmbeddedController::instance();
+        if (command.skipIfHeld) {
+            bool held = true;
+            for (const EmbeddedController::Write &write : writes) {
+                if (ec.read(write.reg) != write.value) {
+                    held = false;
+                    break;
+                }
+            }
+            if (held) {
+                result.ok = true;
+                result.unchanged = true;
+                break;
+            }
+        }
+        result.ok = ec.batch(writes, &result.response);
+        break;
+    }
+    case ThermalPolicy:
+    case Pwm:
+    case LedMode:
+    case ChargeThreshold:
+        if (command.skipIfHeld && attributeHolds(command.target, command.value)) {
+            result.ok = true;
+            result.unchanged = true;
+            break;
+        }
+        if (!command.helper.isEmpty()) {
+            QProcess helper;
+            helper.start(command.helper.first(), command.helper.mid(1));
+            // VERIFY: the helper may succeed without touching the attribute
+            if (helper.waitForFinished(1000) && helper.exitCode() == 0)
+                result.ok = attributeHolds(command.target, command.value);
+        }
+        if (!result.ok) result.ok = writeAttribute(command.target, command.value);
+        break;
+    }
+
+    result.latencyUs = timer.nsecsElapsed() / 1000;
+    return result;
+}
+
+void HardwareWriteQueue::record(const Result &result)
+{
+    Latency &latency = m_latency[key(result.command)];
+    latency.kind = result.command.kind;
+    latency.target = result.command.target;
+    ++latency.count;
+    if (!result.ok) ++latency.failures;
+    latency.maxUs = qMax(latency.maxUs, result.latencyUs);
+
+    int bucket = 0;
+    for (qint64 us = result.latencyUs; us > 1 && bucket < kLatencyBuckets - 1; us >>= 1) ++bucket;
+    ++latency.buckets[bucket];
+}
+
+qint64 HardwareWriteQueue::bucketUpperUs(int bucket)
+{
+    return qint64(1) << (bucket + 1);
+}
+
+QVariantList HardwareWriteQueue::latencies() const
+{
+    QMutexLocker locker(&m_mutex);
+
+    QStringList keys = m_latency.keys();
+    std::sort(keys.begin(), keys.end());
+
+    QVariantList list;
+    for (const QString &k : keys) {
+        const Latency latency = m_latency.value(k);
+
+        // Quantiles are reported as the upper edge of their bucket
+        const quint64 rank50 = (latency.count + 1) / 2;
+        const quint64 rank95 = (latency.count * 95 + 99) / 100;
+        qint64 p50 = 0, p95 = 0;
+        quint64 seen = 0;
+        QVariantList buckets;
+        for (int i = 0; i < kLatencyBuckets; ++i) {
+            buckets.append(latency.buckets[i]);
+            const quint64 before = seen;
+            seen += latency.buckets[i];
+            if (before < rank50 && seen >= rank50) p50 = qMin(bucketUpperUs(i), latency.maxUs);
+            if (before < rank95 && seen >= rank95) p95 = qMin(bucketUpperUs(i), latency.maxUs);
+        }
+
+        QVariantMap entry;
+        entry["kind"] = static_cast<int>(latency.kind);
+        entry["target"] = latency.target;
+        entry["count"] = latency.count;
+        entry["failures"] = latency.failures;
+        entry["p50Us"] = p50;
+        entry["p95Us"] = p95;
+        entry["maxUs"] = latency.maxUs;
+        entry["buckets"] = buckets;
+        list.append(entry);
+    }
+    return list;
+}
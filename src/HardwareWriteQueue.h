@@ -0,0 +1,146 @@
+#ifndef HARDWAREWRITEQUEUE_H
+#define HARDWAREWRITEQUEUE_H
+
+#include <QObject>
+#include <QHash>
+#include <QMutex>
+#include <QPointer>
+#include <QStringList>
+#include <QThread>
+#include <QVariantList>
+#include <QVector>
+#include <QWaitCondition>
+#include <atomic>
+#include <functional>
+#include "AcpiCallTransport.h"
+
+// Every write that reaches the hardware (asus-wmi attributes, hwmon PWM,
+// acpi_call, the EC, the keyboard LEDs, the battery threshold) goes through
+// this queue and runs on its one worker thread, so a slow firmware call
+// never stalls the GUI thread.
+//
+// Targets are independent; each one (kind + target) has at most one write
+// in flight and one pending. Submitting to a target that already has a
+// write pending replaces its value (the replaced write reports
+// `superseded`) and moves it behind the other queued targets, so writes run
+// in the order of their latest submission: pwm1_enable before pwm1 stays
+// that way however fast the slider moves.
+//
+// The time each write spends in the kernel is kept per target as a log2
+// histogram of microseconds. Writes skipped by skipIfHeld are not counted.
+class HardwareWriteQueue : public QObject
+{
+    Q_OBJECT
+    // One map per target: kind, target, count, failures, p50Us, p95Us, maxUs, buckets
+    Q_PROPERTY(QVariantList latencies READ latencies NOTIFY latenciesChanged)
+
+public:
+    enum Kind {
+        ThermalPolicy,      // asus-wmi throttle_thermal_policy
+        Pwm,                // hwmon pwmN / pwmN_enable
+        AcpiCall,           // acpi_call; target is the method, each line of value one
+                            // call's arguments, run as one AcpiCallTransport batch
+        EcRegister,         // EmbeddedController; target names the registers written,
+                            // each line of value is "<reg> <byte>", run as one batch
+        LedMode,            // asus::kbd_backlight attributes
+        ChargeThreshold     // charge_control_end_threshold
+    };
+    Q_ENUM(Kind)
+
+    struct Command {
+        Kind kind = ThermalPolicy;
+        QString target;         // Attribute path, ACPI method or EC register group
+        QString value;          // Written as is
+        // Optional helper tried first (e.g. asusctl); it counts only if
+        // target reads back as value afterwards, else value is written directly
+        QStringList helper;
+        // Read target first and write nothing if it already holds value.
+        // Done on the worker, right before the write would run, so nothing
+        // queued earlier can land in between. Not for AcpiCall.
+        bool skipIfHeld = false;
+    };
+
+    struct Result {
+        quint64 ticket = 0;
+        Command command;
+        bool ok = false;
+        bool superseded = false;    // Replaced by a newer value, never written
+        bool unchanged = false;     // skipIfHeld and target held value; ok, never written
+        QString response;           // ACPI reply, as acpi_call printed it, or the EC error
+        AcpiCallTransport::Reply acpi;  // Last ACPI reply, parsed
+        qint64 latencyUs = 0;
+    };
+
+    typedef std::function<void(const Result &)> Callback;
+
+    static HardwareWriteQueue &instance();
+    ~HardwareWriteQueue() override;
+
+    // Queue a write and return at once. `callback` runs (queued) on
+    // `context`'s thread and is dropped if `context` is gone by then;
+    // without a context it runs on the worker thread.
+    quint64 submit(const Command &command, QObject *context = nullptr,
+                   Callback callback = Callback());
+    quint64 submit(Kind kind, const QString &target, const QString &value,
+                   QObject *context = nullptr, Callback callback = Callback());
+
+    // Queue a write and wait for it: for callers that need the answer
+    // before they can go on (ACPI method probing). Not from the worker.
+    Result execute(const Command &command);
+
+    // Wait until everything queued so far has been written (shutdown)
+    void drain();
+
+    QVariantList latencies() const;
+
+signals:
+    // Emitted on the worker thread for every write that ran
+    void writeFinished(quint64 ticket, int kind, const QString &target, bool ok, qint64 latencyUs);
+    void latenciesChanged();
+
+private:
+    explicit HardwareWriteQueue(QObject *parent = nullptr);
+    Q_DISABLE_COPY(HardwareWriteQueue)
+
+    static const int kLatencyBuckets = 24;  // [2^i, 2^(i+1)) us; the last is open-ended
+
+    struct Pending {
+        quint64 ticket = 0;
+        Command command;
+        QPointer<QObject> context;
+        bool hasContext = false;    // Tells "none given" from "since destroyed"
+        Callback callback;
+    };
+
+    struct Latency {
+        Kind kind = ThermalPolicy;
+        QString target;
+        quint64 count = 0;
+        quint64 failures = 0;
+        qint64 maxUs = 0;
+        QVector<quint64> buckets = QVector<quint64>(kLatencyBuckets, 0);
+    };
+
+    void run();
+    Result perform(const Command &command) const;
+    void record(const Result &result);
+    static void deliver(const Pending &pending, const Result &result);
+    static QString key(const Command &command);
+    static qint64 bucketUpperUs(int bucket);
+
+    mutable QMutex m_mutex;
+    QWaitCondition m_wake;
+    QWaitCondition m_idle;
+    QStringList m_order;                // Targets with a pending write, oldest first
+    QHash<QString, Pending> m_pending;  // Latest pending write per target
+    QString m_inFlight;                 // Target being written, empty when idle
+    QHash<QString, Latency> m_latency;
+    quint64 m_nextTicket = 1;
+    bool m_running = false;
+    QThread *m_thread = nullptr;
+
+    // Set while a latenciesChanged is queued; a burst of writes notifies once
+    std::atomic<bool> m_notifyPending{false};
+};
+
+#endif // HARDWAREWRITEQUEUE_H
@@ -0,0 +1,74 @@
+#include "MetricHistory.h"
+
+MetricHistory::MetricHistory(int capacity, QObject *parent)
+    : QObject(parent)
+    , m_buffer(qMax(1, capacity), 0.0)
+{
+}
+
+void MetricHistory::setCapacity(int capacity)
+{
+    capacity = qMax(1, capacity);
+    if (capacity == m_buffer.size()) return;
+
+    // Re-pack the newest samples oldest-first into the new ring
+    const int keep = qMin(m_count, capacity);
+    QVector<double> resized(capacity, 0.0);
+    for (int i = 0; i < keep; ++i) {
+        resized[i] = at(m_count - keep + i);
+    }
+
+    const bool countChanging = keep != m_count;
+    m_buffer = resized;
+    m_count = keep;
+    m_head = keep % capacity;
+
+    emit capacityChanged();
+    if (countChanging) emit countChanged();
+}
+
+double MetricHistory::at(int index) const
+{
+    if (index < 0 || index >= m_count) return 0.0;
+
+    // The oldest sample sits at m_head once the ring has wrapped
+    const int cap = m_buffer.size();
+    int slot = m_head - m_count + index;
+    if (slot < 0) slot += cap;
+    return m_buffer[slot];
+}
+
+void MetricHistory::append(double value)
+{
+    const int cap = m_buffer.size();
+    m_buffer[m_head] = value;
+    m_head = (m_head + 1) % cap;
+
+    if (m_count < cap) {
+        ++m_count;
+        emit countChanged();
+    }
+    emit sampleAppended(value);
+}
+
+void MetricHistory::clear()
+{
+    if (m_count == 0) return;
+    m_count = 0;
+    m_head = 0;
+    emit countChanged();
+    emit cleared();
+}
+
+void MetricHistory::spans(const double **first, int *firstCount, const double **second, int *secondCount) const
+{
+    const int cap = m_buffer.size();
+    int start = m_head - m_count;
+    if (start < 0) start += cap;
+
+    const double *data = m_buffer.constData();
+    *first = data + start;
+    *firstCount = qMin(m_count, cap - start);
+    *second = data;
+    *secondCount = m_count - *firstCount;
+}
@@ -0,0 +1,54 @@
+#ifndef METRICHISTORY_H
+#define METRICHISTORY_H
+
+#include <QObject>
+#include <QVector>
+
+// Fixed-capacity history of one metric, oldest sample first.
+//
+// Replaces the QML pattern of copying a JS array with slice(), pushing,
+// shifting and reassigning it every second: samples go into a circular
+// buffer allocated once per capacity change, and listeners only get a
+// sampleAppended(value) delta per sample instead of a whole new array.
+//
+// QML reads values in place with count/at(); C++ readers can walk the two
+// contiguous spans of the ring without copying (see spans()).
+class MetricHistory : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+    Q_PROPERTY(int capacity READ capacity WRITE setCapacity NOTIFY capacityChanged)
+    Q_PROPERTY(double last READ last NOTIFY sampleAppended)
+
+public:
+    explicit MetricHistory(int capacity = 60, QObject *parent = nullptr);
+
+    int count() const { return m_count; }
+    int capacity() const { return m_buffer.size(); }
+    // Keeps the newest samples that still fit
+    void setCapacity(int capacity);
+
+    // 0 = oldest sample, count() - 1 = newest. Out of range reads return 0.
+    Q_INVOKABLE double at(int index) const;
+    double last() const { return m_count > 0 ? at(m_count - 1) : 0.0; }
+
+    void append(double value);
+    Q_INVOKABLE void clear();
+
+    // The samples as (at most) two contiguous runs, oldest first:
+    // [first, first + firstCount) then [second, second + secondCount)
+    void spans(const double **first, int *firstCount, const double **second, int *secondCount) const;
+
+signals:
+    void sampleAppended(double value);
+    void countChanged();
+    void capacityChanged();
+    void cleared();
+
+private:
+    QVector<double> m_buffer;
+    int m_head = 0;     // Slot the next sample goes into
+    int m_count = 0;
+};
+
+#endif // METRICHISTORY_H
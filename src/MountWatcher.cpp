@@ -0,0 +1,111 @@
+#include "MountWatcher.h"
+#include "SysRoot.h"
+#include <QDebug>
+
+#include <linux/netlink.h>
+#include <sys/socket.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+
+// Long enough to fold disk + partitions + automount into one rescan
+static const int kDebounceMs = 200;
+
+MountWatcher::MountWatcher(QObject *parent) : QObject(parent)
+{
+    m_debounceTimer = new QTimer(this);
+    m_debounceTimer->setSingleShot(true);
+    m_debounceTimer->setInterval(kDebounceMs);
+    connect(m_debounceTimer, &QTimer::timeout, this, &MountWatcher::changed);
+
+    // A fake tree's mountinfo is a plain file and never signals; uevents
+    // would describe the host's devices, not the fake ones
+    if (SysRoot::isRelocated()) return;
+
+    openMountInfo();
+    openUeventSocket();
+}
+
+MountWatcher::~MountWatcher()
+{
+    // Notifiers must go before their descriptors are closed
+    delete m_mountNotifier;
+    delete m_ueventNotifier;
+    if (m_mountFd >= 0) ::close(m_mountFd);
+    if (m_ueventFd >= 0) ::close(m_ueventFd);
+}
+
+void MountWatcher::openMountInfo()
+{
+    m_mountFd = ::open("/proc/self/mountinfo", O_RDONLY | O_CLOEXEC);
+    if (m_mountFd < 0) {
+        qWarning() << "MountWatcher: cannot open mountinfo:" << strerror(errno);
+        return;
+    }
+
+    // The kernel reports mount table changes as POLLPRI (Qt: Exception)
+    m_mountNotifier = new QSocketNotifier(m_mountFd, QSocketNotifier::Exception, this);
+    connect(m_mountNotifier, &QSocketNotifier::activated, this, &MountWatcher::onMountTableChanged);
+}
+
+void MountWatcher::openUeventSocket()
+{
+    m_ueventFd = ::socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK, NETLINK_KOBJECT_UEVENT);
+    if (m_ueventFd < 0) {
+        qWarning() << "MountWatcher: uevent socket unavailable:" << strerror(errno);
+        return;
+    }
+
+    struct sockaddr_nl addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.nl_family = AF_NETLINK;
+    addr.nl_groups = 1;  // Kernel uevents
+    if (::bind(m_ueventFd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) < 0) {
+        qWarning() << "MountWatcher: uevent bind failed:" << strerror(errno);
+        ::close(m_ueventFd);
+        m_ueventFd = -1;
+        return;
+    }
+
+    m_ueventNotifier = new QSocketNotifier(m_ueventFd, QSocketNotifier::Read, this);
+    connect(m_ueventNotifier, &QSocketNotifier::activated, this, &MountWatcher::onUevent);
+}
+
+void MountWatcher::onMountTableChanged()
+{
+    // poll() on mountinfo re-arms by itself; the content is re-read by the scanner
+    m_debounceTimer->start();
+}
+
+void MountWatcher::onUevent()
+{
+    // "action@devpath\0KEY=VALUE\0KEY=VALUE\0..."
+    char buf[4096];
+    bool blockChanged = false;
+
+    for (;;) {
+        ssize_t n = ::recv(m_ueventFd, buf, sizeof(buf) - 1, 0);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            // ENOBUFS: events were dropped, rescan to be safe. EAGAIN: drained.
+            if (errno == ENOBUFS) blockChanged = true;
+            break;
+        }
+        if (n == 0) break;
+        buf[n] = '\0';
+
+        const bool relevant = strncmp(buf, "add@", 4) == 0 || strncmp(buf, "remove@", 7) == 0
+                                 || strncmp(buf, "change@", 7) == 0;
+        if (!relevant) continue;
+
+        for (const char *key = buf + strlen(buf) + 1; key < buf + n; key += strlen(key) + 1) {
+            if (strcmp(key, "SUBSYSTEM=block") == 0) {
+                blockChanged = true;
+                break;
+            }
+        }
+    }
+
+    if (blockChanged) m_debounceTimer->start();
+}
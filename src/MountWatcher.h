@@ -0,0 +1,43 @@
+#ifndef MOUNTWATCHER_H
+#define MOUNTWATCHER_H
+
+#include <QObject>
+#include <QSocketNotifier>
+#include <QTimer>
+
+// Event-driven storage hotplug detection, no polling.
+//
+// - /proc/self/mountinfo raises POLLPRI whenever the mount table changes
+//   (watched through an Exception socket notifier)
+// - A NETLINK_KOBJECT_UEVENT socket reports block devices being added or
+//   removed before anything mounts them
+//
+// Bursts (a USB stick adds a disk, its partitions, then gets automounted)
+// are debounced into a single changed() signal.
+class MountWatcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit MountWatcher(QObject *parent = nullptr);
+    ~MountWatcher();
+
+signals:
+    void changed();
+
+private slots:
+    void onMountTableChanged();
+    void onUevent();
+
+private:
+    void openMountInfo();
+    void openUeventSocket();
+
+    int m_mountFd = -1;
+    int m_ueventFd = -1;
+    QSocketNotifier *m_mountNotifier = nullptr;
+    QSocketNotifier *m_ueventNotifier = nullptr;
+    QTimer *m_debounceTimer;
+};
+
+#endif // MOUNTWATCHER_H
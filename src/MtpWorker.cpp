@@ -1,16 +1,16 @@
 #include "MtpWorker.h"
+#include "SamplingScheduler.h"
 
 MtpWorker::MtpWorker(QObject *parent) : QObject(parent)
 {
-    // Timer will be initialized in start() to ensure it belongs to the correct thread
+    // Scan task is registered in start(), once we live on the worker thread
 }
 
 void MtpWorker::start()
 {
-    m_timer = new QTimer(this);
-    m_timer->setInterval(1000); // Scan every 1 second (Faster mobile detection)
-    connect(m_timer, &QTimer::timeout, this, &MtpWorker::scan);
-    m_timer->start();
+    // Scan every 1 second (Faster mobile detection). The scheduler queues the
+    // call onto this worker's thread and skips ticks while a scan is running.
+    m_scanTask = SamplingScheduler::instance().add(this, 1000, 0, [this]() { scan(); });
     
     // Initial scan
     scan();
@@ -200,5 +200,8 @@ void MtpWorker::scan()
         }
     }
     
+    // Only what changed: every emit costs the GUI thread a disk rescan
+    if (newMtpDevices == m_lastDevices) return;
+    m_lastDevices = newMtpDevices;
     emit devicesFound(newMtpDevices);
 }
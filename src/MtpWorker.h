@@ -23,7 +23,8 @@ signals:
     void devicesFound(QVariantList devices);
 
 private:
-    QTimer *m_timer;
+    int m_scanTask = -1;    // SamplingScheduler task id
+    QVariantList m_lastDevices; // As last emitted
 };
 
 #endif // MTPWORKER_H
@@ -0,0 +1,65 @@
+#include "NetworkInterfaceModel.h"
+#include <algorithm>
+
+NetworkInterfaceModel::NetworkInterfaceModel(QObject *parent) : QAbstractListModel(parent)
+{
+}
+
+int NetworkInterfaceModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_interfaces.size();
+}
+
+QVariant NetworkInterfaceModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_interfaces.size()) return QVariant();
+
+    const NetInterfaceStats &iface = m_interfaces.at(index.row());
+    switch (role) {
+    case NameRole: return QString::fromLatin1(iface.name);
+    case RxRateRole: return iface.rxRate;
+    case TxRateRole: return iface.txRate;
+    case RxBytesRole: return static_cast<double>(iface.rxBytes);
+    case TxBytesRole: return static_cast<double>(iface.txBytes);
+    case PresentRole: return iface.present;
+    }
+    return QVariant();
+}
+
+QHash<int, QByteArray> NetworkInterfaceModel::roleNames() const
+{
+    return {
+        { NameRole, "name" },
+        { RxRateRole, "rxRate" },
+        { TxRateRole, "txRate" },
+        { RxBytesRole, "rxBytes" },
+        { TxBytesRole, "txBytes" },
+        { PresentRole, "present" }
+    };
+}
+
+void NetworkInterfaceModel::update(const QVector<NetInterfaceStats> &interfaces)
+{
+    const int oldCount = m_interfaces.size();
+    if (interfaces.size() < oldCount) {
+        // The sampler only appends; a shorter list means it was recreated
+        beginResetModel();
+        m_interfaces = interfaces;
+        m_interfaces.detach();
+        endResetModel();
+        emit countChanged();
+        return;
+    }
+
+    if (oldCount > 0) {
+        std::copy(interfaces.constBegin(), interfaces.constBegin() + oldCount, m_interfaces.begin());
+        emit dataChanged(index(0), index(oldCount - 1));
+    }
+
+    if (interfaces.size() > oldCount) {
+        beginInsertRows(QModelIndex(), oldCount, interfaces.size() - 1);
+        for (int i = oldCount; i < interfaces.size(); ++i) m_interfaces.append(interfaces.at(i));
+        endInsertRows();
+        emit countChanged();
+    }
+}
@@ -0,0 +1,41 @@
+#ifndef NETWORKINTERFACEMODEL_H
+#define NETWORKINTERFACEMODEL_H
+
+#include <QAbstractListModel>
+#include <QVector>
+#include "NetworkSampler.h"
+
+// Per-interface network throughput for QML (one row per interface, in
+// discovery order). New interfaces are appended; rows are never removed,
+// an interface that went away reports present == false.
+class NetworkInterfaceModel : public QAbstractListModel
+{
+    Q_OBJECT
+    Q_PROPERTY(int count READ rowCount NOTIFY countChanged)
+
+public:
+    enum Roles {
+        NameRole = Qt::UserRole + 1,
+        RxRateRole,     // KB/s
+        TxRateRole,     // KB/s
+        RxBytesRole,
+        TxBytesRole,
+        PresentRole
+    };
+
+    explicit NetworkInterfaceModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    void update(const QVector<NetInterfaceStats> &interfaces);
+
+signals:
+    void countChanged();
+
+private:
+    QVector<NetInterfaceStats> m_interfaces;
+};
+
+#endif // NETWORKINTERFACEMODEL_H
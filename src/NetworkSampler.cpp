@@ -0,0 +1,285 @@
+#include "NetworkSampler.h"
+#include <QDebug>
+
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <linux/if_link.h>
+#include <sys/socket.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+
+static const int kBufferSize = 32768;
+// Interface names are re-resolved this often (renames by udev after creation)
+static const int kNameRefreshSamples = 30;
+
+static qint64 monotonicNs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<qint64>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+NetworkSampler::NetworkSampler(const QString &procNetDevPath, bool useNetlink)
+{
+    m_procPath = (procNetDevPath.isEmpty() ? QStringLiteral("/proc/net/dev") : procNetDevPath).toLocal8Bit();
+    m_buffer.resize(kBufferSize);
+    if (useNetlink && !openNetlink()) {
+        qInfo() << "NetworkSampler: rtnetlink stats unavailable, using /proc/net/dev";
+    }
+}
+
+NetworkSampler::~NetworkSampler()
+{
+    if (m_netlinkFd >= 0) ::close(m_netlinkFd);
+    if (m_procFd >= 0) ::close(m_procFd);
+}
+
+// A 32-bit counter only wraps from near its top: more than this across one
+// sample (8.6 Gbit/s at the 2 s slow pass) is taken as a reset instead
+static const quint64 kMaxWrapDelta = 0x80000000ULL;
+
+quint64 NetworkSampler::counterDelta(quint64 prev, quint64 now)
+{
+    if (now >= prev) return now - prev;
+    if (prev <= 0xFFFFFFFFULL) {
+        const quint64 wrapped = (0x100000000ULL - prev) + now;
+        if (wrapped < kMaxWrapDelta) return wrapped;
+    }
+    return 0;
+}
+
+bool NetworkSampler::openNetlink()
+{
+    m_netlinkFd = ::socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+    if (m_netlinkFd < 0) return false;
+
+    // A dump answers immediately; never let a lost reply stall the caller
+    struct timeval tv = { 0, 200000 };
+    ::setsockopt(m_netlinkFd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+    struct sockaddr_nl addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.nl_family = AF_NETLINK;
+    if (::bind(m_netlinkFd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) < 0) {
+        ::close(m_netlinkFd);
+        m_netlinkFd = -1;
+        return false;
+    }
+    return true;
+}
+
+bool NetworkSampler::sampleNetlink()
+{
+    struct {
+        struct nlmsghdr nlh;
+        struct if_stats_msg ifsm;
+    } req;
+    memset(&req, 0, sizeof(req));
+    req.nlh.nlmsg_len = NLMSG_LENGTH(sizeof(struct if_stats_msg));
+    req.nlh.nlmsg_type = RTM_GETSTATS;
+    req.nlh.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    req.nlh.nlmsg_seq = ++m_seq;
+    req.ifsm.family = AF_UNSPEC;
+    req.ifsm.filter_mask = IFLA_STATS_FILTER_BIT(IFLA_STATS_LINK_64);
+
+    if (::send(m_netlinkFd, &req, req.nlh.nlmsg_len, 0) < 0) return false;
+
+    const bool refreshNames = (++m_samplesSinceNames >= kNameRefreshSamples);
+    if (refreshNames) m_samplesSinceNames = 0;
+
+    for (;;) {
+        ssize_t n;
+        do {
+            n = ::recv(m_netlinkFd, m_buffer.data(), m_buffer.size(), 0);
+        } while (n < 0 && errno == EINTR);
+        if (n <= 0) return false;
+
+        int len = static_cast<int>(n);
+        for (struct nlmsghdr *nlh = reinterpret_cast<struct nlmsghdr *>(m_buffer.data());
+             NLMSG_OK(nlh, len); nlh = NLMSG_NEXT(nlh, len)) {
+            if (nlh->nlmsg_seq != m_seq) continue;  // Stale reply from a timed-out dump
+            if (nlh->nlmsg_type == NLMSG_DONE) return true;
+            if (nlh->nlmsg_type == NLMSG_ERROR) return false;
+            if (nlh->nlmsg_type != RTM_NEWSTATS) continue;
+
+            const struct if_stats_msg *ifsm = static_cast<const struct if_stats_msg *>(NLMSG_DATA(nlh));
+            int attrLen = static_cast<int>(nlh->nlmsg_len) - NLMSG_LENGTH(sizeof(*ifsm));
+            const struct rtattr *rta = reinterpret_cast<const struct rtattr *>(
+                reinterpret_cast<const char *>(ifsm) + NLMSG_ALIGN(sizeof(*ifsm)));
+
+            for (; RTA_OK(rta, attrLen); rta = RTA_NEXT(rta, attrLen)) {
+                if (rta->rta_type != IFLA_STATS_LINK_64) continue;
+                if (RTA_PAYLOAD(rta) < sizeof(struct rtnl_link_stats64)) continue;
+
+                // Payload is only 4-byte aligned; copy before reading u64 fields
+                struct rtnl_link_stats64 stats;
+                memcpy(&stats, RTA_DATA(rta), sizeof(stats));
+
+                const int ifindex = static_cast<int>(ifsm->ifindex);
+                if (ifindex == m_loopbackIndex) continue;
+
+                // Names are resolved only for new interfaces (and periodically)
+                NetInterfaceStats *known = nullptr;
+                for (NetInterfaceStats &iface : m_interfaces) {
+                    if (iface.ifindex == ifindex) {
+                        known = &iface;
+                        break;
+                    }
+                }
+                if (known && !refreshNames) {
+                    record(known->name, static_cast<int>(strlen(known->name)), known->ifindex,
+                           stats.rx_bytes, stats.tx_bytes);
+                } else {
+                    char name[IFNAMSIZ];
+                    if (!if_indextoname(ifsm->ifindex, name)) continue;
+                    if (strcmp(name, "lo") == 0) {
+                        m_loopbackIndex = ifindex;
+                        continue;
+                    }
+                    record(name, static_cast<int>(strlen(name)), ifindex, stats.rx_bytes, stats.tx_bytes);
+                }
+            }
+        }
+    }
+}
+
+bool NetworkSampler::sampleProcNetDev()
+{
+    ssize_t n = -1;
+    for (int attempt = 0; attempt < 2 && n < 0; ++attempt) {
+        if (m_procFd < 0) {
+            m_procFd = ::open(m_procPath.constData(), O_RDONLY | O_CLOEXEC);
+            if (m_procFd < 0) return false;
+        }
+        do {
+            n = ::pread(m_procFd, m_buffer.data(), m_buffer.size() - 1, 0);
+        } while (n < 0 && errno == EINTR);
+        if (n < 0) {
+            ::close(m_procFd);
+            m_procFd = -1;
+        }
+    }
+    if (n <= 0) return false;
+    m_buffer[static_cast<int>(n)] = '\0';
+
+    //  face |bytes    packets errs drop fifo frame compressed multicast|bytes ...
+    //  eth0: 1234 ...
+    // Two header lines, then one line per interface: name, 8 rx fields, 8 tx fields
+    const char *p = m_buffer.constData();
+    const char *end = p + n;
+    for (int skip = 0; skip < 2 && p < end; ++skip) {
+        while (p < end && *p != '\n') ++p;
+        ++p;
+    }
+
+    while (p < end) {
+        while (p < end && *p == ' ') ++p;
+        const char *name = p;
+        while (p < end && *p != ':' && *p != '\n') ++p;
+        if (p >= end || *p != ':') {
+            ++p;
+            continue;
+        }
+        const int nameLen = static_cast<int>(p - name);
+        ++p;
+
+        quint64 fields[9];
+        for (quint64 &field : fields) {
+            field = 0;
+            while (*p == ' ') ++p;
+            while (*p >= '0' && *p <= '9') field = field * 10 + (*p++ - '0');
+        }
+        while (p < end && *p != '\n') ++p;
+        ++p;
+
+        if (nameLen > 0 && nameLen < IFNAMSIZ) {
+            record(name, nameLen, 0, fields[0], fields[8]);
+        }
+    }
+    return true;
+}
+
+NetInterfaceStats *NetworkSampler::findOrAdd(const char *name, int nameLen, int ifindex)
+{
+    for (NetInterfaceStats &iface : m_interfaces) {
+        if (ifindex > 0 ? iface.ifindex == ifindex
+                        : (strncmp(iface.name, name, nameLen) == 0 && iface.name[nameLen] == '\0')) {
+            return &iface;
+        }
+    }
+
+    // New interface: the only path that allocates
+    NetInterfaceStats iface;
+    iface.ifindex = ifindex;
+    m_interfaces.append(iface);
+    return &m_interfaces.last();
+}
+
+void NetworkSampler::record(const char *name, int nameLen, int ifindex, quint64 rx, quint64 tx)
+{
+    if (nameLen == 2 && name[0] == 'l' && name[1] == 'o') return;
+
+    NetInterfaceStats *iface = findOrAdd(name, nameLen, ifindex);
+
+    // Same ifindex under a new name: rename, or the index was reused
+    if (strncmp(iface->name, name, nameLen) != 0 || iface->name[nameLen] != '\0') {
+        memcpy(iface->name, name, nameLen);
+        iface->name[nameLen] = '\0';
+        iface->counted = strncmp(iface->name, "lo", 2) != 0 && strncmp(iface->name, "vmnet", 5) != 0;
+    }
+
+    if (iface->hasPrev && m_intervalSec > 0) {
+        iface->rxRate = counterDelta(iface->rxBytes, rx) / m_intervalSec / 1024.0;
+        iface->txRate = counterDelta(iface->txBytes, tx) / m_intervalSec / 1024.0;
+    } else {
+        iface->rxRate = 0;
+        iface->txRate = 0;
+    }
+    iface->rxBytes = rx;
+    iface->txBytes = tx;
+    iface->hasPrev = true;
+    iface->present = true;
+}
+
+bool NetworkSampler::sample()
+{
+    const qint64 now = monotonicNs();
+    m_intervalNs = m_timestampNs > 0 ? now - m_timestampNs : 0;
+    m_intervalSec = m_intervalNs / 1e9;
+    m_timestampNs = now;
+
+    for (NetInterfaceStats &iface : m_interfaces) iface.present = false;
+
+    bool ok = false;
+    if (m_netlinkFd >= 0) {
+        ok = sampleNetlink();
+        if (!ok) {
+            // Kernel without RTM_GETSTATS (pre-4.7) or a broken socket
+            qInfo() << "NetworkSampler: rtnetlink stats failed, falling back to /proc/net/dev";
+            ::close(m_netlinkFd);
+            m_netlinkFd = -1;
+            for (NetInterfaceStats &iface : m_interfaces) iface.ifindex = 0;
+        }
+    }
+    if (!ok) ok = sampleProcNetDev();
+
+    m_rxRate = 0;
+    m_txRate = 0;
+    for (NetInterfaceStats &iface : m_interfaces) {
+        if (!iface.present) {
+            iface.hasPrev = false;
+            iface.rxRate = 0;
+            iface.txRate = 0;
+            continue;
+        }
+        if (iface.counted) {
+            m_rxRate += iface.rxRate;
+            m_txRate += iface.txRate;
+        }
+    }
+
+    return ok && m_intervalNs > 0;
+}
@@ -0,0 +1,80 @@
+#ifndef NETWORKSAMPLER_H
+#define NETWORKSAMPLER_H
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+#include <net/if.h>
+
+// Byte counters and rates of one network interface
+struct NetInterfaceStats {
+    char name[IFNAMSIZ] = {};
+    int ifindex = 0;            // 0 when the counters come from /proc/net/dev
+    quint64 rxBytes = 0;
+    quint64 txBytes = 0;
+    double rxRate = 0;          // KB/s
+    double txRate = 0;          // KB/s
+    bool counted = false;       // Part of the totals (not lo* / vmnet*)
+    bool present = false;       // Seen in the latest sample
+    bool hasPrev = false;
+};
+
+// Per-interface network throughput.
+//
+// Counters come from rtnetlink as binary RTM_GETSTATS / IFLA_STATS_LINK_64
+// records (one dump request, no text). When netlink is unavailable (old
+// kernel, relocated sysroot) the sampler falls back to an allocation-free
+// /proc/net/dev parser. Rates are computed against CLOCK_MONOTONIC
+// timestamps, so they are right whatever period the caller samples at.
+class NetworkSampler
+{
+public:
+    explicit NetworkSampler(const QString &procNetDevPath = QString(), bool useNetlink = true);
+    ~NetworkSampler();
+
+    // Take one sample. Returns true once rates cover a real interval.
+    bool sample();
+
+    // Totals over counted interfaces, KB/s
+    double rxRate() const { return m_rxRate; }
+    double txRate() const { return m_txRate; }
+
+    // Every interface except loopback, in discovery order. Interfaces that
+    // disappeared stay in the list with present == false.
+    const QVector<NetInterfaceStats> &interfaces() const { return m_interfaces; }
+
+    bool usingNetlink() const { return m_netlinkFd >= 0; }
+    qint64 intervalNs() const { return m_intervalNs; }
+
+    // Delta between two readings of a counter that may be 32-bit in the
+    // driver. A drop from near the top of the 32-bit range is a wrap; any
+    // other drop is a counter reset and yields 0.
+    static quint64 counterDelta(quint64 prev, quint64 now);
+
+private:
+    Q_DISABLE_COPY(NetworkSampler)
+
+    bool openNetlink();
+    bool sampleNetlink();
+    bool sampleProcNetDev();
+    void record(const char *name, int nameLen, int ifindex, quint64 rx, quint64 tx);
+    NetInterfaceStats *findOrAdd(const char *name, int nameLen, int ifindex);
+
+    QByteArray m_procPath;
+    int m_procFd = -1;
+    int m_netlinkFd = -1;
+    quint32 m_seq = 0;
+    int m_loopbackIndex = -1;
+    QByteArray m_buffer;
+    int m_samplesSinceNames = 0;
+
+    QVector<NetInterfaceStats> m_interfaces;
+    double m_rxRate = 0;
+    double m_txRate = 0;
+    double m_intervalSec = 0;
+    qint64 m_timestampNs = 0;
+    qint64 m_intervalNs = 0;
+};
+
+#endif // NETWORKSAMPLER_H
@@ -0,0 +1,138 @@
+#include "NvidiaSmiStream.h"
+#include "SysRoot.h"
+#include <QDebug>
+#include <QFileInfo>
+#include <QStandardPaths>
+
+static const int kInitialBackoffMs = 1000;
+static const int kMaxBackoffMs = 60000;
+
+NvidiaSmiStream &NvidiaSmiStream::instance()
+{
+    static NvidiaSmiStream stream;
+    return stream;
+}
+
+NvidiaSmiStream::NvidiaSmiStream(QObject *parent)
+    : QObject(parent),
+      m_backoffMs(kInitialBackoffMs)
+{
+    m_program = qEnvironmentVariable("ASUS_TUF_NVIDIA_SMI");
+    if (m_program.isEmpty()) {
+        if (SysRoot::isRelocated()) {
+            // A fake tree may ship a stand-in; never fall through to the real GPU
+            QString standIn = SysRoot::path("/usr/bin/nvidia-smi");
+            if (QFileInfo(standIn).isExecutable()) m_program = standIn;
+        } else {
+            m_program = QStandardPaths::findExecutable("nvidia-smi");
+        }
+    }
+    m_available = !m_program.isEmpty();
+    m_clock.start();
+
+    m_process = new QProcess(this);
+    m_process->setReadChannel(QProcess::StandardOutput);
+    m_process->setProcessChannelMode(QProcess::SeparateChannels);
+    connect(m_process, &QProcess::readyReadStandardOutput, this, &NvidiaSmiStream::onReadyRead);
+    connect(m_process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
+            this, &NvidiaSmiStream::onFinished);
+    connect(m_process, &QProcess::errorOccurred, this, &NvidiaSmiStream::onErrorOccurred);
+
+    m_restartTimer = new QTimer(this);
+    m_restartTimer->setSingleShot(true);
+    connect(m_restartTimer, &QTimer::timeout, this, &NvidiaSmiStream::startProcess);
+}
+
+NvidiaSmiStream::~NvidiaSmiStream()
+{
+    stopProcess();
+}
+
+void NvidiaSmiStream::acquire()
+{
+    if (++m_users == 1) startProcess();
+}
+
+void NvidiaSmiStream::release()
+{
+    if (m_users == 0) return;
+    if (--m_users == 0) stopProcess();
+}
+
+void NvidiaSmiStream::startProcess()
+{
+    if (!m_available || m_users == 0) return;
+    if (m_process->state() != QProcess::NotRunning) return;
+
+    m_stopping = false;
+    m_process->start(m_program, QStringList()
+                     << "--query-gpu=index,clocks.gr,utilization.gpu,temperature.gpu"
+                     << "--format=csv,noheader,nounits"
+                     << QString("--loop-ms=%1").arg(m_periodMs));
+}
+
+void NvidiaSmiStream::stopProcess()
+{
+    m_restartTimer->stop();
+    if (m_process->state() == QProcess::NotRunning) return;
+
+    m_stopping = true;
+    m_process->terminate();  // Graceful first
+    if (!m_process->waitForFinished(500)) {
+        m_process->kill();  // Force kill if graceful fails
+        m_process->waitForFinished(100);
+    }
+}
+
+void NvidiaSmiStream::onReadyRead()
+{
+    while (m_process->canReadLine()) {
+        parseLine(m_process->readLine());
+    }
+}
+
+void NvidiaSmiStream::parseLine(const QByteArray &line)
+{
+    // "0, 1230, 15, 55" - one line per GPU per period; unsupported fields read "[N/A]"
+    const QList<QByteArray> fields = line.split(',');
+    if (fields.size() < 4) return;
+
+    bool ok = false;
+    if (fields[0].trimmed().toInt(&ok) != 0 || !ok) return;  // First GPU only
+
+    Sample s;
+    s.clockMhz = fields[1].trimmed().toDouble(&s.hasClock);
+    s.utilization = fields[2].trimmed().toDouble(&s.hasUtilization);
+    s.temperature = fields[3].trimmed().toInt(&s.hasTemperature);
+    if (!s.hasClock && !s.hasUtilization && !s.hasTemperature) return;
+
+    s.timestampMs = m_clock.elapsed() + 1;
+
+    m_sample.store(s);
+    m_backoffMs = kInitialBackoffMs;  // Healthy again
+    emit sampleUpdated();
+}
+
+void NvidiaSmiStream::onFinished(int exitCode, QProcess::ExitStatus status)
+{
+    if (m_stopping) return;
+    qWarning() << "nvidia-smi stream ended (exit" << exitCode << (status == QProcess::CrashExit ? "crash)" : ")")
+               << "- restarting in" << m_backoffMs << "ms";
+    scheduleRestart();
+}
+
+void NvidiaSmiStream::onErrorOccurred(QProcess::ProcessError error)
+{
+    if (error != QProcess::FailedToStart) return;  // Crashes arrive via finished()
+
+    // Missing or not executable: stop retrying, consumers fall back to sysfs
+    qWarning() << "nvidia-smi unavailable:" << m_process->errorString();
+    m_available = false;
+}
+
+void NvidiaSmiStream::scheduleRestart()
+{
+    if (m_users == 0) return;
+    m_restartTimer->start(m_backoffMs);
+    m_backoffMs = qMin(m_backoffMs * 2, kMaxBackoffMs);
+}
@@ -0,0 +1,92 @@
+#ifndef NVIDIASMISTREAM_H
+#define NVIDIASMISTREAM_H
+
+#include <QObject>
+#include <QProcess>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <atomic>
+#include "Seqlock.h"
+
+// One long-lived `nvidia-smi --query-gpu=... -lms <period>` child shared by
+// every consumer, instead of a process spawn per tick per controller.
+//
+// Lines are parsed as they arrive; the latest values are published as a
+// sample (through a Seqlock, so the sampling thread can read it while the
+// GUI thread parses) that consumers read on their own tick.
+// If the child dies it is restarted
+// with exponential backoff. The stream only runs while at least one consumer
+// holds it (acquire/release).
+//
+// The executable can be replaced by a stand-in that prints the same CSV
+// (ASUS_TUF_NVIDIA_SMI=/path/to/script, or usr/bin/nvidia-smi inside a
+// relocated sysroot).
+class NvidiaSmiStream : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Sample {
+        double clockMhz = 0;        // clocks.gr
+        double utilization = 0;     // utilization.gpu, percent
+        int temperature = 0;        // temperature.gpu, °C
+        bool hasClock = false;
+        bool hasUtilization = false;
+        bool hasTemperature = false;
+        qint64 timestampMs = 0;     // Monotonic, when the line arrived
+    };
+
+    static NvidiaSmiStream &instance();
+    ~NvidiaSmiStream() override;
+
+    // Reference-counted start/stop
+    void acquire();
+    void release();
+
+    // False once the executable turned out to be missing
+    bool isAvailable() const { return m_available.load(); }
+
+    // Latest sample; safe to call from any thread
+    Sample sample() const { return m_sample.load(); }
+    bool hasSample() const { return sample().timestampMs > 0; }
+
+    // True while the sample is recent enough to display
+    bool isFresh(const Sample &s, qint64 maxAgeMs = 5000) const
+    {
+        return s.timestampMs > 0 && m_clock.elapsed() + 1 - s.timestampMs <= maxAgeMs;
+    }
+    bool isFresh(qint64 maxAgeMs = 5000) const { return isFresh(sample(), maxAgeMs); }
+
+    // Output period passed to -lms (takes effect on the next start)
+    void setPeriodMs(int ms) { m_periodMs = ms; }
+
+signals:
+    void sampleUpdated();
+
+private slots:
+    void startProcess();
+    void onReadyRead();
+    void onFinished(int exitCode, QProcess::ExitStatus status);
+    void onErrorOccurred(QProcess::ProcessError error);
+
+private:
+    explicit NvidiaSmiStream(QObject *parent = nullptr);
+    Q_DISABLE_COPY(NvidiaSmiStream)
+
+    void stopProcess();
+    void parseLine(const QByteArray &line);
+    void scheduleRestart();
+
+    QString m_program;
+    QProcess *m_process;
+    QTimer *m_restartTimer;
+    QElapsedTimer m_clock;
+    Seqlock<Sample> m_sample;
+    int m_users = 0;
+    int m_periodMs = 1000;
+    int m_backoffMs;
+    std::atomic<bool> m_available{true};
+    bool m_stopping = false;
+};
+
+#endif // NVIDIASMISTREAM_H
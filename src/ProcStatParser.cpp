@@ -0,0 +1,174 @@
+#include "ProcStatParser.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+
+// Enough for the cpu lines of ~100 threads; grows on demand beyond that
+static const int kInitialBufferSize = 8192;
+
+static qint64 monotonicNs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<qint64>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+ProcStatParser::ProcStatParser(const QString &path)
+{
+    m_buffer.resize(kInitialBufferSize);
+    setPath(path.isEmpty() ? QStringLiteral("/proc/stat") : path);
+}
+
+ProcStatParser::~ProcStatParser()
+{
+    if (m_fd >= 0) ::close(m_fd);
+}
+
+void ProcStatParser::setPath(const QString &path)
+{
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+    m_path = path.toLocal8Bit();
+    m_hasPrev = false;
+    m_seen.fill(0);
+}
+
+int ProcStatParser::readFile()
+{
+    // Two attempts: cached descriptor, then a fresh one (fake trees rewrite the file)
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        if (m_fd < 0) {
+            m_fd = ::open(m_path.constData(), O_RDONLY | O_CLOEXEC);
+            if (m_fd < 0) return -1;
+        }
+
+        ssize_t n;
+        for (;;) {
+            do {
+                n = ::pread(m_fd, m_buffer.data(), m_buffer.size() - 1, 0);
+            } while (n < 0 && errno == EINTR);
+
+            if (n < 0 || n < m_buffer.size() - 1) break;
+
+            // Buffer filled: fine as long as the cpu lines ended inside it
+            // (the huge intr line that follows is never needed)
+            m_buffer[n] = '\0';
+            const char *end = m_buffer.constData() + n;
+            const char *p = m_buffer.constData();
+            bool cpuLinesDone = false;
+            while (p < end) {
+                if (p[0] != 'c' || p[1] != 'p' || p[2] != 'u') {
+                    cpuLinesDone = true;
+                    break;
+                }
+                while (p < end && *p != '\n') ++p;
+                ++p;
+            }
+            if (cpuLinesDone) break;
+            m_buffer.resize(m_buffer.size() * 2);
+        }
+
+        if (n >= 0) {
+            m_buffer[n] = '\0';
+            return static_cast<int>(n);
+        }
+
+        ::close(m_fd);
+        m_fd = -1;
+    }
+    return -1;
+}
+
+void ProcStatParser::ensureCores(int count)
+{
+    if (count <= m_cores.size()) return;
+    m_cores.resize(count);
+    m_prevCores.resize(count * FieldCount);
+    m_seen.resize(count);
+}
+
+void ProcStatParser::computeLoad(const quint64 *now, quint64 *prev, bool hadPrev, CpuLoad &out)
+{
+    out.online = true;
+    if (hadPrev) {
+        quint64 delta[FieldCount];
+        quint64 total = 0;
+        for (int f = 0; f < FieldCount; ++f) {
+            // Counters can step back when a core is hot-replugged
+            delta[f] = now[f] >= prev[f] ? now[f] - prev[f] : 0;
+            total += delta[f];
+        }
+        if (total > 0) {
+            const double scale = 100.0 / static_cast<double>(total);
+            out.user = (delta[User] + delta[Nice]) * scale;
+            out.system = delta[System] * scale;
+            out.iowait = delta[Iowait] * scale;
+            out.irq = (delta[Irq] + delta[Softirq]) * scale;
+            out.steal = delta[Steal] * scale;
+            out.usage = (total - delta[Idle] - delta[Iowait]) * scale;
+        }
+    }
+    for (int f = 0; f < FieldCount; ++f) prev[f] = now[f];
+}
+
+bool ProcStatParser::sample()
+{
+    const int n = readFile();
+    if (n <= 0) return false;
+
+    const qint64 now = monotonicNs();
+    m_intervalNs = m_timestampNs > 0 ? now - m_timestampNs : 0;
+    m_timestampNs = now;
+
+    for (CpuLoad &core : m_cores) core.online = false;
+
+    const char *p = m_buffer.constData();
+    const char *end = p + n;
+    quint64 values[FieldCount];
+
+    while (p + 3 < end && p[0] == 'c' && p[1] == 'p' && p[2] == 'u') {
+        p += 3;
+
+        // "cpu " is the aggregate, "cpuN " a single core
+        int core = -1;
+        if (*p >= '0' && *p <= '9') {
+            core = 0;
+            while (*p >= '0' && *p <= '9') core = core * 10 + (*p++ - '0');
+        }
+
+        // Older kernels have fewer columns; missing ones stay zero
+        for (int f = 0; f < FieldCount; ++f) {
+            values[f] = 0;
+            while (*p == ' ') ++p;
+            while (*p >= '0' && *p <= '9') values[f] = values[f] * 10 + (*p++ - '0');
+        }
+        // guest / guest_nice are already included in user / nice
+        while (p < end && *p != '\n') ++p;
+        ++p;
+
+        if (core < 0) {
+            computeLoad(values, m_prevTotal, m_hasPrev, m_total);
+        } else {
+            ensureCores(core + 1);
+            quint64 *prev = m_prevCores.data() + core * FieldCount;
+            computeLoad(values, prev, m_seen[core], m_cores[core]);
+            m_seen[core] = 1;
+        }
+    }
+
+    // A core without a line this time went offline; diff it afresh when it returns
+    for (int i = 0; i < m_cores.size(); ++i) {
+        if (!m_cores[i].online) {
+            m_cores[i] = CpuLoad();
+            m_seen[i] = 0;
+        }
+    }
+
+    const bool ready = m_hasPrev;
+    m_hasPrev = true;
+    return ready;
+}
@@ -0,0 +1,74 @@
+#ifndef PROCSTATPARSER_H
+#define PROCSTATPARSER_H
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+
+// Utilisation of one CPU (or the aggregate) over the last sample interval,
+// in percent of the jiffies that elapsed on that CPU.
+struct CpuLoad {
+    double usage = 0;   // Everything except idle + iowait
+    double user = 0;    // user + nice (guest time is already folded in by the kernel)
+    double system = 0;
+    double iowait = 0;
+    double irq = 0;     // irq + softirq
+    double steal = 0;
+    bool online = false;
+};
+
+// Allocation-free /proc/stat reader.
+//
+// The file is read with pread() into a buffer that is reused across samples
+// and only grows if the cpu lines ever outgrow it. Every `cpu` / `cpuN` line
+// is walked by hand; previous counters live in one flat array indexed by
+// core, so a steady-state sample does no heap allocation at all.
+// Each sample is stamped with CLOCK_MONOTONIC, so callers get the real
+// interval instead of assuming the timer period.
+class ProcStatParser
+{
+public:
+    explicit ProcStatParser(const QString &path = QString());
+    ~ProcStatParser();
+
+    // Re-target to another file (e.g. after the sysroot changes)
+    void setPath(const QString &path);
+
+    // Read and parse one sample. Returns true once two samples exist and
+    // total()/cores() hold utilisation for the interval between them.
+    bool sample();
+
+    const CpuLoad &total() const { return m_total; }
+    const QVector<CpuLoad> &cores() const { return m_cores; }
+
+    qint64 timestampNs() const { return m_timestampNs; }
+    qint64 intervalNs() const { return m_intervalNs; }
+
+private:
+    Q_DISABLE_COPY(ProcStatParser)
+
+    // Field order of a cpu line: user nice system idle iowait irq softirq steal guest guest_nice
+    enum Field { User, Nice, System, Idle, Iowait, Irq, Softirq, Steal, FieldCount };
+
+    int readFile();
+    void ensureCores(int count);
+    static void computeLoad(const quint64 *now, quint64 *prev, bool hadPrev, CpuLoad &out);
+
+    QByteArray m_path;
+    int m_fd = -1;
+    QByteArray m_buffer;
+
+    // Previous counters: aggregate first, then FieldCount slots per core
+    quint64 m_prevTotal[FieldCount] = {};
+    QVector<quint64> m_prevCores;
+    QVector<char> m_seen;          // Core had a line in the previous sample
+
+    CpuLoad m_total;
+    QVector<CpuLoad> m_cores;
+    bool m_hasPrev = false;
+    qint64 m_timestampNs = 0;
+    qint64 m_intervalNs = 0;
+};
+
+#endif // PROCSTATPARSER_H
@@ -0,0 +1,76 @@
+#include "PwmFanBackend.h"
+#include "SysRoot.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+
+bool PwmFanBackend::detect()
+{
+    m_hwmonPath.clear();
+    forgetSubmitted();
+
+    // Check for HWMON directory (PWM control) inside WMI device
+    const QString platformDir = SysRoot::path("/sys/devices/platform/");
+    const QStringList devices = QDir(platformDir).entryList(QStringList() << "asus*", QDir::Dirs);
+    for (const QString &device : devices) {
+        const QString basePath = platformDir + device;
+        const QStringList hwmons = QDir(basePath + "/hwmon").entryList(QStringList() << "hwmon*", QDir::Dirs);
+        if (hwmons.isEmpty()) continue;
+
+        const QString hwmonPath = basePath + "/hwmon/" + hwmons.first();
+        if (QFile::exists(hwmonPath + "/pwm1") && isControlPath(hwmonPath)) {
+            m_hwmonPath = hwmonPath;
+            qInfo() << "✓ Found WMI PWM control at:" << m_hwmonPath;
+            return true;
+        }
+    }
+    return false;
+}
+
+FanBackend::Probe PwmFanBackend::measure()
+{
+    // pwm1_enable is written back as it is: the fan stays in whatever mode
+    // the firmware had it in
+    Probe probe;
+    QElapsedTimer timer;
+    timer.start();
+
+    const QString enablePath = m_hwmonPath + "/pwm1_enable";
+    const int mode = readInt(enablePath);
+    if (mode >= 0 && writeNow(HardwareWriteQueue::Pwm, enablePath, QString::number(mode))) {
+        probe.faithful = readInt(enablePath) == mode;
+    }
+    probe.latencyUs = timer.nsecsElapsed() / 1000;
+    return probe;
+}
+
+void PwmFanBackend::apply(int percentage, QObject *context, HardwareWriteQueue::Callback onResult)
+{
+    const int duty = scale(percentage, 255);
+
+    // Manual mode first; the queue keeps it ahead of the duty cycle
+    for (const char *fan : { "1", "2" }) {
+        const QString pwm = m_hwmonPath + "/pwm" + fan;
+        submitIfChanged(HardwareWriteQueue::Pwm, pwm + "_enable", 1, context, onResult);
+        submitIfChanged(HardwareWriteQueue::Pwm, pwm, duty, context, onResult);
+    }
+}
+
+void PwmFanBackend::revertToAuto()
+{
+    // 2 = Auto
+    submitIfChanged(HardwareWriteQueue::Pwm, m_hwmonPath + "/pwm1_enable", 2, nullptr, HardwareWriteQueue::Callback());
+    submitIfChanged(HardwareWriteQueue::Pwm, m_hwmonPath + "/pwm2_enable", 2, nullptr, HardwareWriteQueue::Callback());
+}
+
+QString PwmFanBackend::describe(int percentage) const
+{
+    return QString("Manual (WMI): %1%").arg(percentage);
+}
+
+QString PwmFanBackend::readyMessage() const
+{
+    return QCoreApplication::translate("FanController", "Ready - Using WMI PWM Control");
+}
@@ -0,0 +1,29 @@
+#ifndef PWMFANBACKEND_H
+#define PWMFANBACKEND_H
+
+#include "FanBackend.h"
+
+// hwmon pwm1 (CPU) / pwm2 (GPU) under the asus-wmi device: pwmN_enable 1
+// is manual, 2 is auto; pwmN is the duty cycle, 0-255
+class PwmFanBackend : public FanBackend
+{
+public:
+    QString name() const override { return "hwmon-pwm"; }
+    int capabilities() const override { return DutyCycle | PerFan | Readback; }
+
+    void apply(int percentage, QObject *context = nullptr,
+               HardwareWriteQueue::Callback onResult = HardwareWriteQueue::Callback()) override;
+    void revertToAuto() override;
+    int readback() const override { return readInt(m_hwmonPath + "/pwm1"); }
+    QString describe(int percentage) const override;
+    QString readyMessage() const override;
+
+protected:
+    bool detect() override;
+    Probe measure() override;
+
+private:
+    QString m_hwmonPath;
+};
+
+#endif // PWMFANBACKEND_H
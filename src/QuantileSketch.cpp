@@ -0,0 +1,80 @@
+#include "QuantileSketch.h"
+
+#include <cmath>
+
+QuantileSketch::QuantileSketch()
+    : m_gamma((1 + kRelativeAccuracy) / (1 - kRelativeAccuracy))
+    , m_logGamma(std::log(m_gamma))
+{
+}
+
+int QuantileSketch::key(double value) const
+{
+    return static_cast<int>(std::ceil(std::log(value) / m_logGamma));
+}
+
+double QuantileSketch::value(int key) const
+{
+    // Midpoint of (gamma^(key-1), gamma^key] in relative terms
+    return 2 * std::pow(m_gamma, key) / (m_gamma + 1);
+}
+
+quint32 &QuantileSketch::bin(int key)
+{
+    if (m_bins.isEmpty()) {
+        m_offset = key;
+        m_bins.resize(1);
+    } else if (key < m_offset) {
+        m_bins.insert(0, m_offset - key, 0);
+        m_offset = key;
+    } else if (key >= m_offset + m_bins.size()) {
+        m_bins.resize(key - m_offset + 1);
+    }
+    return m_bins[key - m_offset];
+}
+
+void QuantileSketch::add(double value)
+{
+    ++m_count;
+    if (!(value > kMinValue)) {
+        ++m_zeroCount;
+        return;
+    }
+    ++bin(key(value));
+}
+
+void QuantileSketch::remove(double value)
+{
+    if (m_count == 0) return;
+    --m_count;
+    if (!(value > kMinValue)) {
+        if (m_zeroCount > 0) --m_zeroCount;
+        return;
+    }
+
+    const int index = key(value) - m_offset;
+    if (index >= 0 && index < m_bins.size() && m_bins[index] > 0) --m_bins[index];
+}
+
+void QuantileSketch::clear()
+{
+    m_bins.clear();
+    m_offset = 0;
+    m_zeroCount = 0;
+    m_count = 0;
+}
+
+double QuantileSketch::quantile(double q) const
+{
+    if (m_count == 0) return 0;
+
+    const quint64 rank = static_cast<quint64>(qBound(0.0, q, 1.0) * (m_count - 1));
+    quint64 seen = m_zeroCount;
+    if (rank < seen) return 0;
+
+    for (int i = 0; i < m_bins.size(); ++i) {
+        seen += m_bins[i];
+        if (rank < seen) return value(m_offset + i);
+    }
+    return value(m_offset + m_bins.size() - 1);
+}
@@ -0,0 +1,48 @@
+#ifndef QUANTILESKETCH_H
+#define QUANTILESKETCH_H
+
+#include <QVector>
+#include <QtGlobal>
+
+// Streaming quantile sketch with bounded relative error (DDSketch, Masson et
+// al. 2019). A value v > 0 is counted in bucket ceil(log_gamma(v)) with
+// gamma = (1 + a) / (1 - a), so any quantile it reports is within a of the
+// true value (a = 1 % here). Values at or below kMinValue, negatives
+// included, share one zero bucket.
+//
+// Buckets are plain counts, so remove() is exact: that is what lets
+// WindowedStats slide the window, which t-digest or KLL cannot do.
+// Buckets are allocated over the range of values seen so far and kept, so
+// add() and remove() are O(1); quantile() walks the buckets.
+class QuantileSketch
+{
+public:
+    static constexpr double kRelativeAccuracy = 0.01;
+    static constexpr double kMinValue = 1e-6;
+
+    QuantileSketch();
+
+    // Values must be finite
+    void add(double value);
+    void remove(double value);   // Must have been added before
+    void clear();
+
+    quint64 count() const { return m_count; }
+
+    // q in [0, 1]; 0 when empty
+    double quantile(double q) const;
+
+private:
+    int key(double value) const;
+    double value(int key) const;
+    quint32 &bin(int key);     // Grows m_bins to cover key
+
+    double m_gamma;
+    double m_logGamma;
+    QVector<quint32> m_bins;
+    int m_offset = 0;           // Key of m_bins[0]
+    quint64 m_zeroCount = 0;
+    quint64 m_count = 0;
+};
+
+#endif // QUANTILESKETCH_H
@@ -0,0 +1,278 @@
+#include "SamplingScheduler.h"
+#include <QDebug>
+#include <QVector>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+
+// Stats are published once per window
+static const qint64 kStatsWindowNs = 10LL * 1000 * 1000 * 1000;
+
+SamplingScheduler &SamplingScheduler::instance()
+{
+    static SamplingScheduler scheduler;
+    return scheduler;
+}
+
+SamplingScheduler::SamplingScheduler(QObject *parent) : QObject(parent)
+{
+    m_epochNs = monotonicNs();
+    m_windowStartNs = m_epochNs;
+
+    m_epollFd = epoll_create1(EPOLL_CLOEXEC);
+    m_timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    m_wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    if (m_epollFd < 0 || m_timerFd < 0 || m_wakeFd < 0) {
+        qCritical() << "SamplingScheduler: failed to create epoll/timerfd/eventfd, errno" << errno;
+        return;
+    }
+
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = m_timerFd;
+    epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_timerFd, &ev);
+    ev.data.fd = m_wakeFd;
+    epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_wakeFd, &ev);
+
+    m_running = true;
+    m_thread = QThread::create([this]() { run(); });
+    m_thread->setObjectName("SamplingScheduler");
+    m_thread->start();
+}
+
+SamplingScheduler::~SamplingScheduler()
+{
+    m_running = false;
+    if (m_thread) {
+        wake();
+        m_thread->wait();
+        delete m_thread;
+    }
+    if (m_wakeFd >= 0) ::close(m_wakeFd);
+    if (m_timerFd >= 0) ::close(m_timerFd);
+    if (m_epollFd >= 0) ::close(m_epollFd);
+}
+
+qint64 SamplingScheduler::monotonicNs()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<qint64>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+int SamplingScheduler::add(QObject *context, int periodMs, int phaseMs,
+                           std::function<void()> fn, bool enabled)
+{
+    if (!context || periodMs <= 0) return -1;
+
+    int id;
+    {
+        QMutexLocker locker(&m_mutex);
+        id = m_nextId++;
+
+        Task task;
+        task.context = context;
+        task.periodNs = periodMs * 1000000LL;
+        task.phaseNs = (phaseMs % periodMs) * 1000000LL;
+        task.enabled = enabled;
+        task.fn = std::move(fn);
+        task.pending = std::make_shared<std::atomic<bool>>(false);
+        task.nextDueNs = alignedDeadline(task, monotonicNs());
+        m_tasks.insert(id, task);
+    }
+
+    // Drop the task with its owner. The direct connection runs inside
+    // ~QObject, before Qt discards the object's pending queued calls.
+    connect(context, &QObject::destroyed, this, [this, id]() { remove(id); },
+            Qt::DirectConnection);
+
+    wake();
+    return id;
+}
+
+void SamplingScheduler::setEnabled(int id, bool enabled)
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        auto it = m_tasks.find(id);
+        if (it == m_tasks.end() || it->enabled == enabled) return;
+
+        it->enabled = enabled;
+        if (enabled) {
+            // Re-join the shared grid rather than starting a private cadence
+            it->nextDueNs = alignedDeadline(*it, monotonicNs());
+        }
+    }
+    wake();
+}
+
+void SamplingScheduler::remove(int id)
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        if (!m_tasks.remove(id)) return;
+    }
+    wake();
+}
+
+void SamplingScheduler::setCoalesceWindow(int ms)
+{
+    QMutexLocker locker(&m_mutex);
+    m_coalesceNs = qMax(0, ms) * 1000000LL;
+}
+
+int SamplingScheduler::taskCount() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_tasks.size();
+}
+
+qint64 SamplingScheduler::alignedDeadline(const Task &task, qint64 afterNs) const
+{
+    // Grid points are epoch + phase + k * period; return the first one > afterNs
+    qint64 origin = m_epochNs + task.phaseNs;
+    if (afterNs < origin) return origin;
+    qint64 k = (afterNs - origin) / task.periodNs + 1;
+    return origin + k * task.periodNs;
+}
+
+void SamplingScheduler::wake()
+{
+    if (m_wakeFd < 0) return;
+    quint64 one = 1;
+    ssize_t r = ::write(m_wakeFd, &one, sizeof(one));
+    Q_UNUSED(r);
+}
+
+void SamplingScheduler::armLocked()
+{
+    qint64 earliest = -1;
+    for (const Task &task : m_tasks) {
+        if (!task.enabled) continue;
+        if (earliest < 0 || task.nextDueNs < earliest) earliest = task.nextDueNs;
+    }
+
+    itimerspec spec{};
+    if (earliest >= 0) {
+        // Absolute deadline; one already in the past fires immediately
+        spec.it_value.tv_sec = earliest / 1000000000LL;
+        spec.it_value.tv_nsec = earliest % 1000000000LL;
+        if (spec.it_value.tv_sec == 0 && spec.it_value.tv_nsec == 0) spec.it_value.tv_nsec = 1;
+    }
+    timerfd_settime(m_timerFd, TFD_TIMER_ABSTIME, &spec, nullptr);
+}
+
+void SamplingScheduler::run()
+{
+    while (m_running) {
+        {
+            QMutexLocker locker(&m_mutex);
+            armLocked();
+        }
+
+        epoll_event events[2];
+        int n = epoll_wait(m_epollFd, events, 2, -1);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            qWarning() << "SamplingScheduler: epoll_wait failed, errno" << errno;
+            break;
+        }
+
+        bool timerFired = false;
+        for (int i = 0; i < n; ++i) {
+            quint64 value;
+            if (events[i].data.fd == m_timerFd) {
+                timerFired = (::read(m_timerFd, &value, sizeof(value)) == sizeof(value)) || timerFired;
+            } else if (events[i].data.fd == m_wakeFd) {
+                ssize_t r = ::read(m_wakeFd, &value, sizeof(value));
+                Q_UNUSED(r);
+            }
+        }
+
+        if (!m_running) break;
+        if (timerFired) dispatchDue(monotonicNs());
+    }
+}
+
+void SamplingScheduler::dispatchDue(qint64 nowNs)
+{
+    struct Call {
+        std::function<void()> fn;
+        std::shared_ptr<std::atomic<bool>> pending;
+    };
+    struct Batch {
+        QObject *context;
+        QVector<Call> calls;
+    };
+    QVector<Batch> batches;
+
+    qint64 earliestDue = -1;
+
+    // Post while holding the lock: remove() (and thus a context's
+    // destruction) waits until no call to that context is in flight.
+    QMutexLocker locker(&m_mutex);
+    const qint64 horizon = nowNs + m_coalesceNs;
+
+    for (Task &task : m_tasks) {
+        if (!task.enabled || task.nextDueNs > horizon) continue;
+
+        if (task.nextDueNs <= nowNs && (earliestDue < 0 || task.nextDueNs < earliestDue)) {
+            earliestDue = task.nextDueNs;
+        }
+        task.nextDueNs = alignedDeadline(task, qMax(nowNs, task.nextDueNs));
+
+        // Previous call still queued (slow consumer): skip this tick
+        if (task.pending->exchange(true)) continue;
+
+        Batch *batch = nullptr;
+        for (Batch &b : batches) {
+            if (b.context == task.context) { batch = &b; break; }
+        }
+        if (!batch) {
+            batches.append(Batch{task.context, {}});
+            batch = &batches.last();
+        }
+        batch->calls.append(Call{task.fn, task.pending});
+    }
+
+    for (const Batch &batch : batches) {
+        QVector<Call> calls = batch.calls;
+        QMetaObject::invokeMethod(batch.context, [calls]() {
+            for (const Call &call : calls) {
+                call.pending->store(false);
+                call.fn();
+            }
+        }, Qt::QueuedConnection);
+    }
+    locker.unlock();
+
+    accountWakeup(nowNs, earliestDue >= 0 ? nowNs - earliestDue : 0);
+}
+
+void SamplingScheduler::accountWakeup(qint64 nowNs, qint64 jitterNs)
+{
+    m_windowWakeups++;
+    m_windowJitterSumNs += jitterNs;
+    m_windowJitterSamples++;
+    if (jitterNs > m_windowJitterMaxNs) m_windowJitterMaxNs = jitterNs;
+
+    qint64 elapsed = nowNs - m_windowStartNs;
+    if (elapsed < kStatsWindowNs) return;
+
+    m_wakeupsPerSecond = m_windowWakeups * 1e9 / elapsed;
+    m_meanJitterMs = m_windowJitterSamples ? (m_windowJitterSumNs / 1e6) / m_windowJitterSamples : 0.0;
+    m_maxJitterMs = m_windowJitterMaxNs / 1e6;
+
+    m_windowStartNs = nowNs;
+    m_windowWakeups = 0;
+    m_windowJitterSumNs = 0;
+    m_windowJitterMaxNs = 0;
+    m_windowJitterSamples = 0;
+
+    emit statsChanged();
+}
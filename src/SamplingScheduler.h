@@ -0,0 +1,100 @@
+#ifndef SAMPLINGSCHEDULER_H
+#define SAMPLINGSCHEDULER_H
+
+#include <QObject>
+#include <QHash>
+#include <QMutex>
+#include <QThread>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+// Central sampling scheduler: one epoll loop + timerfd on its own thread
+// replaces the independent QTimers each controller used to run.
+//
+// Every task registers a period and a phase on a shared time grid, so tasks
+// with compatible periods fire on the same tick. Deadlines that fall inside
+// the coalescing window are served by one batched pass, and each context
+// object gets at most one queued call per pass (its thread wakes once).
+//
+// The scheduler reports its own wakeups per second and timer jitter so the
+// idle power cost can be checked.
+class SamplingScheduler : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(double wakeupsPerSecond READ wakeupsPerSecond NOTIFY statsChanged)
+    Q_PROPERTY(double meanJitterMs READ meanJitterMs NOTIFY statsChanged)
+    Q_PROPERTY(double maxJitterMs READ maxJitterMs NOTIFY statsChanged)
+    Q_PROPERTY(int taskCount READ taskCount NOTIFY statsChanged)
+
+public:
+    static SamplingScheduler &instance();
+    ~SamplingScheduler() override;
+
+    // Register a periodic task. `fn` runs (queued) on `context`'s thread and
+    // the task is removed automatically when `context` is destroyed.
+    // Returns a task id for setEnabled()/remove().
+    int add(QObject *context, int periodMs, int phaseMs, std::function<void()> fn,
+            bool enabled = true);
+    void setEnabled(int id, bool enabled);
+    void remove(int id);
+
+    // Deadlines within this window of the earliest one share a wakeup
+    void setCoalesceWindow(int ms);
+
+    double wakeupsPerSecond() const { return m_wakeupsPerSecond.load(); }
+    double meanJitterMs() const { return m_meanJitterMs.load(); }
+    double maxJitterMs() const { return m_maxJitterMs.load(); }
+    int taskCount() const;
+
+signals:
+    void statsChanged();
+
+private:
+    explicit SamplingScheduler(QObject *parent = nullptr);
+    Q_DISABLE_COPY(SamplingScheduler)
+
+    struct Task {
+        QObject *context = nullptr;
+        qint64 periodNs = 0;
+        qint64 phaseNs = 0;
+        qint64 nextDueNs = 0;
+        bool enabled = true;
+        std::function<void()> fn;
+        // Set while a queued call is pending; a slow consumer never piles up calls
+        std::shared_ptr<std::atomic<bool>> pending;
+    };
+
+    void run();
+    void wake();
+    void armLocked();
+    void dispatchDue(qint64 nowNs);
+    qint64 alignedDeadline(const Task &task, qint64 afterNs) const;
+    void accountWakeup(qint64 nowNs, qint64 jitterNs);
+
+    static qint64 monotonicNs();
+
+    mutable QMutex m_mutex;
+    QHash<int, Task> m_tasks;
+    int m_nextId = 1;
+    qint64 m_epochNs = 0;          // Common grid origin for all phases
+    qint64 m_coalesceNs = 20 * 1000000LL;
+
+    int m_epollFd = -1;
+    int m_timerFd = -1;
+    int m_wakeFd = -1;
+    QThread *m_thread = nullptr;
+    std::atomic<bool> m_running{false};
+
+    // Stats over a rolling window (scheduler thread only, published atomically)
+    qint64 m_windowStartNs = 0;
+    int m_windowWakeups = 0;
+    qint64 m_windowJitterSumNs = 0;
+    qint64 m_windowJitterMaxNs = 0;
+    int m_windowJitterSamples = 0;
+    std::atomic<double> m_wakeupsPerSecond{0.0};
+    std::atomic<double> m_meanJitterMs{0.0};
+    std::atomic<double> m_maxJitterMs{0.0};
+};
+
+#endif // SAMPLINGSCHEDULER_H
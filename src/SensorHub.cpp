@@ -0,0 +1,97 @@
+#include "SensorHub.h"
+#include "SensorSampler.h"
+#include "SamplingScheduler.h"
+#include "NvidiaSmiStream.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QMutexLocker>
+#include <QThread>
+#include <algorithm>
+
+SensorHub *SensorHub::s_current = nullptr;
+
+SensorHub::SensorHub(QObject *parent)
+    : QObject(parent)
+    , m_sampler(new SensorSampler())
+    , m_thread(new QThread(this))
+{
+    m_batteryDir = m_sampler->batteryDir();
+
+    // First pass before the thread starts, so controllers never see an empty snapshot
+    runPass();
+
+    m_sampler->moveToThread(m_thread);
+    m_thread->setObjectName("SensorHub");
+    m_thread->start();
+
+    // One 500 ms pass serves every controller; the task runs on the sampling thread
+    m_sampleTask = SamplingScheduler::instance().add(m_sampler, 500, 0, [this]() { runPass(); });
+}
+
+SensorHub::~SensorHub()
+{
+    SamplingScheduler::instance().remove(m_sampleTask);
+    m_thread->quit();
+    m_thread->wait();
+
+    // Let the shared nvidia-smi stream stop if we were its last user
+    if (m_sampler->usesNvidiaStream()) {
+        NvidiaSmiStream::instance().release();
+    }
+    delete m_sampler;
+
+    if (s_current == this) s_current = nullptr;
+}
+
+SensorHub *SensorHub::current()
+{
+    if (!s_current) {
+        // Controllers created without main.cpp (e.g. qmlscene) still share one hub
+        s_current = new SensorHub(QCoreApplication::instance());
+    }
+    return s_current;
+}
+
+void SensorHub::setCurrent(SensorHub *hub)
+{
+    s_current = hub;
+}
+
+void SensorHub::rediscover()
+{
+    QMetaObject::invokeMethod(m_sampler, [this]() {
+        m_sampler->discover();
+        runPass();
+    }, Qt::QueuedConnection);
+}
+
+void SensorHub::copyCores(QVector<CpuLoad> *out) const
+{
+    QMutexLocker locker(&m_coresMutex);
+    if (out->size() != m_cores.size()) out->resize(m_cores.size());
+    std::copy(m_cores.constBegin(), m_cores.constEnd(), out->begin());
+}
+
+void SensorHub::runPass()
+{
+    SensorSnapshot snapshot;
+    m_sampler->sample(&snapshot);
+    m_published.store(snapshot);
+
+    const QVector<CpuLoad> &cores = m_sampler->cores();
+    {
+        QMutexLocker locker(&m_coresMutex);
+        if (m_cores.size() != cores.size()) m_cores.resize(cores.size());
+        std::copy(cores.constBegin(), cores.constEnd(), m_cores.begin());
+    }
+
+    // At most one notification in flight: a busy GUI thread skips passes
+    // instead of queueing them up
+    if (!m_notifyPending.exchange(true)) {
+        QMetaObject::invokeMethod(this, [this]() {
+            m_notifyPending = false;
+            emit snapshotUpdated();
+        }, Qt::QueuedConnection);
+    }
+}
@@ -0,0 +1,122 @@
+#ifndef SENSORHUB_H
+#define SENSORHUB_H
+
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include <QMutex>
+#include <atomic>
+#include "Seqlock.h"
+#include "ProcStatParser.h"
+
+class QThread;
+class SensorSampler;
+
+// One sampling pass over every hardware sensor and fast system counter,
+// taken on the sampling thread. Fixed layout (no Qt containers), so it can
+// be published through a Seqlock and copied by readers without allocating.
+// Channels that are missing read 0.
+struct SensorSnapshot {
+    enum BatteryState { BatteryUnknown, BatteryCharging, BatteryDischarging, BatteryNotCharging, BatteryFull };
+
+    // Thermals and fans (refreshed every other pass, i.e. once per second)
+    int cpuTemp = 0;        // °C
+    int gpuTemp = 0;        // °C
+    int cpuFanRpm = 0;
+    int gpuFanRpm = 0;
+    bool hasCpuTemp = false;
+    bool hasGpuTemp = false;
+    int thermalPolicy = -1; // asus-wmi throttle_thermal_policy, -1 = not present
+
+    // Load
+    double cpuUsage = 0;    // Percent
+    double cpuFreq = 0;     // MHz, cpu0
+    double memoryUsage = 0; // Percent
+    double gpuFreq = 0;     // MHz
+    double gpuUsage = 0;    // Percent
+
+    // Battery
+    int batteryPercent = 0;
+    BatteryState batteryState = BatteryUnknown;
+
+    int sysfsSyscallsSaved = 0; // Versus the QFile path, during this pass
+    quint64 sequence = 0;       // Increments once per sampling pass
+    qint64 timestampMs = 0;     // Monotonic, when the pass ran
+};
+
+// Process-wide owner of sensor discovery and sampling.
+//
+// Previously FanController and FanCurveController each located the CPU
+// temperature their own way (coretemp by name vs. a guessed thermal_zone0 /
+// hwmonN) and polled it on their own timers, so the two could disagree and
+// every reading was taken twice. The hub discovers each channel once by
+// driver name, samples all of them once per period and publishes the result
+// as a value snapshot; controllers only ever read the snapshot.
+//
+// Sampling runs on a dedicated thread (SensorSampler), so a stalled sysfs
+// attribute (asus-wmi can take tens of ms) never blocks the UI. Each pass is
+// published through a Seqlock: the GUI-side getters copy it lock-free, and
+// the GUI thread receives one queued snapshotUpdated() per pass.
+//
+// main.cpp owns the hub and installs it with setCurrent() before QML
+// instantiates any controller; controllers pick it up from current().
+class SensorHub : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(int cpuTemp READ cpuTemp NOTIFY snapshotUpdated)
+    Q_PROPERTY(int gpuTemp READ gpuTemp NOTIFY snapshotUpdated)
+    Q_PROPERTY(int cpuFanRpm READ cpuFanRpm NOTIFY snapshotUpdated)
+    Q_PROPERTY(int gpuFanRpm READ gpuFanRpm NOTIFY snapshotUpdated)
+
+public:
+    explicit SensorHub(QObject *parent = nullptr);
+    ~SensorHub() override;
+
+    // The hub installed by main.cpp (created on first use if there is none)
+    static SensorHub *current();
+    static void setCurrent(SensorHub *hub);
+
+    // Latest pass; safe from any thread, never blocks the sampler
+    SensorSnapshot snapshot() const { return m_published.load(); }
+
+    int cpuTemp() const { return snapshot().cpuTemp; }
+    int gpuTemp() const { return snapshot().gpuTemp; }
+    int cpuFanRpm() const { return snapshot().cpuFanRpm; }
+    int gpuFanRpm() const { return snapshot().gpuFanRpm; }
+
+    // Per-core load of the latest pass, copied into `out` (resized only
+    // when the CPU count changes)
+    void copyCores(QVector<CpuLoad> *out) const;
+
+    // power_supply directory of the main battery (BAT1, else BAT0)
+    QString batteryDir() const { return m_batteryDir; }
+
+    // Re-run discovery (driver reload, diagnostics) and sample immediately
+    Q_INVOKABLE void rediscover();
+
+signals:
+    void snapshotUpdated();
+
+private:
+    // Runs on the sampling thread
+    void runPass();
+
+    SensorSampler *m_sampler;
+    QThread *m_thread;
+    int m_sampleTask = -1;
+    QString m_batteryDir;
+
+    Seqlock<SensorSnapshot> m_published;
+
+    // Per-core loads are variable length; double-buffered behind a mutex that
+    // is held only for the copy
+    mutable QMutex m_coresMutex;
+    QVector<CpuLoad> m_cores;
+
+    // Set while a snapshotUpdated() is queued to the GUI thread
+    std::atomic<bool> m_notifyPending{false};
+
+    static SensorHub *s_current;
+};
+
+#endif // SENSORHUB_H
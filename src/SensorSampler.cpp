@@ -0,0 +1,267 @@
+#include "SensorSampler.h"
+#include "SysfsReader.h"
+#include "SysRoot.h"
+#include "NvidiaSmiStream.h"
+#include "GpuSampler.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static qint64 monotonicMs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<qint64>(ts.tv_sec) * 1000 + ts.tv_nsec / 1000000;
+}
+
+static QString readName(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) return QString();
+    return QString::fromLatin1(file.readAll().trimmed());
+}
+
+static int attachIfExists(const QString &path)
+{
+    return QFile::exists(path) ? SysfsReader::instance().attach(path) : -1;
+}
+
+// Value of a "Key:   1234 kB" line in a /proc/meminfo buffer, or -1
+static long long meminfoField(const char *buf, const char *key)
+{
+    const char *p = strstr(buf, key);
+    if (!p) return -1;
+    return strtoll(p + strlen(key), nullptr, 10);
+}
+
+SensorSampler::SensorSampler(QObject *parent)
+    : QObject(parent)
+    , m_procStat(SysRoot::path("/proc/stat"))
+{
+    discover();
+}
+
+void SensorSampler::discover()
+{
+    SysfsReader &reader = SysfsReader::instance();
+
+    m_cpuTempHandle = m_cpuFanHandle = m_gpuFanHandle = m_gpuTempHandle = m_thermalPolicyHandle = -1;
+    m_cpuTempSource.clear();
+
+    // hwmon devices by driver name; the first match of each kind wins
+    QString cpuHwmon, fanHwmon, gpuHwmon;
+    const QString hwmonRoot = SysRoot::path("/sys/class/hwmon/");
+    const QStringList hwmons = QDir(hwmonRoot).entryList(QStringList() << "hwmon*",
+                                                         QDir::Dirs | QDir::System | QDir::NoDotAndDotDot,
+                                                         QDir::Name);
+    for (const QString &entry : hwmons) {
+        const QString dir = hwmonRoot + entry;
+        const QString name = readName(dir + "/name");
+
+        if ((name == "coretemp" || name == "k10temp" || name == "zenpower") && cpuHwmon.isEmpty()) {
+            cpuHwmon = dir;
+            m_cpuTempSource = name;
+        } else if (name == "asus" && fanHwmon.isEmpty()) {
+            fanHwmon = dir;
+        } else if ((name == "amdgpu" || name == "nouveau" || name.contains("nvidia")) && gpuHwmon.isEmpty()) {
+            gpuHwmon = dir;
+        }
+    }
+
+    // coretemp temp1 is the package sensor, k10temp temp1 is Tctl
+    if (!cpuHwmon.isEmpty()) {
+        m_cpuTempHandle = attachIfExists(cpuHwmon + "/temp1_input");
+    }
+
+    // No CPU hwmon driver loaded: use the package thermal zone, else the first zone
+    if (m_cpuTempHandle < 0) {
+        const QString thermalRoot = SysRoot::path("/sys/class/thermal/");
+        const QStringList zones = QDir(thermalRoot).entryList(QStringList() << "thermal_zone*",
+                                                              QDir::Dirs | QDir::System | QDir::NoDotAndDotDot,
+                                                              QDir::Name);
+        QString zoneDir;
+        for (const QString &zone : zones) {
+            if (readName(thermalRoot + zone + "/type") == "x86_pkg_temp") {
+                zoneDir = thermalRoot + zone;
+                break;
+            }
+        }
+        if (zoneDir.isEmpty() && !zones.isEmpty()) zoneDir = thermalRoot + zones.first();
+        if (!zoneDir.isEmpty()) {
+            m_cpuTempHandle = attachIfExists(zoneDir + "/temp");
+            m_cpuTempSource = zoneDir.section('/', -1);
+        }
+    }
+
+    if (!fanHwmon.isEmpty()) {
+        m_cpuFanHandle = attachIfExists(fanHwmon + "/fan1_input");
+        m_gpuFanHandle = attachIfExists(fanHwmon + "/fan2_input");
+    }
+    if (!gpuHwmon.isEmpty()) {
+        m_gpuTempHandle = attachIfExists(gpuHwmon + "/temp1_input");
+    }
+
+    // Active thermal policy, on the asus-nb-wmi / asus-wmi platform device
+    const QString platformRoot = SysRoot::path("/sys/devices/platform/");
+    const QStringList platforms = QDir(platformRoot).entryList(QStringList() << "asus*", QDir::Dirs, QDir::Name);
+    for (const QString &device : platforms) {
+        m_thermalPolicyHandle = attachIfExists(platformRoot + device + "/throttle_thermal_policy");
+        if (m_thermalPolicyHandle >= 0) break;
+    }
+
+    // Fast system counters
+    m_cpuFreqHandle = reader.attach(SysRoot::path("/sys/devices/system/cpu/cpu0/cpufreq/scaling_cur_freq"));
+    m_memInfoHandle = reader.attach(SysRoot::path("/proc/meminfo"));
+
+    // Most TUF models expose BAT1; some (and the fake tree) only BAT0
+    m_batteryDir = SysRoot::path("/sys/class/power_supply/BAT1");
+    if (!QFile::exists(m_batteryDir)) {
+        m_batteryDir = SysRoot::path("/sys/class/power_supply/BAT0");
+    }
+    m_batCapacityHandle = reader.attach(m_batteryDir + "/capacity");
+    m_batStatusHandle = reader.attach(m_batteryDir + "/status");
+
+    qInfo() << "SensorHub: CPU temp" << (m_cpuTempHandle >= 0 ? m_cpuTempSource : QString("none"))
+            << "| fans" << (fanHwmon.isEmpty() ? QString("none") : fanHwmon)
+            << "| GPU hwmon" << (gpuHwmon.isEmpty() ? QString("none") : gpuHwmon);
+}
+
+void SensorSampler::sample(SensorSnapshot *out)
+{
+    SensorSnapshot next = m_last;
+    next.sequence = m_last.sequence + 1;
+    next.timestampMs = monotonicMs();
+
+    // Temperatures and fans change slowly and go through asus-wmi: every other pass
+    if (next.sequence % 2 == 1) {
+        readThermals(&next);
+    }
+
+    long long khz;
+    if (SysfsReader::instance().tryReadInt(m_cpuFreqHandle, &khz)) {
+        next.cpuFreq = khz / 1000.0;
+    }
+
+    // Needs two samples before utilisation is meaningful
+    if (m_procStat.sample()) {
+        next.cpuUsage = m_procStat.total().usage;
+    }
+
+    readMemoryUsage(&next);
+    readGpuLoad(&next);
+    readBattery(&next);
+
+    next.sysfsSyscallsSaved = static_cast<int>(SysfsReader::instance().takeTickSavings());
+
+    m_last = next;
+    *out = next;
+}
+
+void SensorSampler::readThermals(SensorSnapshot *s)
+{
+    SysfsReader &reader = SysfsReader::instance();
+
+    long long raw;
+    s->hasCpuTemp = reader.tryReadInt(m_cpuTempHandle, &raw);
+    if (s->hasCpuTemp) {
+        // hwmon and thermal zones report millidegrees (65000 = 65°C)
+        s->cpuTemp = static_cast<int>(raw > 1000 ? raw / 1000 : raw);
+    }
+
+    s->cpuFanRpm = static_cast<int>(reader.readInt(m_cpuFanHandle, 0));
+    s->gpuFanRpm = static_cast<int>(reader.readInt(m_gpuFanHandle, 0));
+    s->thermalPolicy = static_cast<int>(reader.readInt(m_thermalPolicyHandle, -1));
+
+    // A transient miss (stream restarting) keeps the last good value
+    const int gpuTemp = readGpuTemp();
+    s->hasGpuTemp = gpuTemp > 0;
+    if (s->hasGpuTemp) s->gpuTemp = gpuTemp;
+}
+
+int SensorSampler::readGpuTemp()
+{
+    long long t;
+    if (SysfsReader::instance().tryReadInt(m_gpuTempHandle, &t) && t > 0) {
+        return static_cast<int>(t / 1000);
+    }
+
+    // amdgpu / Intel card found by PCI vendor (hwmon name scan can miss it)
+    int gpuTemp = GpuSampler::instance().temperature();
+    if (gpuTemp > 0) return gpuTemp;
+
+    // Last resort: the shared nvidia-smi stream (joined on first need; the
+    // stream's QProcess belongs to the GUI thread, so start it from there)
+    NvidiaSmiStream &stream = NvidiaSmiStream::instance();
+    if (!m_usingNvidiaStream && stream.isAvailable()) {
+        m_usingNvidiaStream = true;
+        QMetaObject::invokeMethod(&stream, [&stream]() { stream.acquire(); }, Qt::QueuedConnection);
+    }
+    const NvidiaSmiStream::Sample sample = stream.sample();
+    if (stream.isFresh(sample) && sample.hasTemperature) {
+        return sample.temperature;
+    }
+    return 0;
+}
+
+void SensorSampler::readMemoryUsage(SensorSnapshot *s)
+{
+    // MemTotal and MemAvailable are the first and third lines
+    char buf[512];
+    if (SysfsReader::instance().read(m_memInfoHandle, buf, sizeof(buf)) <= 0) return;
+
+    const long long total = meminfoField(buf, "MemTotal:");
+    const long long available = meminfoField(buf, "MemAvailable:");
+    if (total > 0 && available >= 0) {
+        s->memoryUsage = (static_cast<double>(total - available) / total) * 100.0;
+    } else {
+        s->memoryUsage = 0;
+    }
+}
+
+void SensorSampler::readGpuLoad(SensorSnapshot *s)
+{
+    // NVIDIA: latest line from the nvidia-smi stream - no process spawn per tick
+    const NvidiaSmiStream &stream = NvidiaSmiStream::instance();
+    const NvidiaSmiStream::Sample sample = stream.sample();
+    if (stream.isFresh(sample)) {
+        if (sample.hasClock) s->gpuFreq = sample.clockMhz;
+        if (sample.hasUtilization) s->gpuUsage = sample.utilization;
+        return;
+    }
+
+    // AMD / Intel: straight from sysfs
+    double clock, usage;
+    if (GpuSampler::instance().sample(&clock, &usage)) {
+        s->gpuFreq = clock;
+        s->gpuUsage = usage;
+    }
+}
+
+void SensorSampler::readBattery(SensorSnapshot *s)
+{
+    SysfsReader &reader = SysfsReader::instance();
+
+    long long capacity;
+    if (reader.tryReadInt(m_batCapacityHandle, &capacity)) {
+        s->batteryPercent = static_cast<int>(capacity);
+    }
+
+    char status[32];
+    if (reader.readText(m_batStatusHandle, status, sizeof(status)) >= 0) {
+        if (strcmp(status, "Charging") == 0) {
+            s->batteryState = SensorSnapshot::BatteryCharging;
+        } else if (strcmp(status, "Discharging") == 0) {
+            s->batteryState = SensorSnapshot::BatteryDischarging;
+        } else if (strcmp(status, "Not charging") == 0) {
+            s->batteryState = SensorSnapshot::BatteryNotCharging;
+        } else if (strcmp(status, "Full") == 0) {
+            s->batteryState = SensorSnapshot::BatteryFull;
+        } else {
+            s->batteryState = SensorSnapshot::BatteryUnknown;
+        }
+    }
+}
@@ -0,0 +1,65 @@
+#ifndef SENSORSAMPLER_H
+#define SENSORSAMPLER_H
+
+#include <QObject>
+#include <QString>
+#include "SensorHub.h"
+#include "ProcStatParser.h"
+
+// The reading half of SensorHub. Lives on the hub's sampling thread and
+// does every blocking read there (hwmon, thermal zones, /proc, GPU, battery).
+//
+//   CPU temp   hwmon coretemp / k10temp / zenpower temp1_input,
+//              else the x86_pkg_temp thermal zone, else thermal_zone0
+//   Fan RPM    asus hwmon fan1_input (CPU) / fan2_input (GPU)
+//   GPU temp   hwmon amdgpu / nouveau / nvidia, else GpuSampler,
+//              else the shared nvidia-smi stream
+//   GPU load   nvidia-smi stream while fresh, else GpuSampler
+//   Policy     asus-wmi platform device throttle_thermal_policy
+//
+// Not thread-safe on its own: discover() and sample() must run on one
+// thread at a time (the hub only calls them from the sampling thread, or
+// before that thread starts).
+class SensorSampler : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit SensorSampler(QObject *parent = nullptr);
+
+    void discover();
+
+    // Take one pass; values that fail to read keep their previous reading
+    void sample(SensorSnapshot *out);
+
+    const QVector<CpuLoad> &cores() const { return m_procStat.cores(); }
+    QString batteryDir() const { return m_batteryDir; }
+    bool usesNvidiaStream() const { return m_usingNvidiaStream; }
+
+private:
+    void readThermals(SensorSnapshot *s);
+    int readGpuTemp();
+    void readMemoryUsage(SensorSnapshot *s);
+    void readGpuLoad(SensorSnapshot *s);
+    void readBattery(SensorSnapshot *s);
+
+    SensorSnapshot m_last;
+    ProcStatParser m_procStat;
+    QString m_cpuTempSource;    // For the discovery log only
+    QString m_batteryDir;
+
+    // SysfsReader handles (-1 = not present)
+    int m_cpuTempHandle = -1;
+    int m_cpuFanHandle = -1;
+    int m_gpuFanHandle = -1;
+    int m_gpuTempHandle = -1;
+    int m_thermalPolicyHandle = -1;
+    int m_cpuFreqHandle = -1;
+    int m_memInfoHandle = -1;
+    int m_batCapacityHandle = -1;
+    int m_batStatusHandle = -1;
+
+    bool m_usingNvidiaStream = false;  // Holding a NvidiaSmiStream reference
+};
+
+#endif // SENSORSAMPLER_H
@@ -0,0 +1,72 @@
+#ifndef SEQLOCK_H
+#define SEQLOCK_H
+
+#include <QtGlobal>
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+
+// Single-writer, many-reader publication of a small fixed-layout value.
+//
+// The writer bumps the sequence to odd, stores the payload, then bumps it
+// to even. Readers copy the payload and retry if the sequence was odd or
+// moved underneath them, so a read never blocks the writer, never takes a
+// lock and never allocates.
+//
+// The payload is kept as relaxed atomic words (not a plain struct) so the
+// racing copy is well defined; T only has to be trivially copyable.
+// Writes must come from one thread at a time.
+template <typename T>
+class Seqlock
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Seqlock payload must be trivially copyable");
+
+public:
+    Seqlock() { store(T()); }
+    explicit Seqlock(const T &value) { store(value); }
+
+    void store(const T &value)
+    {
+        quint64 words[kWords] = {};
+        std::memcpy(words, &value, sizeof(T));
+
+        const quint32 seq = m_seq.load(std::memory_order_relaxed);
+        m_seq.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (int i = 0; i < kWords; ++i) {
+            m_words[i].store(words[i], std::memory_order_relaxed);
+        }
+        m_seq.store(seq + 2, std::memory_order_release);
+    }
+
+    T load() const
+    {
+        quint64 words[kWords];
+        quint32 before, after;
+        do {
+            before = m_seq.load(std::memory_order_acquire);
+            for (int i = 0; i < kWords; ++i) {
+                words[i] = m_words[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = m_seq.load(std::memory_order_relaxed);
+        } while ((before & 1) || before != after);
+
+        T value;
+        std::memcpy(&value, words, sizeof(T));
+        return value;
+    }
+
+    // Number of completed stores (changes once per publication)
+    quint32 version() const { return m_seq.load(std::memory_order_acquire) / 2; }
+
+private:
+    Q_DISABLE_COPY(Seqlock)
+
+    static const int kWords = (sizeof(T) + sizeof(quint64) - 1) / sizeof(quint64);
+
+    std::atomic<quint32> m_seq{0};
+    std::atomic<quint64> m_words[kWords];
+};
+
+#endif // SEQLOCK_H
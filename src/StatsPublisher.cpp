@@ -0,0 +1,92 @@
+#include "StatsPublisher.h"
+
+// True once value has moved past the deadband from what QML was last told
+static bool moved(double published, double value, double deadband)
+{
+    return qAbs(value - published) > deadband;
+}
+
+int StatsPublisher::publishSnapshot(const SensorSnapshot &snapshot)
+{
+    int changed = 0;
+    if (moved(m_values.cpuUsage, snapshot.cpuUsage, m_usageDeadband)
+        || moved(m_values.cpuFreq, snapshot.cpuFreq, m_freqDeadband)) {
+        m_values.cpuUsage = snapshot.cpuUsage;
+        m_values.cpuFreq = snapshot.cpuFreq;
+        changed |= Cpu;
+    }
+    if (moved(m_values.gpuUsage, snapshot.gpuUsage, m_usageDeadband)
+        || moved(m_values.gpuFreq, snapshot.gpuFreq, m_freqDeadband)) {
+        m_values.gpuUsage = snapshot.gpuUsage;
+        m_values.gpuFreq = snapshot.gpuFreq;
+        changed |= Gpu;
+    }
+    if (moved(m_values.memoryUsage, snapshot.memoryUsage, m_usageDeadband)) {
+        m_values.memoryUsage = snapshot.memoryUsage;
+        changed |= Memory;
+    }
+    if (m_values.batteryPercent != snapshot.batteryPercent
+        || m_values.batteryState != snapshot.batteryState) {
+        m_values.batteryPercent = snapshot.batteryPercent;
+        m_values.batteryState = snapshot.batteryState;
+        changed |= Battery;
+    }
+    if (m_values.sysfsSyscallsSaved != snapshot.sysfsSyscallsSaved) {
+        m_values.sysfsSyscallsSaved = snapshot.sysfsSyscallsSaved;
+        changed |= Diagnostics;
+    }
+    return counted(changed);
+}
+
+int StatsPublisher::publishNetwork(double netDown, double netUp)
+{
+    int changed = 0;
+    if (moved(m_values.netDown, netDown, m_rateDeadband) || moved(m_values.netUp, netUp, m_rateDeadband)) {
+        m_values.netDown = netDown;
+        m_values.netUp = netUp;
+        changed |= Network;
+    }
+    return counted(changed);
+}
+
+int StatsPublisher::publishDisks(double diskUsage, bool listChanged, bool scanTimeChanged)
+{
+    int changed = 0;
+    if (listChanged || moved(m_values.diskUsage, diskUsage, m_usageDeadband)) {
+        m_values.diskUsage = diskUsage;
+        changed |= Disks;
+    }
+    if (scanTimeChanged) changed |= Diagnostics;
+    return counted(changed);
+}
+
+int StatsPublisher::counted(int groups)
+{
+    ++m_passes;
+    for (int i = 0; i < kGroupCount; ++i) {
+        if (groups & (1 << i)) ++m_notifications[i];
+    }
+    return groups;
+}
+
+quint64 StatsPublisher::notifications(Group group) const
+{
+    for (int i = 0; i < kGroupCount; ++i) {
+        if (group == (1 << i)) return m_notifications[i];
+    }
+    return 0;
+}
+
+const char *StatsPublisher::groupSignal(Group group)
+{
+    switch (group) {
+    case Cpu: return "cpuChanged";
+    case Gpu: return "gpuChanged";
+    case Memory: return "memoryChanged";
+    case Network: return "networkChanged";
+    case Disks: return "disksChanged";
+    case Battery: return "batteryChanged";
+    case Diagnostics: return "diagnosticsChanged";
+    }
+    return "";
+}
@@ -0,0 +1,75 @@
+#ifndef STATSPUBLISHER_H
+#define STATSPUBLISHER_H
+
+#include <QtGlobal>
+#include "SensorHub.h"
+
+// The values SystemStatsMonitor last announced to QML, and the deadband
+// rule that decides which notification groups a new reading dirties.
+//
+// A group is republished as a whole when any of its values moved past its
+// deadband, so its readings always come from the same pass. Each publish
+// call is one pass; every pass and every group it dirties is counted, so
+// the notification rate can be read back (notificationCounts() on the
+// monitor, bench_statsnotify on a recorded trace).
+class StatsPublisher
+{
+public:
+    enum Group {
+        Cpu = 0x01,
+        Gpu = 0x02,
+        Memory = 0x04,
+        Network = 0x08,
+        Disks = 0x10,
+        Battery = 0x20,
+        Diagnostics = 0x40
+    };
+    static const int kGroupCount = 7;
+
+    struct Values {
+        double cpuUsage = 0;
+        double cpuFreq = 0;
+        double memoryUsage = 0;
+        double gpuUsage = 0;
+        double gpuFreq = 0;
+        double netDown = 0;
+        double netUp = 0;
+        double diskUsage = 0;
+        int batteryPercent = 0;
+        SensorSnapshot::BatteryState batteryState = SensorSnapshot::BatteryUnknown;
+        int sysfsSyscallsSaved = 0;
+    };
+
+    const Values &values() const { return m_values; }
+
+    // Smallest change worth a notification: percentage points for the
+    // usages, MHz for frequencies, KB/s for network rates
+    double usageDeadband() const { return m_usageDeadband; }
+    double freqDeadband() const { return m_freqDeadband; }
+    double rateDeadband() const { return m_rateDeadband; }
+    void setUsageDeadband(double deadband) { m_usageDeadband = qMax(0.0, deadband); }
+    void setFreqDeadband(double deadband) { m_freqDeadband = qMax(0.0, deadband); }
+    void setRateDeadband(double deadband) { m_rateDeadband = qMax(0.0, deadband); }
+
+    // Each returns the groups to notify
+    int publishSnapshot(const SensorSnapshot &snapshot);
+    int publishNetwork(double netDown, double netUp);
+    // listChanged: the partition list or the summary text differ
+    int publishDisks(double diskUsage, bool listChanged, bool scanTimeChanged);
+
+    quint64 passes() const { return m_passes; }
+    quint64 notifications(Group group) const;
+    static const char *groupSignal(Group group);    // "cpuChanged", ...
+
+private:
+    int counted(int groups);
+
+    Values m_values;
+    double m_usageDeadband = 0.1;
+    double m_freqDeadband = 1.0;
+    double m_rateDeadband = 0.1;
+    quint64 m_passes = 0;
+    quint64 m_notifications[kGroupCount] = {};
+};
+
+#endif // STATSPUBLISHER_H
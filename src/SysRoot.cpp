@@ -0,0 +1,42 @@
+#include "SysRoot.h"
+#include <QDir>
+
+namespace {
+
+QString normalizedRoot(const QString &root)
+{
+    if (root.isEmpty()) return QString();
+    QString clean = QDir::cleanPath(QDir(root).absolutePath());
+    return (clean == "/") ? QString() : clean;
+}
+
+QString &rootStorage()
+{
+    // Environment is the default; --sysroot (via setRoot) overrides it
+    static QString root = normalizedRoot(qEnvironmentVariable("ASUS_TUF_SYSROOT"));
+    return root;
+}
+
+} // namespace
+
+void SysRoot::setRoot(const QString &root)
+{
+    rootStorage() = normalizedRoot(root);
+}
+
+const QString &SysRoot::root()
+{
+    return rootStorage();
+}
+
+bool SysRoot::isRelocated()
+{
+    return !rootStorage().isEmpty();
+}
+
+QString SysRoot::path(const QString &absolute)
+{
+    const QString &root = rootStorage();
+    if (root.isEmpty()) return absolute;
+    return root + absolute;
+}
@@ -0,0 +1,29 @@
+#ifndef SYSROOT_H
+#define SYSROOT_H
+
+#include <QString>
+
+// Relocatable root for every sysfs/procfs/config path the app touches.
+//
+// Empty (the default) means the real system. Setting a root, either with
+// the ASUS_TUF_SYSROOT environment variable or the --sysroot=<dir> command
+// line flag, makes all subsystems read and write a synthetic tree instead
+// (see fake_hwtree.py). That lets the sampling paths be benchmarked and
+// regression-tested on machines without TUF hardware.
+namespace SysRoot
+{
+    // Override the root (call before any controller is constructed)
+    void setRoot(const QString &root);
+
+    // Current root prefix, without trailing slash. Empty = real system.
+    const QString &root();
+
+    // True when a synthetic root is active. Side effects outside the tree
+    // (stopping services, spawning vendor tools) are skipped in that case.
+    bool isRelocated();
+
+    // Map an absolute system path (e.g. "/sys/class/hwmon") under the root
+    QString path(const QString &absolute);
+}
+
+#endif // SYSROOT_H
@@ -0,0 +1,157 @@
+#include "SysfsReader.h"
+#include <QMutexLocker>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+
+// Syscalls issued by the QFile + QTextStream pattern this class replaces:
+// openat, fstat, read, read (EOF), close
+static const int kLegacySyscallsPerRead = 5;
+
+SysfsReader &SysfsReader::instance()
+{
+    static SysfsReader reader;
+    return reader;
+}
+
+SysfsReader::~SysfsReader()
+{
+    for (Handle *h : m_handles) {
+        if (h->fd >= 0) ::close(h->fd);
+        delete h;
+    }
+}
+
+int SysfsReader::attach(const QString &path)
+{
+    if (path.isEmpty()) return -1;
+
+    QMutexLocker locker(&m_mutex);
+    auto it = m_index.constFind(path);
+    if (it != m_index.constEnd()) return it.value();
+
+    Handle *h = new Handle;
+    h->path = path.toLocal8Bit();
+    m_handles.append(h);
+    int id = m_handles.size() - 1;
+    m_index.insert(path, id);
+    return id;
+}
+
+int SysfsReader::readRaw(int handle, char *buf, int size)
+{
+    Handle *h;
+    {
+        QMutexLocker locker(&m_mutex);
+        if (handle < 0 || handle >= m_handles.size() || size < 2) return -1;
+        h = m_handles[handle];
+    }
+
+    // The global lock is not held across the syscalls: a slow attribute
+    // (asus-wmi) on the sampling thread must not stall the GUI thread
+    QMutexLocker handleLocker(&h->lock);
+    quint64 syscalls = 0;
+    bool reopened = false;
+    int result = -1;
+
+    // Two attempts: the cached descriptor, then a fresh one if the first
+    // read failed (device removed and re-added, module reloaded, ...)
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        if (h->fd < 0) {
+            syscalls++;
+            h->fd = ::open(h->path.constData(), O_RDONLY | O_CLOEXEC);
+            if (h->fd < 0) break;
+        }
+
+        ssize_t n;
+        do {
+            syscalls++;
+            n = ::pread(h->fd, buf, size - 1, 0);
+        } while (n < 0 && errno == EINTR);
+
+        if (n >= 0) {
+            buf[n] = '\0';
+            result = static_cast<int>(n);
+            break;
+        }
+
+        syscalls++;
+        ::close(h->fd);
+        h->fd = -1;
+        if (attempt == 0) reopened = true;
+    }
+    handleLocker.unlock();
+
+    QMutexLocker locker(&m_mutex);
+    m_stats.reads++;
+    m_stats.legacySyscalls += kLegacySyscallsPerRead;
+    m_stats.syscalls += syscalls;
+    if (reopened) m_stats.reopens++;
+    return result;
+}
+
+bool SysfsReader::tryReadInt(int handle, long long *value)
+{
+    char buf[64];
+    int n = readRaw(handle, buf, sizeof(buf));
+    if (n <= 0) return false;
+
+    // Hand-rolled parse: optional whitespace, optional sign, digits
+    const char *p = buf;
+    while (*p == ' ' || *p == '\t' || *p == '\n') ++p;
+    bool negative = false;
+    if (*p == '-' || *p == '+') {
+        negative = (*p == '-');
+        ++p;
+    }
+    if (*p < '0' || *p > '9') return false;
+
+    long long v = 0;
+    while (*p >= '0' && *p <= '9') {
+        v = v * 10 + (*p - '0');
+        ++p;
+    }
+    *value = negative ? -v : v;
+    return true;
+}
+
+long long SysfsReader::readInt(int handle, long long fallback)
+{
+    long long v;
+    return tryReadInt(handle, &v) ? v : fallback;
+}
+
+long long SysfsReader::readInt(const QString &path, long long fallback)
+{
+    return readInt(attach(path), fallback);
+}
+
+int SysfsReader::readText(int handle, char *buf, int size)
+{
+    int n = readRaw(handle, buf, size);
+    if (n < 0) return -1;
+
+    // Keep the first line only, then trim trailing whitespace
+    int len = 0;
+    while (len < n && buf[len] != '\n') ++len;
+    while (len > 0 && (buf[len - 1] == ' ' || buf[len - 1] == '\t' || buf[len - 1] == '\r')) --len;
+    buf[len] = '\0';
+    return len;
+}
+
+SysfsReader::Stats SysfsReader::stats() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_stats;
+}
+
+quint64 SysfsReader::takeTickSavings()
+{
+    QMutexLocker locker(&m_mutex);
+    quint64 saved = m_stats.legacySyscalls > m_stats.syscalls
+                        ? m_stats.legacySyscalls - m_stats.syscalls : 0;
+    quint64 delta = saved > m_lastSaved ? saved - m_lastSaved : 0;
+    m_lastSaved = saved;
+    return delta;
+}
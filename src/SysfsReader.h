@@ -0,0 +1,79 @@
+#ifndef SYSFSREADER_H
+#define SYSFSREADER_H
+
+#include <QString>
+#include <QByteArray>
+#include <QHash>
+#include <QVector>
+#include <QMutex>
+
+// Shared cache of open sysfs/procfs attribute descriptors.
+//
+// The old path built a QFile + QTextStream for every sample:
+//   openat + fstat + read + read(EOF) + close  (5 syscalls, several heap allocs)
+// Here each attribute is opened once, then re-read with pread() at offset 0
+// into a stack buffer (1 syscall, no allocation). The descriptor is only
+// reopened when a read fails (hotplug, driver reload).
+//
+// Usage: resolve a handle once with attach(), then read it every tick.
+// Handles are process-wide, so two controllers attaching the same path
+// share one descriptor. Each descriptor has its own lock, so a read that
+// stalls in the driver only holds up readers of that same attribute.
+class SysfsReader
+{
+public:
+    struct Stats {
+        quint64 reads = 0;          // Attribute reads served
+        quint64 syscalls = 0;       // Syscalls actually issued (open/pread/close)
+        quint64 legacySyscalls = 0; // Syscalls the QFile/QTextStream path would have issued
+        quint64 reopens = 0;        // Descriptors re-opened after a failed read
+    };
+
+    static SysfsReader &instance();
+
+    // Returns a stable handle for `path`, or -1 if the path is empty.
+    // The file does not need to exist yet; it is opened lazily on first read.
+    int attach(const QString &path);
+
+    // Parse the attribute as a decimal integer. Returns false on failure.
+    bool tryReadInt(int handle, long long *value);
+    long long readInt(int handle, long long fallback = 0);
+
+    // Copy the first line of the attribute (whitespace-trimmed, NUL-terminated)
+    // into `buf`. Returns the length, or -1 on failure.
+    int readText(int handle, char *buf, int size);
+
+    // Raw attribute contents (NUL-terminated, may span several lines).
+    // Returns the length, or -1 on failure.
+    int read(int handle, char *buf, int size) { return readRaw(handle, buf, size); }
+
+    // Convenience for cold paths (attach + read in one call)
+    long long readInt(const QString &path, long long fallback = 0);
+
+    Stats stats() const;
+
+    // Syscalls saved versus the legacy path since the previous call.
+    // The sampling owner calls this once per tick.
+    quint64 takeTickSavings();
+
+private:
+    SysfsReader() = default;
+    ~SysfsReader();
+    Q_DISABLE_COPY(SysfsReader)
+
+    struct Handle {
+        QByteArray path;
+        int fd = -1;
+        QMutex lock;    // Guards fd and the read itself
+    };
+
+    int readRaw(int handle, char *buf, int size);
+
+    mutable QMutex m_mutex;     // Guards the index, the handle table and the stats
+    QHash<QString, int> m_index;
+    QVector<Handle *> m_handles; // Stable addresses while another thread reads
+    Stats m_stats;
+    quint64 m_lastSaved = 0;
+};
+
+#endif // SYSFSREADER_H
@@ -1,32 +1,64 @@
 #include <QDesktopServices>
 #include <QUrl>
 #include "SystemStatsMonitor.h"
+#include "SysfsReader.h"
+#include "SysRoot.h"
+#include "SamplingScheduler.h"
+#include "BlockDeviceScanner.h"
+#include "NvidiaSmiStream.h"
+#include "HardwareWriteQueue.h"
+#include <QElapsedTimer>
+#include <QDateTime>
 #include <QSet>
 
-SystemStatsMonitor::SystemStatsMonitor(QObject *parent) : QObject(parent)
+SystemStatsMonitor::SystemStatsMonitor(QObject *parent)
+    : QObject(parent)
+    , m_sensorHub(SensorHub::current())
+    , m_cpuCoreModel(new CpuCoreModel(this))
+    // rtnetlink reports the host's interfaces, so a fake tree reads its own /proc/net/dev
+    , m_netSampler(SysRoot::path("/proc/net/dev"), !SysRoot::isRelocated())
+    , m_netInterfaceModel(new NetworkInterfaceModel(this))
+    , m_cpuHistory(new MetricHistory(60, this))
+    , m_gpuHistory(new MetricHistory(60, this))
+    , m_ramHistory(new MetricHistory(60, this))
+    , m_diskHistory(new MetricHistory(60, this))
+    , m_tempHistory(new MetricHistory(60, this))
+    , m_netDownHistory(new MetricHistory(60, this))
+    , m_netUpHistory(new MetricHistory(60, this))
+    , m_telemetry(new TelemetryHistory(this))
+    , m_archiveQuery(new TelemetryQuery(&m_archive, this))
+    , m_cpuStats(new WindowedStats(300, this))
+    , m_gpuStats(new WindowedStats(300, this))
+    , m_ramStats(new WindowedStats(300, this))
+    , m_diskStats(new WindowedStats(300, this))
+    , m_tempStats(new WindowedStats(300, this))
+    , m_gpuTempStats(new WindowedStats(300, this))
+    , m_cpuFanStats(new WindowedStats(300, this))
+    , m_gpuFanStats(new WindowedStats(300, this))
+    , m_netDownStats(new WindowedStats(300, this))
+    , m_netUpStats(new WindowedStats(300, this))
 {
-    // Main stats timer - 0.5 second for instant UI (safe now due to async GPU)
-    m_timer = new QTimer(this);
-    m_timer->setInterval(500);  // 0.5s update for snappy USB/Graph response
-    connect(m_timer, &QTimer::timeout, this, &SystemStatsMonitor::updateStats);
-    m_timer->start();
-    
-    // Slow timer for heavy I/O operations (disk, network) - every 2 seconds
-    m_slowTimer = new QTimer(this);
-    m_slowTimer->setInterval(2000);  // 2s backup poll
-    connect(m_slowTimer, &QTimer::timeout, this, &SystemStatsMonitor::updateSlowStats);
-    m_slowTimer->start();
-    
-    // Enforcement Timer (5 seconds loop)
-    m_enforcementTimer = new QTimer(this);
-    m_enforcementTimer->setInterval(5000); 
-    connect(m_enforcementTimer, &QTimer::timeout, this, &SystemStatsMonitor::enforceChargeLimit);
-    m_enforcementTimer->start();
-
-    // 3. GPU Process Init - async to avoid blocking
-    m_gpuProcess = new QProcess(this);
-    connect(m_gpuProcess, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
-            this, &SystemStatsMonitor::onGpuProcessFinished);
+    // Periodic work runs on the shared scheduler grid: passes due in the
+    // same window share one wakeup instead of each QTimer waking us alone.
+    SamplingScheduler &scheduler = SamplingScheduler::instance();
+
+    // Graphs start from what the previous run recorded
+    seedHistoryFromJournal();
+
+    // Main stats - sampled every 0.5 s on the hub's thread; we only get the notification
+    connect(m_sensorHub, &SensorHub::snapshotUpdated, this, &SystemStatsMonitor::updateStats);
+    
+    // Slow pass for network rates - every 2 seconds
+    m_slowStatsTask = scheduler.add(this, 2000, 0, [this]() { updateSlowStats(); });
+
+    // Disk free space drifts slowly; new/removed drives come from MountWatcher
+    m_diskTask = scheduler.add(this, 10000, 0, [this]() { refreshDisks(); });
+    
+    // Charge limit enforcement (5 seconds loop)
+    m_enforcementTask = scheduler.add(this, 5000, 0, [this]() { enforceChargeLimit(); });
+
+    // 3. GPU telemetry - one persistent nvidia-smi stream shared with FanController
+    NvidiaSmiStream::instance().acquire();
     
     // 4. Debounce Timer Init
     m_limitDebounceTimer = new QTimer(this);
@@ -49,6 +81,9 @@ SystemStatsMonitor::SystemStatsMonitor(QObject *parent) : QObject(parent)
     
     m_mtpThread->start();
     
+    // Same battery the hub samples (BAT1, else BAT0)
+    m_batteryDir = m_sensorHub->batteryDir();
+
     // Initial read
     readSystemInfo();
     
@@ -68,10 +103,15 @@ SystemStatsMonitor::SystemStatsMonitor(QObject *parent) : QObject(parent)
         }
     }
     
+    // Instant USB detection: rescan disks when the mount table or the set of
+    // block devices changes (kernel events, nothing is polled)
+    m_mountWatcher = new MountWatcher(this);
+    connect(m_mountWatcher, &MountWatcher::changed, this, &SystemStatsMonitor::refreshDisks);
+
     // Initial updates
-    m_cachedVolumeCount = QStorageInfo::mountedVolumes().count();
     updateStats();
-    updateSlowStats();  // Disk info on startup
+    updateSlowStats();
+    refreshDisks();  // Disk info on startup
 }
 
 SystemStatsMonitor::~SystemStatsMonitor()
@@ -80,217 +120,252 @@ SystemStatsMonitor::~SystemStatsMonitor()
         m_mtpThread->quit();
         m_mtpThread->wait(1000);  // Max 1 second wait
     }
-    if (m_gpuProcess) {
-        if (m_gpuProcess->state() != QProcess::NotRunning) {
-            m_gpuProcess->terminate();  // Graceful first
-            if (!m_gpuProcess->waitForFinished(500)) {
-                m_gpuProcess->kill();  // Force kill if graceful fails
-                m_gpuProcess->waitForFinished(100);
-            }
-        }
-    }
+    NvidiaSmiStream::instance().release();
 }
 
 #include <sys/statvfs.h>
 
 void SystemStatsMonitor::updateStats()
 {
-    // Fast stats only - lightweight sysfs reads
-    readCpuFreq();
-    readMemoryUsage();
-    readCpuUsage();
-    readGpuStats();  // Now async, won't block
-    readBattery();
-    // Fast Check for Disk Changes (Instant USB Detection)
-    // QStorageInfo::mountedVolumes reads /proc/mounts (very fast).
-    // If count changes, we trigger full disk scan immediately.
-    auto currentVols = QStorageInfo::mountedVolumes();
-    if (currentVols.count() != m_cachedVolumeCount) {
-        m_cachedVolumeCount = currentVols.count();
-        updateSlowStats(); // Trigger heavy scan immediately!
-    }
+    const SensorSnapshot snapshot = m_sensorHub->snapshot();
+
+    // The per-core model updates its rows in place and signals per row
+    m_sensorHub->copyCores(&m_cores);
+    m_cpuCoreModel->update(m_cores);
 
-    emit statsChanged();
+    const int changed = m_publisher.publishSnapshot(snapshot);
+
+    appendHistory(snapshot);
+
+    emitChanges(changed);
 }
 
-// Slow stats - heavy I/O operations (disk, network)
-void SystemStatsMonitor::updateSlowStats()
+void SystemStatsMonitor::emitChanges(int groups)
 {
-    readDiskUsage();
-    readNetworkUsage();
-    emit statsChanged();
+    if (groups & StatsPublisher::Cpu) emit cpuChanged();
+    if (groups & StatsPublisher::Gpu) emit gpuChanged();
+    if (groups & StatsPublisher::Memory) emit memoryChanged();
+    if (groups & StatsPublisher::Network) emit networkChanged();
+    if (groups & StatsPublisher::Disks) emit disksChanged();
+    if (groups & StatsPublisher::Battery) emit batteryChanged();
+    if (groups & StatsPublisher::Diagnostics) emit diagnosticsChanged();
 }
 
-void SystemStatsMonitor::readCpuFreq()
+QVariantMap SystemStatsMonitor::notificationCounts() const
 {
-    QFile file("/sys/devices/system/cpu/cpu0/cpufreq/scaling_cur_freq");
-    if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        QTextStream in(&file);
-        double khz = in.readLine().toDouble();
-        m_cpuFreq = khz / 1000.0;
-        file.close();
+    QVariantMap counts;
+    counts.insert("passes", m_publisher.passes());
+    for (int i = 0; i < StatsPublisher::kGroupCount; ++i) {
+        const auto group = static_cast<StatsPublisher::Group>(1 << i);
+        counts.insert(StatsPublisher::groupSignal(group), m_publisher.notifications(group));
     }
+    return counts;
 }
 
-void SystemStatsMonitor::readMemoryUsage()
+void SystemStatsMonitor::setUsageDeadband(double deadband)
 {
-    QFile file("/proc/meminfo");
-    if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        QString content = file.readAll();
-        file.close();
-        
-        // Regex for MemTotal and MemAvailable
-        // MemTotal:       16303032 kB
-        QRegularExpression reTotal("MemTotal:\\s+(\\d+)");
-        QRegularExpression reAvail("MemAvailable:\\s+(\\d+)");
-        
-        QRegularExpressionMatch matchTotal = reTotal.match(content);
-        QRegularExpressionMatch matchAvail = reAvail.match(content);
-        
-        double total = 0;
-        double available = 0;
-        
-        if (matchTotal.hasMatch()) {
-            total = matchTotal.captured(1).toDouble();
-        }
-        
-        if (matchAvail.hasMatch()) {
-            available = matchAvail.captured(1).toDouble();
-        }
-        
-        if (total > 0) {
-            m_memoryUsage = ((total - available) / total) * 100.0;
-        } else {
-            m_memoryUsage = 0;
-        }
-    }
+    if (qMax(0.0, deadband) == m_publisher.usageDeadband()) return;
+    m_publisher.setUsageDeadband(deadband);
+    emit deadbandsChanged();
 }
 
-void SystemStatsMonitor::readCpuUsage()
+void SystemStatsMonitor::setFreqDeadband(double deadband)
 {
-    QFile file("/proc/stat");
-    if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        QTextStream in(&file);
-        QString line = in.readLine();
-        file.close();
-        
-        QStringList parts = line.split(QRegularExpression("\\s+"));
-        if (parts.length() > 4) {
-            long long user = parts[1].toLongLong();
-            long long nice = parts[2].toLongLong();
-            long long system = parts[3].toLongLong();
-            long long idle = parts[4].toLongLong();
-            long long iowait = (parts.length() > 5) ? parts[5].toLongLong() : 0;
-            long long irq = (parts.length() > 6) ? parts[6].toLongLong() : 0;
-            long long softirq = (parts.length() > 7) ? parts[7].toLongLong() : 0;
-            long long total = user + nice + system + idle + iowait + irq + softirq;
-            long long totalIdle = idle + iowait;
-            
-            if (m_prevTotal > 0) {
-                long long totalDiff = total - m_prevTotal;
-                long long idleDiff = totalIdle - m_prevIdle;
-                if (totalDiff > 0) m_cpuUsage = ((double)(totalDiff - idleDiff) / totalDiff) * 100.0;
-            }
-            m_prevTotal = total;
-            m_prevIdle = totalIdle;
-        }
-    }
+    if (qMax(0.0, deadband) == m_publisher.freqDeadband()) return;
+    m_publisher.setFreqDeadband(deadband);
+    emit deadbandsChanged();
 }
 
-void SystemStatsMonitor::readGpuStats()
+void SystemStatsMonitor::setRateDeadband(double deadband)
 {
-    // Async GPU query - doesn't block UI thread
-    if (m_gpuProcess->state() != QProcess::NotRunning) return;
-    
-    m_gpuProcess->start("nvidia-smi", QStringList() << "--query-gpu=clocks.gr,utilization.gpu" << "--format=csv,noheader,nounits");
-    // Result handled in onGpuProcessFinished() - no blocking wait!
+    if (qMax(0.0, deadband) == m_publisher.rateDeadband()) return;
+    m_publisher.setRateDeadband(deadband);
+    emit deadbandsChanged();
+}
+
+void SystemStatsMonitor::appendHistory(const SensorSnapshot &snapshot)
+{
+    // Graphs plot one point per second; passes arrive every 500 ms
+    // (with some jitter), so go by the snapshot clock
+    if (m_lastHistoryMs != 0 && snapshot.timestampMs - m_lastHistoryMs < 900) return;
+    m_lastHistoryMs = snapshot.timestampMs;
+
+    m_cpuHistory->append(snapshot.cpuUsage);
+    m_gpuHistory->append(snapshot.gpuUsage);
+    m_ramHistory->append(snapshot.memoryUsage);
+    m_diskHistory->append(m_diskUsage);
+    m_tempHistory->append(snapshot.cpuTemp);
+    m_netDownHistory->append(m_netDown);
+    m_netUpHistory->append(m_netUp);
+
+    // Long-range tiers use wall-clock time so ranges match what the user remembers
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    m_telemetry->append(now, {
+        static_cast<float>(snapshot.cpuUsage), static_cast<float>(snapshot.gpuUsage),
+        static_cast<float>(snapshot.memoryUsage), static_cast<float>(m_diskUsage),
+        static_cast<float>(snapshot.cpuTemp), static_cast<float>(m_netDown), static_cast<float>(m_netUp)
+    });
+
+    // Stores into the mapped journal; no syscall per sample
+    TelemetryJournal::Record record = {};
+    record.timestampMs = now;
+    record.cpuUsage = static_cast<float>(snapshot.cpuUsage);
+    record.cpuFreq = static_cast<float>(snapshot.cpuFreq);
+    record.memoryUsage = static_cast<float>(snapshot.memoryUsage);
+    record.gpuUsage = static_cast<float>(snapshot.gpuUsage);
+    record.gpuFreq = static_cast<float>(snapshot.gpuFreq);
+    record.diskUsage = static_cast<float>(m_diskUsage);
+    record.netDown = static_cast<float>(m_netDown);
+    record.netUp = static_cast<float>(m_netUp);
+    record.cpuTemp = static_cast<qint16>(snapshot.cpuTemp);
+    record.gpuTemp = static_cast<qint16>(snapshot.gpuTemp);
+    record.cpuFanRpm = static_cast<quint16>(qBound(0, snapshot.cpuFanRpm, 65535));
+    record.gpuFanRpm = static_cast<quint16>(qBound(0, snapshot.gpuFanRpm, 65535));
+    record.thermalPolicy = static_cast<qint8>(snapshot.thermalPolicy);
+    record.batteryPercent = static_cast<quint8>(qBound(0, snapshot.batteryPercent, 255));
+    record.batteryState = static_cast<quint8>(snapshot.batteryState);
+    m_journal.append(record);
+    // The journal's flock makes this the only writer; a second instance
+    // leaves the archive to the first one
+    if (m_journal.isOpen()) m_archive.append(record);
+    appendStats(record);
+}
+
+void SystemStatsMonitor::appendStats(const TelemetryJournal::Record &record)
+{
+    m_cpuStats->append(record.timestampMs, record.cpuUsage);
+    m_gpuStats->append(record.timestampMs, record.gpuUsage);
+    m_ramStats->append(record.timestampMs, record.memoryUsage);
+    m_diskStats->append(record.timestampMs, record.diskUsage);
+    m_tempStats->append(record.timestampMs, record.cpuTemp);
+    m_gpuTempStats->append(record.timestampMs, record.gpuTemp);
+    m_cpuFanStats->append(record.timestampMs, record.cpuFanRpm);
+    m_gpuFanStats->append(record.timestampMs, record.gpuFanRpm);
+    m_netDownStats->append(record.timestampMs, record.netDown);
+    m_netUpStats->append(record.timestampMs, record.netUp);
+}
+
+void SystemStatsMonitor::seedHistoryFromJournal()
+{
+    if (m_journal.count() == 0) return;
+
+    // Every record feeds the long-range tiers; the short graphs and the
+    // window stats only take what still falls inside their windows, so a
+    // restart after a long gap doesn't splice old samples onto new ones
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    const qint64 graphFrom = now - static_cast<qint64>(historyLength()) * 1000;
+    const qint64 statsFrom = now - static_cast<qint64>(m_cpuStats->windowSeconds()) * 1000;
+
+    // Records the archive hadn't sealed yet when the app last stopped are
+    // picked up again from the journal
+    m_journal.replay([&](const TelemetryJournal::Record &r) {
+        if (r.timestampMs > m_archive.lastTimestampMs()) m_archive.append(r);
+
+        m_telemetry->append(r.timestampMs, {
+            r.cpuUsage, r.gpuUsage, r.memoryUsage, r.diskUsage,
+            static_cast<float>(r.cpuTemp), r.netDown, r.netUp
+        });
+
+        if (r.timestampMs > now) return;
+        if (r.timestampMs >= statsFrom) appendStats(r);
+
+        if (r.timestampMs < graphFrom) return;
+        m_cpuHistory->append(r.cpuUsage);
+        m_gpuHistory->append(r.gpuUsage);
+        m_ramHistory->append(r.memoryUsage);
+        m_diskHistory->append(r.diskUsage);
+        m_tempHistory->append(r.cpuTemp);
+        m_netDownHistory->append(r.netDown);
+        m_netUpHistory->append(r.netUp);
+    });
+
+    qInfo() << "SystemStatsMonitor: seeded history with" << m_journal.count() << "journal records,"
+            << m_cpuHistory->count() << "in the live graphs";
 }
 
-void SystemStatsMonitor::onGpuProcessFinished(int exitCode, QProcess::ExitStatus status)
+void SystemStatsMonitor::setHistoryLength(int length)
 {
-    Q_UNUSED(status);
-    if (exitCode != 0) return;
-    
-    QString output = m_gpuProcess->readAllStandardOutput().trimmed();
-    if (output.isEmpty()) return;
-    
-    QStringList parts = output.split(",");
-    if (parts.length() >= 2) {
-        m_gpuFreq = parts[0].trimmed().toDouble();
-        m_gpuUsage = parts[1].trimmed().toDouble();
-    } else if (parts.length() == 1) {
-        m_gpuFreq = parts[0].trimmed().toDouble();
+    length = qBound(2, length, 86400);
+    if (length == historyLength()) return;
+
+    for (MetricHistory *history : {m_cpuHistory, m_gpuHistory, m_ramHistory, m_diskHistory,
+                                   m_tempHistory, m_netDownHistory, m_netUpHistory}) {
+        history->setCapacity(length);
     }
-    emit statsChanged();
+    emit historyLengthChanged();
+}
+
+// Slow stats - network rates
+void SystemStatsMonitor::updateSlowStats()
+{
+    readNetworkUsage();
+    emitChanges(m_publisher.publishNetwork(m_netDown, m_netUp));
+}
+
+// Disk list - mount/hotplug events, MTP scans and a slow free-space refresh
+void SystemStatsMonitor::refreshDisks()
+{
+    const QVariantList previousPartitions = m_diskPartitions;
+    const QString previousText = diskText();
+    const int previousScanUs = m_diskScanUs;
+
+    readDiskUsage();
+
+    // The partition list drives a Repeater; only hand QML a new one when it differs
+    const bool listChanged = m_diskPartitions != previousPartitions || diskText() != previousText;
+    emitChanges(m_publisher.publishDisks(m_diskUsage, listChanged, m_diskScanUs != previousScanUs));
 }
 
 // --- Disk Usage Logic ---
 // --- Disk Usage Logic ---
-// Revised: Use lsblk -P (Pairs) with PARTLABEL and Precise Math
+// Partition list from sysfs/mountinfo with PARTLABEL and Precise Math
 void SystemStatsMonitor::readDiskUsage()
 {
-    QProcess lsblk;
-    // Added PARTLABEL
-    lsblk.start("lsblk", QStringList() << "-P" << "-b" << "-o" << "NAME,LABEL,PARTLABEL,MOUNTPOINT,FSTYPE,SIZE,TYPE,FSUSE%,FSAVAIL,PATH");
-    
-    if (!lsblk.waitForFinished(1500)) {
-        return; 
-    }
-    
-    QByteArray output = lsblk.readAllStandardOutput();
-    QStringList lines = QString(output).split('\n', Qt::SkipEmptyParts);
+    // In-process enumeration (sysfs + mountinfo + statvfs) instead of forking lsblk
+    QElapsedTimer scanTimer;
+    scanTimer.start();
+    const QVector<BlockDevice> devices = BlockDeviceScanner::scan();
+    m_diskScanUs = static_cast<int>(scanTimer.nsecsElapsed() / 1000);
     
     QVariantList newPartitions;
     double totalAll = 0;
     double usedAll = 0;
     
-    for (const QString &line : lines) {
-        QMap<QString, QString> props;
-        QRegularExpression re("([A-Z%]+)=\"([^\"]*)\"");
-        QRegularExpressionMatchIterator i = re.globalMatch(line);
-        while (i.hasNext()) {
-            QRegularExpressionMatch match = i.next();
-            props[match.captured(1)] = match.captured(2);
-        }
-        
-        QString fstype = props["FSTYPE"];
+    for (const BlockDevice &dev : devices) {
+        const QString &fstype = dev.fsType;
         
         // Filter logic
-        if (props["TYPE"] != "part" && props["TYPE"] != "disk") continue; // Allow parts and whole disks (USB)
+        if (dev.type != "part" && dev.type != "disk") continue; // Allow parts and whole disks (USB)
         if (fstype == "swap") continue; // Explicitly ignore SWAP
         
-        QString mp = props["MOUNTPOINT"];
+        const QString &mp = dev.mountPoint;
         if (mp == "[SWAP]") continue;   // Extra safety for SWAP
         if (mp.startsWith("/snap") || mp.startsWith("/run/snap") || mp.startsWith("/boot")) continue; 
         
-        QString label = props["LABEL"];
-        QString partLabel = props["PARTLABEL"];
-        QString name = props["NAME"];
-        
-        double sizeBytes = props["SIZE"].toDouble();
+        QString label = dev.label;
+        QString partLabel = dev.partLabel;
         
-        // Lower threshold to 100MB to support small USB drives
-        if (sizeBytes < 100.0 * 1000.0 * 1000.0) continue;
+        double sizeBytes = dev.sizeBytes;
         
         // Lower threshold to 100MB to support small USB drives
         if (sizeBytes < 100.0 * 1000.0 * 1000.0) continue;
         
         // Hide raw unmounted disks (reduces duplicates like "1000.2 GB Local Disk" vs its partitions)
         // We allow TYPE="disk" ONLY if it is mounted (for whole-disk USB drives)
-        if (props["TYPE"] == "disk" && mp.isEmpty()) continue;
+        if (dev.type == "disk" && mp.isEmpty()) continue;
 
         double sizeGB = sizeBytes / (1000.0 * 1000.0 * 1000.0);
         bool isMounted = !mp.isEmpty();
         
         // ... (rest of logic) ...
-        bool hasUsage = !props["FSAVAIL"].isEmpty(); // FSAVAIL is the source of truth for free space
+        bool hasUsage = dev.hasAvail; // statvfs() free space is the source of truth
         
         double freeBytes = 0;
         double usedBytes = 0;
         double usagePercent = 0;
         
         if (hasUsage) {
-            freeBytes = props["FSAVAIL"].toDouble();
+            freeBytes = dev.availBytes;
             usedBytes = sizeBytes - freeBytes;
             if (sizeBytes > 0) usagePercent = (usedBytes / sizeBytes) * 100.0;
         }
@@ -332,7 +407,7 @@ void SystemStatsMonitor::readDiskUsage()
         
         QVariantMap p;
         p["name"] = displayName;
-        p["device"] = props["PATH"];
+        p["device"] = dev.path;
         p["mount"] = mp;
         p["fsType"] = fstype;
         p["total"] = QString::number(sizeGB, 'f', 1);
@@ -375,51 +450,25 @@ void SystemStatsMonitor::readDiskUsage()
 
 void SystemStatsMonitor::onMtpDevicesFound(QVariantList devices)
 {
+    if (devices == m_cachedMtpDevices) return;
     m_cachedMtpDevices = devices;
     // Trigger update immediately to show new devices
-    updateStats();
+    refreshDisks();
 }
 
 void SystemStatsMonitor::readNetworkUsage()
 {
-    QFile file("/proc/net/dev");
-    if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        QTextStream in(&file);
-        // Skip headers
-        in.readLine();
-        in.readLine();
-        
-        long long currentRx = 0;
-        long long currentTx = 0;
-        
-        while (!in.atEnd()) {
-            QString line = in.readLine();
-            QStringList parts = line.trimmed().split(QRegularExpression("\\s+"));
-            if (parts.length() > 9) {
-                // Interface name ends with ':'
-                if (!parts[0].startsWith("lo") && !parts[0].startsWith("vmnet")) {
-                    currentRx += parts[1].toLongLong();
-                    currentTx += parts[9].toLongLong();
-                }
-            }
-        }
-        file.close();
-        
-        if (m_prevRx > 0) {
-            // Bytes per 0.5 sec -> KB/s
-            // (diff * 2) / 1024
-            m_netDown = (currentRx - m_prevRx) * 2.0 / 1024.0;
-            m_netUp = (currentTx - m_prevTx) * 2.0 / 1024.0;
-        }
-        
-        m_prevRx = currentRx;
-        m_prevTx = currentTx;
-    }
+    // Rates are per real elapsed second, whatever the task period is
+    if (!m_netSampler.sample()) return;
+
+    m_netDown = m_netSampler.rxRate();
+    m_netUp = m_netSampler.txRate();
+    m_netInterfaceModel->update(m_netSampler.interfaces());
 }
 
 void SystemStatsMonitor::readSystemInfo() {
     // 1. Laptop Model
-    QFile fModel("/sys/class/dmi/id/product_name");
+    QFile fModel(SysRoot::path("/sys/class/dmi/id/product_name"));
     if (fModel.open(QIODevice::ReadOnly)) {
         m_laptopModel = fModel.readAll().trimmed();
         fModel.close();
@@ -428,7 +477,7 @@ void SystemStatsMonitor::readSystemInfo() {
     }
 
     // 2. OS Version
-    QFile fOs("/etc/os-release");
+    QFile fOs(SysRoot::path("/etc/os-release"));
     if (fOs.open(QIODevice::ReadOnly)) {
         QString content = fOs.readAll();
         QRegularExpression re("PRETTY_NAME=\"([^\"]+)\"");
@@ -442,7 +491,7 @@ void SystemStatsMonitor::readSystemInfo() {
     }
 
     // 3. CPU Model
-    QFile fCpu("/proc/cpuinfo");
+    QFile fCpu(SysRoot::path("/proc/cpuinfo"));
     if (fCpu.open(QIODevice::ReadOnly)) {
         QString content = fCpu.readAll();
         QRegularExpression re("model name\\s+:\\s+(.+)"); // Find first match
@@ -489,25 +538,22 @@ void SystemStatsMonitor::readSystemInfo() {
     }
 }
 
-void SystemStatsMonitor::readBattery() {
-    QFile fCap("/sys/class/power_supply/BAT1/capacity");
-    if (fCap.open(QIODevice::ReadOnly)) {
-        m_batteryPercent = fCap.readAll().trimmed().toInt();
-        fCap.close();
-    }
-
-    QFile fStatus("/sys/class/power_supply/BAT1/status");
-    if (fStatus.open(QIODevice::ReadOnly)) {
-        m_batteryState = fStatus.readAll().trimmed();
-        m_isCharging = (m_batteryState == "Charging");
-        fStatus.close();
+QString SystemStatsMonitor::batteryState() const {
+    // power_supply status strings; literals, so no allocation per read
+    switch (m_publisher.values().batteryState) {
+    case SensorSnapshot::BatteryCharging: return QStringLiteral("Charging");
+    case SensorSnapshot::BatteryDischarging: return QStringLiteral("Discharging");
+    case SensorSnapshot::BatteryNotCharging: return QStringLiteral("Not charging");
+    case SensorSnapshot::BatteryFull: return QStringLiteral("Full");
+    case SensorSnapshot::BatteryUnknown: break;
     }
+    return QStringLiteral("Unknown");
 }
 
 // --- Charge Limit Logic ---
 
 int SystemStatsMonitor::readChargeLimit() {
-    QFile file("/sys/class/power_supply/BAT1/charge_control_end_threshold");
+    QFile file(batteryPath("charge_control_end_threshold"));
     if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
         int val = file.readAll().trimmed().toInt();
         file.close();
@@ -538,65 +584,51 @@ void SystemStatsMonitor::applyPendingChargeLimit() {
     int limit = m_pendingChargeLimit;
     if (limit < 60 || limit > 100) return;
 
-    // Path to battery threshold file
-    QString batPath = "/sys/class/power_supply/BAT1/charge_control_end_threshold";
-    if (!QFile::exists(batPath)) {
-        batPath = "/sys/class/power_supply/BAT0/charge_control_end_threshold";
-    }
+    HardwareWriteQueue::Command command;
+    command.kind = HardwareWriteQueue::ChargeThreshold;
+    command.target = batteryPath("charge_control_end_threshold");
+    command.value = QString::number(limit);
 
-    bool success = false;
-    
-    // 1. Try asusctl first
-    QProcess asusctl;
-    asusctl.start("asusctl", QStringList() << "-c" << QString::number(limit));
-    if (asusctl.waitForFinished(1000) && asusctl.exitCode() == 0) {
-        // VERIFY: Check if the file actually updated
-        QFile checkFile(batPath);
-        if (checkFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-            int currentVal = checkFile.readAll().trimmed().toInt();
-            checkFile.close();
-            if (currentVal == limit) {
-                success = true;
-            }
-        }
-    }
-    
+    // 1. Try asusctl first (real hardware only, never against a synthetic root)
     // 2. Fallback: Direct Sysfs Write (If asusctl failed OR verification failed)
-    if (!success) {
-        QFile file(batPath);
-        if (file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-            QTextStream out(&file);
-            out << limit;
-            file.close();
-            success = true; // Assume success if write didn't throw
-        }
+    // The write queue does both off the GUI thread (asusctl can take a second)
+    if (!SysRoot::isRelocated()) {
+        command.helper = QStringList() << "asusctl" << "-c" << command.value;
     }
 
-    if (success) {
-        // Persist to Robust System Service Config
-        QFile conf("/etc/asus_battery_limit.conf");
-        if (conf.open(QIODevice::WriteOnly | QIODevice::Text)) {
-            QTextStream confOut(&conf);
-            confOut << limit;
-            conf.close();
-        }
-        
-        // Update QSettings
-        QSettings settings("AsusTuf", "FanControl");
-        settings.setValue("ChargeLimit", limit);
-        
-        // Persist to asusd config (Secondary Backup)
-        updateAsusdChargeLimit(limit);
-        
-        // Force Immediate Enforcement
-        enforceChargeLimit();
+    m_chargeLimitWriting = true;
+    HardwareWriteQueue::instance().submit(command, this,
+            [this, limit](const HardwareWriteQueue::Result &result) {
+        if (result.superseded) return;   // A newer limit is on its way
+        m_chargeLimitWriting = false;
+        if (result.ok) persistChargeLimit(limit);
+    });
+}
+
+void SystemStatsMonitor::persistChargeLimit(int limit) {
+    // Persist to Robust System Service Config
+    QFile conf(SysRoot::path("/etc/asus_battery_limit.conf"));
+    if (conf.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        QTextStream confOut(&conf);
+        confOut << limit;
+        conf.close();
     }
+    
+    // Update QSettings
+    QSettings settings("AsusTuf", "FanControl");
+    settings.setValue("ChargeLimit", limit);
+    
+    // Persist to asusd config (Secondary Backup)
+    updateAsusdChargeLimit(limit);
+    
+    // Force Immediate Enforcement
+    enforceChargeLimit();
 }
 
 void SystemStatsMonitor::updateAsusdChargeLimit(int limit) {
     // Patch /etc/asusd/asusd.ron
     // Note: This file is owned by root, so writing requires polkit (running as root).
-    QFile f("/etc/asusd/asusd.ron");
+    QFile f(SysRoot::path("/etc/asusd/asusd.ron"));
     if (!f.open(QIODevice::ReadWrite | QIODevice::Text)) {
         qWarning() << "Could not open asusd.ron for writing (permission denied?)";
         return;
@@ -622,8 +654,7 @@ void SystemStatsMonitor::updateAsusdChargeLimit(int limit) {
 
 void SystemStatsMonitor::enforceChargeLimit() {
     // 1. Read actual current kernel limit
-    QString batPath = "/sys/class/power_supply/BAT1/charge_control_end_threshold";
-    if (!QFile::exists(batPath)) batPath = "/sys/class/power_supply/BAT0/charge_control_end_threshold";
+    QString batPath = batteryPath("charge_control_end_threshold");
     
     int currentKernelLimit = -1;
     QFile f(batPath);
@@ -635,16 +666,15 @@ void SystemStatsMonitor::enforceChargeLimit() {
     // 2. Mismatch Logic
     // If the kernel value is DIFFERENT from our target, RE-APPLY.
     // Also, if we are ABOVE limit and still charging, try RE-APPLYING to force stop.
-    bool needsEnforcement = (currentKernelLimit != m_chargeLimit);
+    // (Not while a new limit is still being applied: that write would be
+    // replaced by this one and never persisted.)
+    bool needsEnforcement = (currentKernelLimit != m_chargeLimit) && !m_chargeLimitWriting;
     
     if (needsEnforcement) {
-        // Force Write to Sysfs (Direct "Iron-Fist" Approach)
-        if (f.open(QIODevice::WriteOnly | QIODevice::Text)) {
-            QTextStream out(&f);
-            out << m_chargeLimit;
-            f.close();
-            // qDebug() << "Enforcement: Re-applied limit of" << m_chargeLimit << "was" << currentKernelLimit;
-        }
+        // Force Write to Sysfs (Direct "Iron-Fist" Approach), queued
+        HardwareWriteQueue::instance().submit(HardwareWriteQueue::ChargeThreshold, batPath,
+                                              QString::number(m_chargeLimit));
+        // qDebug() << "Enforcement: Re-applied limit of" << m_chargeLimit << "was" << currentKernelLimit;
     }
 }
 
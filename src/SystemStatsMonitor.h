@@ -9,7 +9,6 @@
 #include <QDebug>
 #include <QProcess>
 #include <QRegularExpression>
-#include <QStorageInfo>
 #include <QVariantList>
 #include <QJsonDocument>
 #include <QJsonObject>
@@ -17,73 +16,179 @@
 #include <QVariantMap>
 #include <QThread>
 #include "MtpWorker.h"
+#include "ProcStatParser.h"
+#include "CpuCoreModel.h"
+#include "NetworkSampler.h"
+#include "NetworkInterfaceModel.h"
+#include "MountWatcher.h"
+#include "SensorHub.h"
+#include "MetricHistory.h"
+#include "TelemetryHistory.h"
+#include "TelemetryJournal.h"
+#include "TelemetryArchive.h"
+#include "TelemetryQuery.h"
+#include "WindowedStats.h"
+#include "StatsPublisher.h"
 
 class SystemStatsMonitor : public QObject
 {
     Q_OBJECT
-    Q_PROPERTY(double cpuFreq READ cpuFreq NOTIFY statsChanged)
-    Q_PROPERTY(double memoryUsage READ memoryUsage NOTIFY statsChanged)
-    Q_PROPERTY(double cpuUsage READ cpuUsage NOTIFY statsChanged)
-    Q_PROPERTY(double gpuFreq READ gpuFreq NOTIFY statsChanged)
-    Q_PROPERTY(double gpuUsage READ gpuUsage NOTIFY statsChanged)
-    Q_PROPERTY(double diskUsage READ diskUsage NOTIFY statsChanged)
-    Q_PROPERTY(double netDown READ netDown NOTIFY statsChanged)
-    Q_PROPERTY(double netUp READ netUp NOTIFY statsChanged)
-    Q_PROPERTY(QString diskText READ diskText NOTIFY statsChanged)
-    Q_PROPERTY(QVariantList diskPartitions READ diskPartitions NOTIFY statsChanged)
+    // Each group has its own signal, emitted at most once per sampling pass
+    // and only when a value moved by more than its deadband (see below)
+    Q_PROPERTY(double cpuFreq READ cpuFreq NOTIFY cpuChanged)
+    Q_PROPERTY(double cpuUsage READ cpuUsage NOTIFY cpuChanged)
+    Q_PROPERTY(double memoryUsage READ memoryUsage NOTIFY memoryChanged)
+    Q_PROPERTY(double gpuFreq READ gpuFreq NOTIFY gpuChanged)
+    Q_PROPERTY(double gpuUsage READ gpuUsage NOTIFY gpuChanged)
+    Q_PROPERTY(double netDown READ netDown NOTIFY networkChanged)
+    Q_PROPERTY(double netUp READ netUp NOTIFY networkChanged)
+    Q_PROPERTY(double diskUsage READ diskUsage NOTIFY disksChanged)
+    Q_PROPERTY(QString diskText READ diskText NOTIFY disksChanged)
+    Q_PROPERTY(QVariantList diskPartitions READ diskPartitions NOTIFY disksChanged)
+
+    // Smallest change worth a notification: percentage points for the
+    // usages, MHz for frequencies, KB/s for network rates. Defaults match
+    // the precision the dashboard displays.
+    Q_PROPERTY(double usageDeadband READ usageDeadband WRITE setUsageDeadband NOTIFY deadbandsChanged)
+    Q_PROPERTY(double freqDeadband READ freqDeadband WRITE setFreqDeadband NOTIFY deadbandsChanged)
+    Q_PROPERTY(double rateDeadband READ rateDeadband WRITE setRateDeadband NOTIFY deadbandsChanged)
+
+    // Per-core utilisation (roles: core, usage, user, system, iowait, irq, steal, online)
+    Q_PROPERTY(QAbstractItemModel *cpuCores READ cpuCores CONSTANT)
+
+    // Per-interface throughput (roles: name, rxRate, txRate, rxBytes, txBytes, present)
+    Q_PROPERTY(QAbstractItemModel *netInterfaces READ netInterfaces CONSTANT)
+
+    // One-sample-per-second histories for the dashboard graphs
+    Q_PROPERTY(MetricHistory *cpuHistory READ cpuHistory CONSTANT)
+    Q_PROPERTY(MetricHistory *gpuHistory READ gpuHistory CONSTANT)
+    Q_PROPERTY(MetricHistory *ramHistory READ ramHistory CONSTANT)
+    Q_PROPERTY(MetricHistory *diskHistory READ diskHistory CONSTANT)
+    Q_PROPERTY(MetricHistory *tempHistory READ tempHistory CONSTANT)
+    Q_PROPERTY(MetricHistory *netDownHistory READ netDownHistory CONSTANT)
+    Q_PROPERTY(MetricHistory *netUpHistory READ netUpHistory CONSTANT)
+    // Samples kept per history (default 60)
+    Q_PROPERTY(int historyLength READ historyLength WRITE setHistoryLength NOTIFY historyLengthChanged)
+    // Same metrics over hours and days (1 s / 10 s / 1 min tiers, LTTB queries)
+    Q_PROPERTY(TelemetryHistory *telemetry READ telemetry CONSTANT)
+    // Weeks of archived samples, queried off the GUI thread (query() / queryFinished)
+    Q_PROPERTY(TelemetryQuery *archive READ archive CONSTANT)
+    // Sliding-window min/max/mean/p50/p95 per metric (windowSeconds, default 300)
+    Q_PROPERTY(WindowedStats *cpuStats READ cpuStats CONSTANT)
+    Q_PROPERTY(WindowedStats *gpuStats READ gpuStats CONSTANT)
+    Q_PROPERTY(WindowedStats *ramStats READ ramStats CONSTANT)
+    Q_PROPERTY(WindowedStats *diskStats READ diskStats CONSTANT)
+    Q_PROPERTY(WindowedStats *tempStats READ tempStats CONSTANT)
+    Q_PROPERTY(WindowedStats *gpuTempStats READ gpuTempStats CONSTANT)
+    Q_PROPERTY(WindowedStats *cpuFanStats READ cpuFanStats CONSTANT)
+    Q_PROPERTY(WindowedStats *gpuFanStats READ gpuFanStats CONSTANT)
+    Q_PROPERTY(WindowedStats *netDownStats READ netDownStats CONSTANT)
+    Q_PROPERTY(WindowedStats *netUpStats READ netUpStats CONSTANT)
 
     // System Info
     Q_PROPERTY(QString cpuModel READ cpuModel CONSTANT)
-    Q_PROPERTY(QStringList gpuModels READ gpuModels NOTIFY statsChanged)
-    Q_PROPERTY(int batteryPercent READ batteryPercent NOTIFY statsChanged)
-    Q_PROPERTY(bool isCharging READ isCharging NOTIFY statsChanged)
-    Q_PROPERTY(QString batteryState READ batteryState NOTIFY statsChanged)
+    Q_PROPERTY(QStringList gpuModels READ gpuModels CONSTANT)
+    Q_PROPERTY(int batteryPercent READ batteryPercent NOTIFY batteryChanged)
+    Q_PROPERTY(bool isCharging READ isCharging NOTIFY batteryChanged)
+    Q_PROPERTY(QString batteryState READ batteryState NOTIFY batteryChanged)
     Q_PROPERTY(QString osVersion READ osVersion CONSTANT)
     Q_PROPERTY(QString laptopModel READ laptopModel CONSTANT)
     Q_PROPERTY(int chargeLimit READ chargeLimit WRITE setChargeLimit NOTIFY chargeLimitChanged)
 
+    // Diagnostics: syscalls saved per tick by the persistent-descriptor reader
+    Q_PROPERTY(int sysfsSyscallsSaved READ sysfsSyscallsSaved NOTIFY diagnosticsChanged)
+    // Diagnostics: duration of the last disk enumeration, microseconds
+    Q_PROPERTY(int diskScanUs READ diskScanUs NOTIFY diagnosticsChanged)
+
 public:
     explicit SystemStatsMonitor(QObject *parent = nullptr);
     ~SystemStatsMonitor();
     
-    double cpuFreq() const { return m_cpuFreq; }
-    double memoryUsage() const { return m_memoryUsage; }
-    double cpuUsage() const { return m_cpuUsage; }
-    double gpuFreq() const { return m_gpuFreq; }
-    double gpuUsage() const { return m_gpuUsage; }
-    double diskUsage() const { return m_diskUsage; }
-    double netDown() const { return m_netDown; }
-    double netUp() const { return m_netUp; }
+    // Values as last announced, so a read always matches the last signal
+    double cpuFreq() const { return m_publisher.values().cpuFreq; }
+    double memoryUsage() const { return m_publisher.values().memoryUsage; }
+    double cpuUsage() const { return m_publisher.values().cpuUsage; }
+    double gpuFreq() const { return m_publisher.values().gpuFreq; }
+    double gpuUsage() const { return m_publisher.values().gpuUsage; }
+    double diskUsage() const { return m_publisher.values().diskUsage; }
+    double netDown() const { return m_publisher.values().netDown; }
+    double netUp() const { return m_publisher.values().netUp; }
     QString diskText() const { return QString("%1/%2 GB").arg(m_diskUsed, 0, 'f', 0).arg(m_diskTotal, 0, 'f', 0); }
     QVariantList diskPartitions() const { return m_diskPartitions; }
+    QAbstractItemModel *cpuCores() const { return m_cpuCoreModel; }
+    QAbstractItemModel *netInterfaces() const { return m_netInterfaceModel; }
+
+    MetricHistory *cpuHistory() const { return m_cpuHistory; }
+    MetricHistory *gpuHistory() const { return m_gpuHistory; }
+    MetricHistory *ramHistory() const { return m_ramHistory; }
+    MetricHistory *diskHistory() const { return m_diskHistory; }
+    MetricHistory *tempHistory() const { return m_tempHistory; }
+    MetricHistory *netDownHistory() const { return m_netDownHistory; }
+    MetricHistory *netUpHistory() const { return m_netUpHistory; }
+    int historyLength() const { return m_cpuHistory->capacity(); }
+    TelemetryHistory *telemetry() const { return m_telemetry; }
+    TelemetryQuery *archive() const { return m_archiveQuery; }
+    WindowedStats *cpuStats() const { return m_cpuStats; }
+    WindowedStats *gpuStats() const { return m_gpuStats; }
+    WindowedStats *ramStats() const { return m_ramStats; }
+    WindowedStats *diskStats() const { return m_diskStats; }
+    WindowedStats *tempStats() const { return m_tempStats; }
+    WindowedStats *gpuTempStats() const { return m_gpuTempStats; }
+    WindowedStats *cpuFanStats() const { return m_cpuFanStats; }
+    WindowedStats *gpuFanStats() const { return m_gpuFanStats; }
+    WindowedStats *netDownStats() const { return m_netDownStats; }
+    WindowedStats *netUpStats() const { return m_netUpStats; }
+    void setHistoryLength(int length);
+
+    double usageDeadband() const { return m_publisher.usageDeadband(); }
+    double freqDeadband() const { return m_publisher.freqDeadband(); }
+    double rateDeadband() const { return m_publisher.rateDeadband(); }
+    void setUsageDeadband(double deadband);
+    void setFreqDeadband(double deadband);
+    void setRateDeadband(double deadband);
+
+    // Sampling passes and change signals emitted since startup, e.g.
+    // { passes: 1200, cpuChanged: 1130, batteryChanged: 2, ... }. Before the
+    // split every pass emitted one statsChanged for all bindings.
+    Q_INVOKABLE QVariantMap notificationCounts() const;
 
     // System Info Getters
     QString cpuModel() const { return m_cpuModel; }
     QStringList gpuModels() const { return m_gpuModels; }
-    int batteryPercent() const { return m_batteryPercent; }
-    bool isCharging() const { return m_isCharging; }
-    QString batteryState() const { return m_batteryState; }
+    int batteryPercent() const { return m_publisher.values().batteryPercent; }
+    bool isCharging() const { return m_publisher.values().batteryState == SensorSnapshot::BatteryCharging; }
+    QString batteryState() const;
     QString osVersion() const { return m_osVersion; }
     QString laptopModel() const { return m_laptopModel; }
     int chargeLimit() const { return m_chargeLimit; }
+    int sysfsSyscallsSaved() const { return m_publisher.values().sysfsSyscallsSaved; }
+    int diskScanUs() const { return m_diskScanUs; }
 
 public slots:
-    void updateStats();
-    void updateSlowStats();  // Heavy I/O operations (disk, network)
+    void updateStats();      // One call per hub sampling pass
+    void updateSlowStats();  // Network rates
+    void refreshDisks();     // Disk list (hotplug events + slow free-space refresh)
     void setChargeLimit(int limit);
     void openFileManager(const QString &mountPoint, const QString &deviceNode = QString());
     void onMtpDevicesFound(QVariantList devices);
 
 signals:
-    void statsChanged();
+    void cpuChanged();
+    void gpuChanged();
+    void memoryChanged();
+    void networkChanged();
+    void disksChanged();
+    void batteryChanged();
+    void diagnosticsChanged();
+    void deadbandsChanged();
     void chargeLimitChanged();
+    void historyLengthChanged();
 
 private:
-    double m_cpuFreq = 0;
-    double m_memoryUsage = 0;
-    double m_cpuUsage = 0;
-    double m_gpuFreq = 0;
-    double m_gpuUsage = 0;
+    // Fast stats (CPU, memory, GPU, battery) are sampled by the shared hub
+    SensorHub *m_sensorHub;
+    QVector<CpuLoad> m_cores;  // Scratch copy for the per-core model
+
     double m_diskUsage = 0;
     double m_diskUsed = 0;
     double m_diskTotal = 0;
@@ -91,34 +196,67 @@ private:
     double m_netUp = 0;
     QVariantList m_diskPartitions;
 
+    // What QML was last told; the sampled values above and in the hub's
+    // snapshot only get there once they move past a deadband
+    StatsPublisher m_publisher;
+
+    // Emits the signal of each StatsPublisher group set in groups
+    void emitChanges(int groups);
+
     // System Info Members
     QString m_cpuModel;
     QStringList m_gpuModels;
-    int m_batteryPercent = 0;
-    bool m_isCharging = false;
-    QString m_batteryState;
     QString m_osVersion;
     QString m_laptopModel;
     int m_chargeLimit = 100;
+    int m_diskScanUs = 0;
+
+    // power_supply directory of the main battery (BAT1, else BAT0)
+    QString m_batteryDir;
+    QString batteryPath(const char *attribute) const { return m_batteryDir + "/" + attribute; }
 
+    void persistChargeLimit(int limit);   // After the kernel took it
     void updateAsusdChargeLimit(int limit);
     int readChargeLimit();
 
     void readSystemInfo();
-    void readBattery();
     
-    QTimer *m_timer;
-    QTimer *m_slowTimer;  // Slow timer for heavy I/O (disk, network)
+    // SamplingScheduler task ids
+    int m_slowStatsTask = -1;  // Slow pass for network rates
+    int m_diskTask = -1;       // Disk free-space refresh
+    int m_enforcementTask = -1;
     
-    long long m_prevIdle = 0;
-    long long m_prevTotal = 0;
-    long long m_prevRx = 0;
-    long long m_prevTx = 0;
-
-    void readCpuFreq();
-    void readMemoryUsage();
-    void readCpuUsage();
-    void readGpuStats();
+    CpuCoreModel *m_cpuCoreModel;
+    NetworkSampler m_netSampler;
+    NetworkInterfaceModel *m_netInterfaceModel;
+
+    MetricHistory *m_cpuHistory;
+    MetricHistory *m_gpuHistory;
+    MetricHistory *m_ramHistory;
+    MetricHistory *m_diskHistory;
+    MetricHistory *m_tempHistory;
+    MetricHistory *m_netDownHistory;
+    MetricHistory *m_netUpHistory;
+    TelemetryHistory *m_telemetry;
+    TelemetryJournal m_journal;    // Persists the per-second samples across restarts
+    TelemetryArchive m_archive;    // Compressed weeks of samples, fed from the journal
+    TelemetryQuery *m_archiveQuery;
+    WindowedStats *m_cpuStats;
+    WindowedStats *m_gpuStats;
+    WindowedStats *m_ramStats;
+    WindowedStats *m_diskStats;
+    WindowedStats *m_tempStats;
+    WindowedStats *m_gpuTempStats;
+    WindowedStats *m_cpuFanStats;
+    WindowedStats *m_gpuFanStats;
+    WindowedStats *m_netDownStats;
+    WindowedStats *m_netUpStats;
+    qint64 m_lastHistoryMs = 0;    // Snapshot time of the last appended sample
+
+    void appendHistory(const SensorSnapshot &snapshot);
+    void appendStats(const TelemetryJournal::Record &record);
+    void seedHistoryFromJournal();
+
     void readDiskUsage();
     
     QThread *m_mtpThread;
@@ -127,22 +265,18 @@ private:
 
     void readNetworkUsage();
 
-    QTimer *m_enforcementTimer;
     void enforceChargeLimit();
 
-    // Fix: Persist processes to avoid "Destroyed while running" warnings
-    QProcess *m_gpuProcess;
-    
     // Fix: Debounce battery limit to prevent crashes during sliding
     QTimer *m_limitDebounceTimer;
     int m_pendingChargeLimit = -1;
+    bool m_chargeLimitWriting = false;  // Applied limit still in the write queue
     
-    // Cache for volume count-based change detection (fast)
-    int m_cachedVolumeCount = 0;
+    // Mount table / block hotplug events
+    MountWatcher *m_mountWatcher = nullptr;
     
 private slots:
     void applyPendingChargeLimit();
-    void onGpuProcessFinished(int exitCode, QProcess::ExitStatus status);
 };
 
 #endif // SYSTEMSTATSMONITOR_H
@@ -0,0 +1,216 @@
+#include "TelemetryArchive.h"
+
+#include <QDate>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <algorithm>
+#include <cstring>
+
+static const quint32 kBlockMagic = 0x31424c54;  // "TLB1"
+static const qint64 kDayMs = 86400000;
+static const qint64 kHeaderBytes = 2 * sizeof(quint32) + sizeof(TelemetryBlock::Summary);
+
+static quint32 fnv1a(const char *data, qint64 size, quint32 hash = 2166136261u)
+{
+    for (qint64 i = 0; i < size; ++i) {
+        hash = (hash ^ static_cast<uchar>(data[i])) * 16777619u;
+    }
+    return hash;
+}
+
+static qint64 dayOf(qint64 timestampMs)
+{
+    return timestampMs / kDayMs;
+}
+
+TelemetryArchive::TelemetryArchive(const QString &dir, int retentionDays)
+    : m_dir(dir)
+    , m_retentionDays(qMax(1, retentionDays))
+{
+    QDir().mkpath(m_dir);
+    loadIndex();
+}
+
+TelemetryArchive::~TelemetryArchive()
+{
+    flush();
+}
+
+QString TelemetryArchive::defaultDir()
+{
+    return QFileInfo(TelemetryJournal::defaultPath()).absolutePath() + "/archive";
+}
+
+QString TelemetryArchive::segmentPath(qint64 timestampMs) const
+{
+    // One segment per UTC day, so retention is a file delete
+    return m_dir + "/" + QDate(1970, 1, 1).addDays(dayOf(timestampMs)).toString("yyyyMMdd") + ".tlb";
+}
+
+void TelemetryArchive::loadIndex()
+{
+    const QStringList segments = QDir(m_dir).entryList(QStringList() << "*.tlb", QDir::Files, QDir::Name);
+    for (const QString &name : segments) {
+        indexSegment(m_dir + "/" + name);
+    }
+    if (!m_blocks.isEmpty()) {
+        m_lastMs = m_blocks.last().summary.endMs;
+    }
+    applyRetention(QDateTime::currentMSecsSinceEpoch());
+
+    qInfo() << "TelemetryArchive:" << m_blocks.size() << "blocks in" << segments.size()
+            << "segments," << sizeBytes() / 1024 << "KiB at" << m_dir;
+}
+
+void TelemetryArchive::indexSegment(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadWrite)) {
+        qWarning() << "TelemetryArchive: cannot open" << path;
+        return;
+    }
+
+    const qint64 size = file.size();
+    qint64 pos = 0;
+    while (pos < size) {
+        quint32 header[2];
+        BlockRef ref;
+        const bool complete = size - pos >= kHeaderBytes + static_cast<qint64>(sizeof(quint32))
+                              && file.seek(pos)
+                              && file.read(reinterpret_cast<char *>(header), sizeof(header)) == sizeof(header)
+                              && header[0] == kBlockMagic
+                              && file.read(reinterpret_cast<char *>(&ref.summary), sizeof(ref.summary)) == sizeof(ref.summary)
+                              && pos + kHeaderBytes + header[1] + static_cast<qint64>(sizeof(quint32)) <= size;
+        if (!complete) {
+            // Torn write from a crash (or garbage): keep what came before it
+            qWarning() << "TelemetryArchive: truncating" << path << "at" << pos << "of" << size << "bytes";
+            file.resize(pos);
+            break;
+        }
+
+        ref.file = path;
+        ref.payloadOffset = pos + kHeaderBytes;
+        ref.payloadSize = header[1];
+        m_blocks.append(ref);
+        pos += kHeaderBytes + header[1] + sizeof(quint32);
+    }
+}
+
+bool TelemetryArchive::readPayload(const BlockRef &block, QByteArray *payload)
+{
+    QFile file(block.file);
+    if (!file.open(QIODevice::ReadOnly)) return false;
+
+    // Checksum covers the summary and the payload
+    const qint64 start = block.payloadOffset - static_cast<qint64>(sizeof(TelemetryBlock::Summary));
+    if (!file.seek(start)) return false;
+    const QByteArray raw = file.read(sizeof(TelemetryBlock::Summary) + block.payloadSize + sizeof(quint32));
+    if (raw.size() != static_cast<int>(sizeof(TelemetryBlock::Summary) + block.payloadSize + sizeof(quint32))) {
+        return false;
+    }
+
+    quint32 stored;
+    memcpy(&stored, raw.constData() + raw.size() - sizeof(quint32), sizeof(stored));
+    if (fnv1a(raw.constData(), raw.size() - sizeof(quint32)) != stored) {
+        qWarning() << "TelemetryArchive: checksum mismatch in" << block.file << "at" << block.payloadOffset;
+        return false;
+    }
+
+    *payload = raw.mid(sizeof(TelemetryBlock::Summary), block.payloadSize);
+    return true;
+}
+
+void TelemetryArchive::pending(TelemetryBlock::Summary *summary, QByteArray *payload) const
+{
+    *summary = m_encoder.summary();
+    *payload = m_encoder.payload();
+}
+
+void TelemetryArchive::append(const TelemetryJournal::Record &record)
+{
+    if (record.timestampMs <= m_lastMs) return;
+
+    if (!m_encoder.isEmpty()) {
+        const TelemetryBlock::Summary &pending = m_encoder.summary();
+        if (record.timestampMs - pending.startMs >= TelemetryBlock::kBlockSpanMs
+            || dayOf(record.timestampMs) != dayOf(pending.startMs)) {
+            seal();
+        }
+    }
+
+    m_encoder.append(record);
+    m_lastMs = record.timestampMs;
+}
+
+void TelemetryArchive::flush()
+{
+    seal();
+}
+
+void TelemetryArchive::seal()
+{
+    if (m_encoder.isEmpty()) return;
+
+    const TelemetryBlock::Summary summary = m_encoder.summary();
+    const QByteArray payload = m_encoder.finish();
+
+    const quint32 header[2] = { kBlockMagic, static_cast<quint32>(payload.size()) };
+    QByteArray block;
+    block.reserve(kHeaderBytes + payload.size() + sizeof(quint32));
+    block.append(reinterpret_cast<const char *>(header), sizeof(header));
+    block.append(reinterpret_cast<const char *>(&summary), sizeof(summary));
+    block.append(payload);
+    const quint32 checksum = fnv1a(block.constData() + sizeof(header), block.size() - sizeof(header));
+    block.append(reinterpret_cast<const char *>(&checksum), sizeof(checksum));
+
+    const QString path = segmentPath(summary.startMs);
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        qWarning() << "TelemetryArchive: cannot append to" << path;
+        return;
+    }
+    const qint64 offset = file.size();
+    if (file.write(block) != block.size()) {
+        qWarning() << "TelemetryArchive: short write to" << path;
+        file.resize(offset);
+        return;
+    }
+
+    BlockRef ref;
+    ref.summary = summary;
+    ref.file = path;
+    ref.payloadOffset = offset + kHeaderBytes;
+    ref.payloadSize = static_cast<quint32>(payload.size());
+    m_blocks.append(ref);
+
+    applyRetention(summary.endMs);
+}
+
+void TelemetryArchive::applyRetention(qint64 nowMs)
+{
+    const QDate cutoff = QDate(1970, 1, 1).addDays(dayOf(nowMs) - m_retentionDays);
+    const QStringList segments = QDir(m_dir).entryList(QStringList() << "*.tlb", QDir::Files, QDir::Name);
+    for (const QString &name : segments) {
+        const QDate day = QDate::fromString(name.left(8), "yyyyMMdd");
+        if (!day.isValid() || day >= cutoff) continue;
+
+        const QString path = m_dir + "/" + name;
+        QFile::remove(path);
+        m_blocks.erase(std::remove_if(m_blocks.begin(), m_blocks.end(),
+                                      [&path](const BlockRef &b) { return b.file == path; }),
+                       m_blocks.end());
+    }
+}
+
+qint64 TelemetryArchive::sizeBytes() const
+{
+    qint64 bytes = 0;
+    const QStringList segments = QDir(m_dir).entryList(QStringList() << "*.tlb", QDir::Files, QDir::Name);
+    for (const QString &name : segments) {
+        bytes += QFileInfo(m_dir + "/" + name).size();
+    }
+    return bytes;
+}
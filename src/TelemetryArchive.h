@@ -0,0 +1,78 @@
+#ifndef TELEMETRYARCHIVE_H
+#define TELEMETRYARCHIVE_H
+
+#include <QString>
+#include <QVector>
+#include <QByteArray>
+#include "TelemetryBlock.h"
+
+// Multi-week telemetry store made of compressed TelemetryBlocks.
+//
+// Records are streamed into an in-memory encoder; once a block spans two
+// hours (or the UTC day changes) it is sealed and appended to that day's
+// segment file, one write() per block:
+//
+//   <dir>/YYYYMMDD.tlb:  { magic, payload size, Summary, payload, checksum }*
+//
+// Whole segment files past the retention period are deleted. On open the
+// segments are walked header by header (payloads are skipped, not read) to
+// build an in-memory block index; a torn block at the end of a segment is
+// truncated away. The block still being encoded is lost on a crash, but
+// everything after lastTimestampMs() is still in the TelemetryJournal and
+// gets re-appended from there on startup.
+class TelemetryArchive
+{
+public:
+    struct BlockRef {
+        TelemetryBlock::Summary summary;
+        QString file;
+        qint64 payloadOffset;
+        quint32 payloadSize;
+    };
+
+    static const int kDefaultRetentionDays = 28;
+
+    explicit TelemetryArchive(const QString &dir = defaultDir(), int retentionDays = kDefaultRetentionDays);
+    ~TelemetryArchive();
+
+    // Records must arrive in time order; older ones are ignored
+    void append(const TelemetryJournal::Record &record);
+
+    // Seal the block being encoded (also done by the destructor)
+    void flush();
+
+    // Newest record already in the archive, sealed or pending (0 = none)
+    qint64 lastTimestampMs() const { return m_lastMs; }
+
+    // Sealed blocks, oldest first
+    const QVector<BlockRef> &blocks() const { return m_blocks; }
+
+    // The block still being encoded, as if it were sealed now
+    // (summary.count == 0 when there is none)
+    void pending(TelemetryBlock::Summary *summary, QByteArray *payload) const;
+
+    // Payload of a sealed block, verified against its checksum
+    static bool readPayload(const BlockRef &block, QByteArray *payload);
+
+    qint64 sizeBytes() const;
+
+    // "archive" next to the journal
+    static QString defaultDir();
+
+private:
+    Q_DISABLE_COPY(TelemetryArchive)
+
+    void loadIndex();
+    void indexSegment(const QString &path);
+    void seal();
+    void applyRetention(qint64 nowMs);
+    QString segmentPath(qint64 timestampMs) const;
+
+    QString m_dir;
+    int m_retentionDays;
+    QVector<BlockRef> m_blocks;
+    TelemetryBlock::Encoder m_encoder;
+    qint64 m_lastMs = 0;
+};
+
+#endif // TELEMETRYARCHIVE_H
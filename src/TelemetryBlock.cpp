@@ -0,0 +1,346 @@
+#include "TelemetryBlock.h"
+
+#include <cfloat>
+#include <cstring>
+
+namespace TelemetryBlock
+{
+
+typedef TelemetryJournal::Record Record;
+
+static const int kFloatChannels = 8;
+static const int kIntChannels = 7;
+
+static float Record::*const kFloatFields[kFloatChannels] = {
+    &Record::cpuUsage, &Record::cpuFreq, &Record::memoryUsage, &Record::gpuUsage,
+    &Record::gpuFreq, &Record::diskUsage, &Record::netDown, &Record::netUp,
+};
+
+static qint32 intField(const Record &r, int channel)
+{
+    switch (channel) {
+    case 0: return r.cpuTemp;
+    case 1: return r.gpuTemp;
+    case 2: return r.cpuFanRpm;
+    case 3: return r.gpuFanRpm;
+    case 4: return r.thermalPolicy;
+    case 5: return r.batteryPercent;
+    default: return r.batteryState;
+    }
+}
+
+static void setIntField(Record *r, int channel, qint32 value)
+{
+    switch (channel) {
+    case 0: r->cpuTemp = static_cast<qint16>(value); break;
+    case 1: r->gpuTemp = static_cast<qint16>(value); break;
+    case 2: r->cpuFanRpm = static_cast<quint16>(value); break;
+    case 3: r->gpuFanRpm = static_cast<quint16>(value); break;
+    case 4: r->thermalPolicy = static_cast<qint8>(value); break;
+    case 5: r->batteryPercent = static_cast<quint8>(value); break;
+    default: r->batteryState = static_cast<quint8>(value); break;
+    }
+}
+
+double metricValue(const Record &r, Metric metric)
+{
+    switch (metric) {
+    case CpuUsage: return r.cpuUsage;
+    case CpuFreq: return r.cpuFreq;
+    case MemoryUsage: return r.memoryUsage;
+    case GpuUsage: return r.gpuUsage;
+    case GpuFreq: return r.gpuFreq;
+    case DiskUsage: return r.diskUsage;
+    case NetDown: return r.netDown;
+    case NetUp: return r.netUp;
+    case CpuTemp: return r.cpuTemp;
+    case GpuTemp: return r.gpuTemp;
+    case CpuFanRpm: return r.cpuFanRpm;
+    case GpuFanRpm: return r.gpuFanRpm;
+    case ThermalPolicy: return r.thermalPolicy;
+    case BatteryPercent: return r.batteryPercent;
+    case MetricCount: break;
+    }
+    return 0;
+}
+
+static quint32 floatBits(float f)
+{
+    quint32 bits;
+    memcpy(&bits, &f, sizeof(bits));
+    return bits;
+}
+
+static float bitsFloat(quint32 bits)
+{
+    float f;
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+// Sign-extend the low `bits` bits of value
+static qint64 signExtend(quint64 value, int bits)
+{
+    const quint64 sign = 1ULL << (bits - 1);
+    return static_cast<qint64>((value ^ sign) - sign);
+}
+
+// ---- Bit I/O ----
+
+void BitWriter::write(quint64 value, int bits)
+{
+    // At most 7 bits are pending, so up to 32 new bits always fit in m_acc
+    while (bits > 32) {
+        bits -= 32;
+        write(value >> bits, 32);
+    }
+    m_acc = (m_acc << bits) | (value & ((1ULL << bits) - 1));
+    m_pending += bits;
+    while (m_pending >= 8) {
+        m_pending -= 8;
+        m_bytes.append(static_cast<char>(m_acc >> m_pending));
+    }
+    m_acc &= (1ULL << m_pending) - 1;
+}
+
+QByteArray BitWriter::finish()
+{
+    if (m_pending > 0) {
+        m_bytes.append(static_cast<char>(m_acc << (8 - m_pending)));
+    }
+    QByteArray out = m_bytes;
+    m_bytes = QByteArray();
+    m_acc = 0;
+    m_pending = 0;
+    return out;
+}
+
+QByteArray BitWriter::peek() const
+{
+    QByteArray out = m_bytes;
+    if (m_pending > 0) {
+        out.append(static_cast<char>(m_acc << (8 - m_pending)));
+    }
+    return out;
+}
+
+quint64 BitReader::read(int bits)
+{
+    quint64 value = 0;
+    while (bits > 0) {
+        if (m_byte >= m_size) {
+            m_failed = true;
+            return 0;
+        }
+        const int avail = 8 - m_bit;
+        const int take = qMin(avail, bits);
+        const quint64 chunk = (m_data[m_byte] >> (avail - take)) & ((1u << take) - 1);
+        value = (value << take) | chunk;
+        m_bit += take;
+        if (m_bit == 8) {
+            m_bit = 0;
+            ++m_byte;
+        }
+        bits -= take;
+    }
+    return value;
+}
+
+// ---- Channel codecs ----
+
+static void writeTimestamp(BitWriter &w, ChannelState &s, qint64 timestamp)
+{
+    const qint64 delta = timestamp - s.prevTimestamp;
+    const qint64 dod = delta - s.prevDelta;
+    s.prevTimestamp = timestamp;
+    s.prevDelta = delta;
+
+    if (dod == 0) {
+        w.write(0, 1);
+    } else if (dod >= -64 && dod <= 63) {
+        w.write(0b10, 2);
+        w.write(static_cast<quint64>(dod), 7);
+    } else if (dod >= -256 && dod <= 255) {
+        w.write(0b110, 3);
+        w.write(static_cast<quint64>(dod), 9);
+    } else if (dod >= -2048 && dod <= 2047) {
+        w.write(0b1110, 4);
+        w.write(static_cast<quint64>(dod), 12);
+    } else {
+        w.write(0b1111, 4);
+        w.write(static_cast<quint64>(dod), 32);
+    }
+}
+
+static qint64 readTimestamp(BitReader &r, ChannelState &s)
+{
+    qint64 dod = 0;
+    if (r.read(1)) {
+        if (!r.read(1)) dod = signExtend(r.read(7), 7);
+        else if (!r.read(1)) dod = signExtend(r.read(9), 9);
+        else if (!r.read(1)) dod = signExtend(r.read(12), 12);
+        else dod = signExtend(r.read(32), 32);
+    }
+    s.prevDelta += dod;
+    s.prevTimestamp += s.prevDelta;
+    return s.prevTimestamp;
+}
+
+static void writeFloat(BitWriter &w, ChannelState &s, int channel, float value)
+{
+    const quint32 bits = floatBits(value);
+    const quint32 x = bits ^ s.prevFloat[channel];
+    s.prevFloat[channel] = bits;
+
+    if (x == 0) {
+        w.write(0, 1);
+        return;
+    }
+
+    const int leading = qMin(31, __builtin_clz(x));
+    const int trailing = __builtin_ctz(x);
+    const int prevLeading = s.leading[channel];
+    const int prevTrailing = s.trailing[channel];
+
+    if (prevLeading >= 0 && leading >= prevLeading && trailing >= prevTrailing) {
+        // Fits the previous window: no need to repeat its position
+        w.write(0b10, 2);
+        w.write(x >> prevTrailing, 32 - prevLeading - prevTrailing);
+    } else {
+        const int length = 32 - leading - trailing;
+        w.write(0b11, 2);
+        w.write(static_cast<quint64>(leading), 5);
+        w.write(static_cast<quint64>(length - 1), 5);
+        w.write(x >> trailing, length);
+        s.leading[channel] = leading;
+        s.trailing[channel] = trailing;
+    }
+}
+
+static float readFloat(BitReader &r, ChannelState &s, int channel)
+{
+    if (r.read(1)) {
+        quint32 x;
+        if (!r.read(1)) {
+            const int leading = qMax(0, s.leading[channel]);
+            const int trailing = s.trailing[channel];
+            x = static_cast<quint32>(r.read(32 - leading - trailing)) << trailing;
+        } else {
+            const int leading = static_cast<int>(r.read(5));
+            const int length = static_cast<int>(r.read(5)) + 1;
+            const int trailing = qMax(0, 32 - leading - length);
+            x = static_cast<quint32>(r.read(length)) << trailing;
+            s.leading[channel] = leading;
+            s.trailing[channel] = trailing;
+        }
+        s.prevFloat[channel] ^= x;
+    }
+    return bitsFloat(s.prevFloat[channel]);
+}
+
+static void writeInt(BitWriter &w, ChannelState &s, int channel, qint32 value)
+{
+    const qint32 delta = value - s.prevInt[channel];
+    s.prevInt[channel] = value;
+    const quint32 zz = (static_cast<quint32>(delta) << 1) ^ static_cast<quint32>(delta >> 31);
+
+    if (zz == 0) {
+        w.write(0, 1);
+    } else if (zz < (1u << 4)) {
+        w.write(0b10, 2);
+        w.write(zz, 4);
+    } else if (zz < (1u << 8)) {
+        w.write(0b110, 3);
+        w.write(zz, 8);
+    } else if (zz < (1u << 16)) {
+        w.write(0b1110, 4);
+        w.write(zz, 16);
+    } else {
+        w.write(0b1111, 4);
+        w.write(zz, 32);
+    }
+}
+
+static qint32 readInt(BitReader &r, ChannelState &s, int channel)
+{
+    quint32 zz = 0;
+    if (r.read(1)) {
+        if (!r.read(1)) zz = static_cast<quint32>(r.read(4));
+        else if (!r.read(1)) zz = static_cast<quint32>(r.read(8));
+        else if (!r.read(1)) zz = static_cast<quint32>(r.read(16));
+        else zz = static_cast<quint32>(r.read(32));
+    }
+    const qint32 delta = static_cast<qint32>(zz >> 1) ^ -static_cast<qint32>(zz & 1);
+    s.prevInt[channel] += delta;
+    return s.prevInt[channel];
+}
+
+// ---- Encoder / decoder ----
+
+void Encoder::reset()
+{
+    m_state = ChannelState();
+    memset(&m_summary, 0, sizeof(m_summary));
+    for (int m = 0; m < MetricCount; ++m) {
+        m_summary.min[m] = FLT_MAX;
+        m_summary.max[m] = -FLT_MAX;
+    }
+}
+
+void Encoder::append(const Record &record)
+{
+    if (m_summary.count == 0) {
+        m_summary.startMs = record.timestampMs;
+        m_state.prevTimestamp = record.timestampMs;
+    }
+    m_summary.endMs = record.timestampMs;
+    ++m_summary.count;
+
+    writeTimestamp(m_bits, m_state, record.timestampMs);
+    for (int c = 0; c < kFloatChannels; ++c) {
+        writeFloat(m_bits, m_state, c, record.*kFloatFields[c]);
+    }
+    for (int c = 0; c < kIntChannels; ++c) {
+        writeInt(m_bits, m_state, c, intField(record, c));
+    }
+
+    for (int m = 0; m < MetricCount; ++m) {
+        const double v = metricValue(record, static_cast<Metric>(m));
+        m_summary.min[m] = qMin(m_summary.min[m], static_cast<float>(v));
+        m_summary.max[m] = qMax(m_summary.max[m], static_cast<float>(v));
+        m_summary.sum[m] += v;
+    }
+}
+
+QByteArray Encoder::finish()
+{
+    const QByteArray payload = m_bits.finish();
+    reset();
+    return payload;
+}
+
+Decoder::Decoder(const Summary &summary, const QByteArray &payload)
+    : m_bits(payload.constData(), payload.size())
+    , m_remaining(summary.count)
+{
+    m_state.prevTimestamp = summary.startMs;
+}
+
+bool Decoder::next(Record *record)
+{
+    if (m_remaining == 0 || m_bits.failed()) return false;
+
+    memset(record, 0, sizeof(*record));
+    record->timestampMs = readTimestamp(m_bits, m_state);
+    for (int c = 0; c < kFloatChannels; ++c) {
+        record->*kFloatFields[c] = readFloat(m_bits, m_state, c);
+    }
+    for (int c = 0; c < kIntChannels; ++c) {
+        setIntField(record, c, readInt(m_bits, m_state, c));
+    }
+
+    --m_remaining;
+    return !m_bits.failed();
+}
+
+} // namespace TelemetryBlock
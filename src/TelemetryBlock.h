@@ -0,0 +1,136 @@
+#ifndef TELEMETRYBLOCK_H
+#define TELEMETRYBLOCK_H
+
+#include <QByteArray>
+#include <QtGlobal>
+#include "TelemetryJournal.h"
+
+// Compressed block of journal records for long-term storage (Gorilla-style,
+// Pelkonen et al. 2015), one bit stream per block with the channels of each
+// record interleaved:
+//
+//   timestamp   delta-of-delta vs. the previous record:
+//               '0' | '10'+7 | '110'+9 | '1110'+12 | '1111'+32 bits
+//   floats      XOR with the previous value of the channel:
+//               '0' same value | '10' + bits inside the previous
+//               leading/trailing-zero window | '11' + 5 bit leading zeros
+//               + 5 bit length-1 + meaningful bits
+//   integers    zig-zag delta vs. the previous value:
+//               '0' | '10'+4 | '110'+8 | '1110'+16 | '1111'+32 bits
+//
+// Encoding is lossless for the sampled values (the journal's sequence and
+// checksum are not stored; blocks carry their own). Every block carries a fixed-size summary (time
+// bounds, count, per-metric min/max/sum) so queries can skip or answer from
+// it without decoding.
+namespace TelemetryBlock
+{
+    // Metrics a block summarises (batteryState is stored but not summarised)
+    enum Metric {
+        CpuUsage, CpuFreq, MemoryUsage, GpuUsage, GpuFreq, DiskUsage, NetDown, NetUp,
+        CpuTemp, GpuTemp, CpuFanRpm, GpuFanRpm, ThermalPolicy, BatteryPercent,
+        MetricCount
+    };
+
+    double metricValue(const TelemetryJournal::Record &record, Metric metric);
+
+    // Fixed on-disk layout
+    struct Summary {
+        qint64 startMs;
+        qint64 endMs;           // Timestamp of the last record
+        quint32 count;
+        quint32 reserved;
+        float min[MetricCount];
+        float max[MetricCount];
+        double sum[MetricCount];
+    };
+
+    // Aim for about two hours of records per block
+    static const qint64 kBlockSpanMs = 2 * 3600 * 1000;
+
+    class BitWriter
+    {
+    public:
+        void write(quint64 value, int bits);
+        QByteArray finish();
+        // Bytes written so far, last one zero-padded; the writer keeps going
+        QByteArray peek() const;
+        int sizeBits() const { return m_bytes.size() * 8 + m_pending; }
+
+    private:
+        QByteArray m_bytes;
+        quint64 m_acc = 0;
+        int m_pending = 0;      // Bits in m_acc not yet in m_bytes
+    };
+
+    class BitReader
+    {
+    public:
+        BitReader(const char *data, int size) : m_data(reinterpret_cast<const uchar *>(data)), m_size(size) {}
+        quint64 read(int bits);
+        bool atEnd() const { return m_byte >= m_size; }
+        bool failed() const { return m_failed; }
+
+    private:
+        const uchar *m_data;
+        int m_size;
+        int m_byte = 0;
+        int m_bit = 0;          // Bits already consumed of m_data[m_byte]
+        bool m_failed = false;
+    };
+
+    // Per-channel predictor state shared by the encoder and decoder
+    struct ChannelState {
+        qint64 prevTimestamp = 0;
+        qint64 prevDelta = 0;
+        quint32 prevFloat[8] = {};
+        int leading[8];
+        int trailing[8] = {};
+        qint32 prevInt[7] = {};
+
+        ChannelState() { for (int &l : leading) l = -1; }
+    };
+
+    // Streaming encoder: append() records in time order, take the block with
+    // finish(). The first record's timestamp is the block start.
+    class Encoder
+    {
+    public:
+        Encoder() { reset(); }
+
+        void append(const TelemetryJournal::Record &record);
+        bool isEmpty() const { return m_summary.count == 0; }
+        const Summary &summary() const { return m_summary; }
+        int sizeBytes() const { return (m_bits.sizeBits() + 7) / 8; }
+
+        // Returns the payload and starts a new block
+        QByteArray finish();
+
+        // Payload of the records appended so far, without ending the block;
+        // decodes like a finished one with the current summary()
+        QByteArray payload() const { return m_bits.peek(); }
+
+    private:
+        void reset();
+
+        BitWriter m_bits;
+        ChannelState m_state;
+        Summary m_summary;
+    };
+
+    // Streaming decoder over one block's payload (which must outlive it)
+    class Decoder
+    {
+    public:
+        Decoder(const Summary &summary, const QByteArray &payload);
+
+        // False once summary.count records were returned or the payload is corrupt
+        bool next(TelemetryJournal::Record *record);
+
+    private:
+        BitReader m_bits;
+        ChannelState m_state;
+        quint32 m_remaining;
+    };
+}
+
+#endif // TELEMETRYBLOCK_H
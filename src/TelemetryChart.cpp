@@ -0,0 +1,379 @@
+#include "TelemetryChart.h"
+
+#include <QSGNode>
+#include <QSGGeometryNode>
+#include <QSGTransformNode>
+#include <QSGFlatColorMaterial>
+#include <QSGVertexColorMaterial>
+#include <cmath>
+#include <cstring>
+
+// Fill alpha at the bottom edge (the top uses fillOpacity)
+static const float kFillBottomAlpha = 0.02f;
+
+class TelemetryChart::ChartNode : public QSGNode
+{
+public:
+    ChartNode()
+    {
+        grid = makeNode(new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(), 0),
+                        QSGGeometry::DrawLines, new QSGFlatColorMaterial);
+        appendChildNode(grid);
+
+        // Fill and line scroll together under one translation
+        scroll = new QSGTransformNode;
+        appendChildNode(scroll);
+
+        fill = makeNode(new QSGGeometry(QSGGeometry::defaultAttributes_ColoredPoint2D(), 0),
+                        QSGGeometry::DrawTriangleStrip, new QSGVertexColorMaterial);
+        scroll->appendChildNode(fill);
+
+        line = makeNode(new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(), 0),
+                        QSGGeometry::DrawTriangleStrip, new QSGFlatColorMaterial);
+        scroll->appendChildNode(line);
+    }
+
+    QSGGeometryNode *grid;
+    QSGTransformNode *scroll;
+    QSGGeometryNode *fill;
+    QSGGeometryNode *line;
+
+private:
+    static QSGGeometryNode *makeNode(QSGGeometry *geometry, unsigned int mode, QSGMaterial *material)
+    {
+        geometry->setDrawingMode(mode);
+        QSGGeometryNode *node = new QSGGeometryNode;
+        node->setGeometry(geometry);
+        node->setMaterial(material);
+        node->setFlags(QSGNode::OwnsGeometry | QSGNode::OwnsMaterial);
+        return node;
+    }
+};
+
+TelemetryChart::TelemetryChart(QQuickItem *parent)
+    : QQuickItem(parent)
+{
+    setFlag(ItemHasContents, true);
+}
+
+void TelemetryChart::setHistory(MetricHistory *history)
+{
+    if (m_history == history) return;
+
+    if (m_history) disconnect(m_history, nullptr, this, nullptr);
+    m_history = history;
+    if (m_history) {
+        connect(m_history, &MetricHistory::sampleAppended, this, &TelemetryChart::onSampleAppended);
+        connect(m_history, &MetricHistory::capacityChanged, this, &TelemetryChart::onHistoryReset);
+        connect(m_history, &MetricHistory::cleared, this, &TelemetryChart::onHistoryReset);
+        connect(m_history, &QObject::destroyed, this, &TelemetryChart::onHistoryReset);
+    }
+
+    onHistoryReset();
+    emit historyChanged();
+}
+
+void TelemetryChart::setColor(const QColor &color)
+{
+    if (m_color == color) return;
+    m_color = color;
+    m_materialDirty = true;
+    update();
+    emit colorChanged();
+}
+
+void TelemetryChart::setGridColor(const QColor &color)
+{
+    if (m_gridColor == color) return;
+    m_gridColor = color;
+    m_materialDirty = true;
+    update();
+    emit gridColorChanged();
+}
+
+void TelemetryChart::setMaxValue(qreal value)
+{
+    if (qFuzzyCompare(m_maxValue, value)) return;
+    m_maxValue = value;
+    onHistoryReset();
+    emit maxValueChanged();
+}
+
+void TelemetryChart::setAutoScale(bool enabled)
+{
+    if (m_autoScale == enabled) return;
+    m_autoScale = enabled;
+    onHistoryReset();
+    emit autoScaleChanged();
+}
+
+void TelemetryChart::setLineWidth(qreal width)
+{
+    if (qFuzzyCompare(m_lineWidth, width)) return;
+    m_lineWidth = width;
+    m_needsRebuild = true;
+    update();
+    emit lineWidthChanged();
+}
+
+void TelemetryChart::setFillOpacity(qreal opacity)
+{
+    if (qFuzzyCompare(m_fillOpacity, opacity)) return;
+    m_fillOpacity = opacity;
+    m_needsRebuild = true;
+    update();
+    emit fillOpacityChanged();
+}
+
+void TelemetryChart::setGridLines(int lines)
+{
+    if (m_gridLines == lines) return;
+    m_gridLines = lines;
+    m_gridDirty = true;
+    update();
+    emit gridLinesChanged();
+}
+
+void TelemetryChart::geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry)
+{
+    QQuickItem::geometryChange(newGeometry, oldGeometry);
+    if (newGeometry.size() == oldGeometry.size()) return;
+
+    m_needsRebuild = true;
+    m_gridDirty = true;
+    updateLastPoint();
+    update();
+}
+
+void TelemetryChart::onSampleAppended()
+{
+    ++m_pendingAppends;
+    if (updateRange()) m_needsRebuild = true;
+    updateLastPoint();
+    update();
+}
+
+void TelemetryChart::onHistoryReset()
+{
+    m_needsRebuild = true;
+    updateRange();
+    updateLastPoint();
+    update();
+}
+
+bool TelemetryChart::updateRange()
+{
+    double lo = 0;
+    double hi = m_maxValue;
+
+    const int n = m_history ? m_history->count() : 0;
+    if (m_autoScale && n > 0) {
+        // Walk the ring in place
+        const double *first, *second;
+        int firstCount, secondCount;
+        m_history->spans(&first, &firstCount, &second, &secondCount);
+
+        double dataMin = first[0], dataMax = first[0];
+        for (int i = 0; i < firstCount; ++i) {
+            dataMin = qMin(dataMin, first[i]);
+            dataMax = qMax(dataMax, first[i]);
+        }
+        for (int i = 0; i < secondCount; ++i) {
+            dataMin = qMin(dataMin, second[i]);
+            dataMax = qMax(dataMax, second[i]);
+        }
+
+        // Hysteresis: keep the current range while the data still fits and
+        // uses at least half of it, so most appends need no re-projection
+        const double span = m_maxVal - m_minVal;
+        if (dataMin >= m_minVal && dataMax <= m_maxVal && (dataMax - dataMin) >= span * 0.5) {
+            return false;
+        }
+
+        // Same framing as the old Canvas painter: 10% headroom, at least 2 units tall
+        const double range = dataMax - dataMin;
+        lo = dataMin;
+        hi = dataMax;
+        if (range < 2) {
+            const double mid = (dataMin + dataMax) / 2;
+            lo = qMax(0.0, mid - 1);
+            hi = mid + 1;
+        }
+        lo -= range * 0.1;
+        hi += range * 0.1;
+        if (lo < 0) lo = 0;
+    }
+
+    if (hi <= lo) hi = lo + 1;
+    if (lo == m_minVal && hi == m_maxVal) return false;
+    m_minVal = lo;
+    m_maxVal = hi;
+    return true;
+}
+
+void TelemetryChart::updateLastPoint()
+{
+    const int n = m_history ? m_history->count() : 0;
+    QPointF point;
+    if (n > 0) {
+        point = QPointF(n > 1 ? width() : 0, mapY(m_history->last()));
+    }
+    if (point != m_lastPoint) {
+        m_lastPoint = point;
+        emit lastPointChanged();
+    }
+}
+
+float TelemetryChart::mapY(double value) const
+{
+    const double norm = qBound(0.0, (value - m_minVal) / (m_maxVal - m_minVal), 1.0);
+    return static_cast<float>(height() - norm * height());
+}
+
+double TelemetryChart::sampleAt(int index) const
+{
+    return m_history ? m_history->at(index) : 0.0;
+}
+
+void TelemetryChart::writeSample(ChartNode *node, int index, int count, int localIndex) const
+{
+    // x is laid out from the last rebuild; the transform node scrolls it back
+    const float stepX = static_cast<float>(width() / (count - 1));
+    const float x = (m_scroll + localIndex) * stepX;
+    const float y = mapY(sampleAt(index));
+
+    // Thick line: offset both sides along the normal of the neighbours' chord
+    const int prev = qMax(0, index - 1);
+    const int next = qMin(count - 1, index + 1);
+    const float dx = (next - prev) * stepX;
+    const float dy = mapY(sampleAt(next)) - mapY(sampleAt(prev));
+    const float len = std::sqrt(dx * dx + dy * dy);
+    const float half = static_cast<float>(m_lineWidth) / 2;
+    const float nx = len > 0 ? -dy / len * half : 0;
+    const float ny = len > 0 ? dx / len * half : half;
+
+    QSGGeometry::Point2D *line = node->line->geometry()->vertexDataAsPoint2D();
+    line[localIndex * 2].set(x + nx, y + ny);
+    line[localIndex * 2 + 1].set(x - nx, y - ny);
+
+    // Fill: value down to the baseline, vertex colours approximate the
+    // vertical gradient (premultiplied alpha)
+    const float h = static_cast<float>(height());
+    const float t = h > 0 ? y / h : 0;
+    const float topAlpha = static_cast<float>(m_fillOpacity) * (1 - t) + kFillBottomAlpha * t;
+    auto premul = [this](float alpha, uchar *r, uchar *g, uchar *b, uchar *a) {
+        *r = static_cast<uchar>(m_color.red() * alpha);
+        *g = static_cast<uchar>(m_color.green() * alpha);
+        *b = static_cast<uchar>(m_color.blue() * alpha);
+        *a = static_cast<uchar>(255 * alpha);
+    };
+
+    QSGGeometry::ColoredPoint2D *fill = node->fill->geometry()->vertexDataAsColoredPoint2D();
+    uchar r, g, b, a;
+    premul(topAlpha, &r, &g, &b, &a);
+    fill[localIndex * 2].set(x, y, r, g, b, a);
+    premul(kFillBottomAlpha, &r, &g, &b, &a);
+    fill[localIndex * 2 + 1].set(x, h, r, g, b, a);
+}
+
+void TelemetryChart::rebuild(ChartNode *node)
+{
+    const int n = m_history ? m_history->count() : 0;
+    m_scroll = 0;
+    node->scroll->setMatrix(QMatrix4x4());
+
+    if (n < 2 || width() <= 0 || height() <= 0) {
+        node->line->geometry()->allocate(0);
+        node->fill->geometry()->allocate(0);
+        m_builtCount = 0;
+    } else {
+        node->line->geometry()->allocate(n * 2);
+        node->fill->geometry()->allocate(n * 2);
+        for (int i = 0; i < n; ++i) {
+            writeSample(node, i, n, i);
+        }
+        m_builtCount = n;
+    }
+
+    node->line->markDirty(QSGNode::DirtyGeometry);
+    node->fill->markDirty(QSGNode::DirtyGeometry);
+}
+
+bool TelemetryChart::appendIncrementally(ChartNode *node)
+{
+    // Only a single append onto a full ring keeps the vertex count and x step
+    const int n = m_history ? m_history->count() : 0;
+    if (m_pendingAppends != 1 || n < 3 || n != m_builtCount || n != m_history->capacity()) return false;
+    // Rebase once the layout has scrolled a full window
+    if (m_scroll + 1 >= n) return false;
+
+    // Drop the oldest sample: shift the strips left by one vertex pair
+    QSGGeometry *line = node->line->geometry();
+    QSGGeometry *fill = node->fill->geometry();
+    memmove(line->vertexDataAsPoint2D(), line->vertexDataAsPoint2D() + 2,
+            (n - 1) * 2 * sizeof(QSGGeometry::Point2D));
+    memmove(fill->vertexDataAsColoredPoint2D(), fill->vertexDataAsColoredPoint2D() + 2,
+            (n - 1) * 2 * sizeof(QSGGeometry::ColoredPoint2D));
+    ++m_scroll;
+
+    // New point, plus the joins whose neighbours changed
+    writeSample(node, n - 1, n, n - 1);
+    writeSample(node, n - 2, n, n - 2);
+    writeSample(node, 0, n, 0);
+
+    const float stepX = static_cast<float>(width() / (n - 1));
+    QMatrix4x4 matrix;
+    matrix.translate(-m_scroll * stepX, 0);
+    node->scroll->setMatrix(matrix);
+
+    node->line->markDirty(QSGNode::DirtyGeometry);
+    node->fill->markDirty(QSGNode::DirtyGeometry);
+    return true;
+}
+
+void TelemetryChart::writeGrid(ChartNode *node) const
+{
+    const int lines = qMax(0, m_gridLines) + 1;
+    QSGGeometry *geometry = node->grid->geometry();
+    geometry->allocate(lines * 2);
+
+    QSGGeometry::Point2D *v = geometry->vertexDataAsPoint2D();
+    const float w = static_cast<float>(width());
+    for (int i = 0; i < lines; ++i) {
+        const float y = m_gridLines > 0 ? static_cast<float>(height() / m_gridLines * i) : 0;
+        v[i * 2].set(0, y);
+        v[i * 2 + 1].set(w, y);
+    }
+    node->grid->markDirty(QSGNode::DirtyGeometry);
+}
+
+QSGNode *TelemetryChart::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *)
+{
+    ChartNode *node = static_cast<ChartNode *>(oldNode);
+    if (!node) {
+        node = new ChartNode;
+        m_materialDirty = m_gridDirty = m_needsRebuild = true;
+    }
+
+    if (m_materialDirty) {
+        static_cast<QSGFlatColorMaterial *>(node->line->material())->setColor(m_color);
+        static_cast<QSGFlatColorMaterial *>(node->grid->material())->setColor(m_gridColor);
+        node->line->markDirty(QSGNode::DirtyMaterial);
+        node->grid->markDirty(QSGNode::DirtyMaterial);
+        m_needsRebuild = true;  // Fill colours live in the vertices
+        m_materialDirty = false;
+    }
+
+    if (m_gridDirty) {
+        writeGrid(node);
+        m_gridDirty = false;
+    }
+
+    if (m_needsRebuild || (m_pendingAppends > 0 && !appendIncrementally(node))) {
+        rebuild(node);
+    }
+    m_needsRebuild = false;
+    m_pendingAppends = 0;
+
+    return node;
+}
@@ -0,0 +1,114 @@
+#ifndef TELEMETRYCHART_H
+#define TELEMETRYCHART_H
+
+#include <QQuickItem>
+#include <QColor>
+#include <QPointF>
+#include <QPointer>
+#include "MetricHistory.h"
+
+// Scene-graph line chart for a MetricHistory (replaces the JS Canvas painter
+// in GraphCard).
+//
+// Geometry is built in C++: a thick line as a triangle strip, a gradient
+// fill strip underneath and a static grid. Once the history is full, an
+// append shifts the existing vertices by one sample and writes only the new
+// point (plus the joins next to it); scrolling is a translation on a
+// transform node, so nothing is re-projected. The whole geometry is only
+// rebuilt on resize, capacity change, autoscale range change, or every
+// `capacity` appends to rebase the x coordinates.
+//
+// Autoscale runs in C++ with hysteresis: the range only changes when the
+// data leaves it or shrinks to under half of it.
+class TelemetryChart : public QQuickItem
+{
+    Q_OBJECT
+    Q_PROPERTY(MetricHistory *history READ history WRITE setHistory NOTIFY historyChanged)
+    Q_PROPERTY(QColor color READ color WRITE setColor NOTIFY colorChanged)
+    Q_PROPERTY(QColor gridColor READ gridColor WRITE setGridColor NOTIFY gridColorChanged)
+    Q_PROPERTY(qreal maxValue READ maxValue WRITE setMaxValue NOTIFY maxValueChanged)
+    Q_PROPERTY(bool autoScale READ autoScale WRITE setAutoScale NOTIFY autoScaleChanged)
+    Q_PROPERTY(qreal lineWidth READ lineWidth WRITE setLineWidth NOTIFY lineWidthChanged)
+    Q_PROPERTY(qreal fillOpacity READ fillOpacity WRITE setFillOpacity NOTIFY fillOpacityChanged)
+    Q_PROPERTY(int gridLines READ gridLines WRITE setGridLines NOTIFY gridLinesChanged)
+    // Newest point in item coordinates (for a marker drawn in QML)
+    Q_PROPERTY(QPointF lastPoint READ lastPoint NOTIFY lastPointChanged)
+
+public:
+    explicit TelemetryChart(QQuickItem *parent = nullptr);
+
+    MetricHistory *history() const { return m_history; }
+    void setHistory(MetricHistory *history);
+
+    QColor color() const { return m_color; }
+    void setColor(const QColor &color);
+    QColor gridColor() const { return m_gridColor; }
+    void setGridColor(const QColor &color);
+    qreal maxValue() const { return m_maxValue; }
+    void setMaxValue(qreal value);
+    bool autoScale() const { return m_autoScale; }
+    void setAutoScale(bool enabled);
+    qreal lineWidth() const { return m_lineWidth; }
+    void setLineWidth(qreal width);
+    qreal fillOpacity() const { return m_fillOpacity; }
+    void setFillOpacity(qreal opacity);
+    int gridLines() const { return m_gridLines; }
+    void setGridLines(int lines);
+
+    QPointF lastPoint() const { return m_lastPoint; }
+
+signals:
+    void historyChanged();
+    void colorChanged();
+    void gridColorChanged();
+    void maxValueChanged();
+    void autoScaleChanged();
+    void lineWidthChanged();
+    void fillOpacityChanged();
+    void gridLinesChanged();
+    void lastPointChanged();
+
+protected:
+    QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data) override;
+    void geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry) override;
+
+private slots:
+    void onSampleAppended();
+    void onHistoryReset();
+
+private:
+    class ChartNode;
+
+    bool updateRange();
+    void updateLastPoint();
+    void rebuild(ChartNode *node);
+    bool appendIncrementally(ChartNode *node);
+    void writeSample(ChartNode *node, int index, int count, int localIndex) const;
+    void writeGrid(ChartNode *node) const;
+    float mapY(double value) const;
+    double sampleAt(int index) const;
+
+    QPointer<MetricHistory> m_history;
+    QColor m_color = QColor("#0078d4");
+    QColor m_gridColor = QColor(255, 255, 255, 13);
+    qreal m_maxValue = 100.0;
+    bool m_autoScale = false;
+    qreal m_lineWidth = 3.0;
+    qreal m_fillOpacity = 0.35;
+    int m_gridLines = 4;
+
+    // GUI-side state, read by updatePaintNode() while the GUI thread is blocked
+    double m_minVal = 0;
+    double m_maxVal = 100;
+    QPointF m_lastPoint;
+    int m_pendingAppends = 0;   // Appends since the last sync
+    bool m_needsRebuild = true;
+    bool m_gridDirty = true;
+    bool m_materialDirty = true;
+
+    // Render-side bookkeeping for the incremental path
+    int m_builtCount = 0;       // Samples in the current geometry
+    int m_scroll = 0;           // Samples shifted out since the last rebuild
+};
+
+#endif // TELEMETRYCHART_H
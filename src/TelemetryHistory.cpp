@@ -0,0 +1,200 @@
+#include "TelemetryHistory.h"
+
+#include <algorithm>
+#include <cmath>
+
+// {resolution, buckets}: 10 min @ 1 s, 6 h @ 10 s, 7 d @ 1 min
+static const struct { qint64 resolutionMs; int buckets; } kTiers[TelemetryHistory::kTierCount] = {
+    { 1000, 600 },
+    { 10000, 2160 },
+    { 60000, 10080 },
+};
+
+TelemetryHistory::TelemetryHistory(QObject *parent)
+    : QObject(parent)
+{
+    for (int t = 0; t < kTierCount; ++t) {
+        m_tiers[t].resolutionMs = kTiers[t].resolutionMs;
+        m_tiers[t].ring.resize(kTiers[t].buckets);
+    }
+}
+
+const TelemetryHistory::Bucket &TelemetryHistory::Tier::at(int index) const
+{
+    int slot = head - count + index;
+    if (slot < 0) slot += ring.size();
+    return ring[slot];
+}
+
+void TelemetryHistory::append(qint64 timestampMs, const Sample &sample)
+{
+    for (Tier &tier : m_tiers) {
+        const qint64 start = timestampMs - timestampMs % tier.resolutionMs;
+        if (tier.samples > 0 && start > tier.open.startMs) {
+            closeBucket(tier);
+        }
+
+        if (tier.samples == 0) {
+            tier.open.startMs = start;
+            for (int c = 0; c < ChannelCount; ++c) {
+                tier.open.values[c].min = sample[c];
+                tier.open.values[c].max = sample[c];
+                tier.sums[c] = 0;
+            }
+        }
+
+        // A clock stepped backwards folds into the open bucket, so every ring
+        // stays in time order
+        for (int c = 0; c < ChannelCount; ++c) {
+            Aggregate &value = tier.open.values[c];
+            value.min = qMin(value.min, sample[c]);
+            value.max = qMax(value.max, sample[c]);
+            tier.sums[c] += sample[c];
+        }
+        ++tier.samples;
+    }
+}
+
+void TelemetryHistory::closeBucket(Tier &tier)
+{
+    for (int c = 0; c < ChannelCount; ++c) {
+        tier.open.values[c].mean = static_cast<float>(tier.sums[c] / tier.samples);
+    }
+
+    tier.ring[tier.head] = tier.open;
+    tier.head = (tier.head + 1) % tier.ring.size();
+    if (tier.count < tier.ring.size()) ++tier.count;
+    tier.samples = 0;
+}
+
+int TelemetryHistory::tierFor(qint64 fromMs) const
+{
+    for (int t = 0; t < kTierCount; ++t) {
+        const Tier &tier = m_tiers[t];
+        if (tier.count == 0 && tier.samples == 0) continue;
+        const qint64 oldest = tier.count > 0 ? tier.at(0).startMs : tier.open.startMs;
+        if (oldest <= fromMs) return t;
+    }
+    // Nothing reaches back that far: the coarsest tier holds the most
+    return kTierCount - 1;
+}
+
+qint64 TelemetryHistory::tierResolutionMs(int tier) const
+{
+    return m_tiers[qBound(0, tier, kTierCount - 1)].resolutionMs;
+}
+
+qint64 TelemetryHistory::oldestMs() const
+{
+    const Tier &tier = m_tiers[kTierCount - 1];
+    if (tier.count > 0) return tier.at(0).startMs;
+    return tier.samples > 0 ? tier.open.startMs : 0;
+}
+
+qint64 TelemetryHistory::memoryBytes() const
+{
+    qint64 bytes = sizeof(*this);
+    for (const Tier &tier : m_tiers) {
+        bytes += tier.ring.capacity() * static_cast<qint64>(sizeof(Bucket));
+    }
+    return bytes;
+}
+
+QVector<TelemetryHistory::Point> TelemetryHistory::range(Channel channel, qint64 fromMs, qint64 toMs) const
+{
+    QVector<Point> points;
+    if (channel < 0 || channel >= ChannelCount || toMs < fromMs) return points;
+
+    const Tier &tier = m_tiers[tierFor(fromMs)];
+    const qint64 res = tier.resolutionMs;
+
+    // First closed bucket that ends after fromMs
+    int lo = 0, hi = tier.count;
+    while (lo < hi) {
+        const int mid = (lo + hi) / 2;
+        if (tier.at(mid).startMs + res <= fromMs) lo = mid + 1;
+        else hi = mid;
+    }
+
+    for (int i = lo; i < tier.count; ++i) {
+        const Bucket &bucket = tier.at(i);
+        if (bucket.startMs > toMs) break;
+        points.append({ bucket.startMs, res, bucket.values[channel] });
+    }
+
+    if (tier.samples > 0 && tier.open.startMs <= toMs && tier.open.startMs + res > fromMs) {
+        Aggregate value = tier.open.values[channel];
+        value.mean = static_cast<float>(tier.sums[channel] / tier.samples);
+        points.append({ tier.open.startMs, res, value });
+    }
+    return points;
+}
+
+QVector<QPointF> TelemetryHistory::series(Channel channel, qint64 fromMs, qint64 toMs, int maxPoints) const
+{
+    const QVector<Point> buckets = range(channel, fromMs, toMs);
+
+    QVector<QPointF> points;
+    points.reserve(buckets.size());
+    for (const Point &p : buckets) {
+        points.append(QPointF(p.startMs + p.durationMs / 2, p.value.mean));
+    }
+    return lttb(points, maxPoints);
+}
+
+QList<QPointF> TelemetryHistory::downsample(int channel, qint64 fromMs, qint64 toMs, int pixelWidth) const
+{
+    if (channel < 0 || channel >= ChannelCount) return QList<QPointF>();
+    return series(static_cast<Channel>(channel), fromMs, toMs, pixelWidth);
+}
+
+QVector<QPointF> TelemetryHistory::lttb(const QVector<QPointF> &points, int threshold)
+{
+    const int n = points.size();
+    if (threshold >= n || threshold < 3) return points;
+
+    QVector<QPointF> out;
+    out.reserve(threshold);
+    out.append(points[0]);
+
+    // The first and last points are fixed; the rest is split into threshold - 2 buckets
+    const double every = static_cast<double>(n - 2) / (threshold - 2);
+    int a = 0;
+
+    for (int i = 0; i < threshold - 2; ++i) {
+        // Average of the next bucket is the third triangle corner
+        const int avgStart = static_cast<int>(std::floor((i + 1) * every)) + 1;
+        const int avgEnd = qMin(static_cast<int>(std::floor((i + 2) * every)) + 1, n);
+        double avgX = 0, avgY = 0;
+        for (int j = avgStart; j < avgEnd; ++j) {
+            avgX += points[j].x();
+            avgY += points[j].y();
+        }
+        const int avgCount = qMax(1, avgEnd - avgStart);
+        avgX /= avgCount;
+        avgY /= avgCount;
+
+        const int rangeStart = static_cast<int>(std::floor(i * every)) + 1;
+        const int rangeEnd = static_cast<int>(std::floor((i + 1) * every)) + 1;
+        const double ax = points[a].x();
+        const double ay = points[a].y();
+
+        double maxArea = -1;
+        int picked = rangeStart;
+        for (int j = rangeStart; j < rangeEnd; ++j) {
+            // Twice the triangle area; the factor doesn't change the pick
+            const double area = std::fabs((ax - avgX) * (points[j].y() - ay)
+                                          - (ax - points[j].x()) * (avgY - ay));
+            if (area > maxArea) {
+                maxArea = area;
+                picked = j;
+            }
+        }
+
+        out.append(points[picked]);
+        a = picked;
+    }
+
+    out.append(points[n - 1]);
+    return out;
+}
@@ -0,0 +1,103 @@
+#ifndef TELEMETRYHISTORY_H
+#define TELEMETRYHISTORY_H
+
+#include <QObject>
+#include <QVector>
+#include <QPointF>
+#include <QList>
+#include <array>
+
+// Long-range dashboard telemetry at three resolutions:
+//
+//   tier 0:  1 s buckets for the last 10 minutes   (600 buckets)
+//   tier 1: 10 s buckets for the last 6 hours      (2160 buckets)
+//   tier 2:  1 min buckets for the last 7 days     (10080 buckets)
+//
+// Every tier keeps min/max/mean per bucket for each channel. Each sample is
+// folded into the open bucket of every tier; a bucket is pushed into its
+// tier's ring once a sample lands in the next one. All rings are allocated
+// up front, so memory is fixed (see memoryBytes()) and append is O(1).
+//
+// Queries pick the finest tier that still covers the start of the range and
+// reduce it with Largest-Triangle-Three-Buckets, so a graph gets about one
+// point per pixel whatever the time span.
+//
+// Timestamps are wall-clock milliseconds since the epoch.
+class TelemetryHistory : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Channel { CpuUsage, GpuUsage, RamUsage, DiskUsage, CpuTemp, NetDown, NetUp, ChannelCount };
+    Q_ENUM(Channel)
+
+    typedef std::array<float, ChannelCount> Sample;
+
+    struct Aggregate {
+        float min;
+        float max;
+        float mean;
+    };
+
+    // One closed (or the currently open) bucket of a tier
+    struct Bucket {
+        qint64 startMs;
+        Aggregate values[ChannelCount];
+    };
+
+    // One channel of a bucket, as handed out by range()
+    struct Point {
+        qint64 startMs;
+        qint64 durationMs;
+        Aggregate value;
+    };
+
+    static const int kTierCount = 3;
+
+    explicit TelemetryHistory(QObject *parent = nullptr);
+
+    void append(qint64 timestampMs, const Sample &sample);
+
+    // Buckets of one channel overlapping [fromMs, toMs], oldest first, from
+    // the finest tier that reaches back to fromMs. Includes the open bucket.
+    QVector<Point> range(Channel channel, qint64 fromMs, qint64 toMs) const;
+
+    // Bucket means over [fromMs, toMs] reduced to at most maxPoints with LTTB.
+    // x = bucket midpoint (ms since epoch), y = mean.
+    QVector<QPointF> series(Channel channel, qint64 fromMs, qint64 toMs, int maxPoints) const;
+
+    // QML entry point for series(); pixelWidth is the number of points wanted
+    Q_INVOKABLE QList<QPointF> downsample(int channel, qint64 fromMs, qint64 toMs, int pixelWidth) const;
+    // Oldest timestamp any tier still holds (0 when empty)
+    Q_INVOKABLE qint64 oldestMs() const;
+
+    // Largest-Triangle-Three-Buckets (Steinarsson 2013). Keeps the first and
+    // last point and, per bucket, the point spanning the largest triangle with
+    // the previous pick and the next bucket's average.
+    static QVector<QPointF> lttb(const QVector<QPointF> &points, int threshold);
+
+    int tierFor(qint64 fromMs) const;
+    qint64 tierResolutionMs(int tier) const;
+    qint64 memoryBytes() const;
+
+private:
+    struct Tier {
+        qint64 resolutionMs = 0;
+        QVector<Bucket> ring;
+        int head = 0;               // Slot the next closed bucket goes into
+        int count = 0;
+
+        // Open bucket: running min/max and sums for the mean
+        Bucket open;
+        double sums[ChannelCount];
+        int samples = 0;
+
+        const Bucket &at(int index) const;  // 0 = oldest closed bucket
+    };
+
+    void closeBucket(Tier &tier);
+
+    Tier m_tiers[kTierCount];
+};
+
+#endif // TELEMETRYHISTORY_H
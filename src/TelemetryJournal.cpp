@@ -0,0 +1,225 @@
+#include "TelemetryJournal.h"
+#include "SysRoot.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <cstddef>
+#include <cstring>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static_assert(sizeof(TelemetryJournal::Record) == 64, "journal records are 64 bytes on disk");
+
+static const char kMagic[8] = { 'T', 'U', 'F', 'J', 'R', 'N', 'L', '1' };
+static const quint32 kVersion = 1;
+static const qint64 kHeaderSize = 4096;
+
+struct TelemetryJournal::Header {
+    char magic[8];
+    quint32 version;
+    quint32 recordSize;
+    quint32 capacity;
+    quint32 reserved;
+    // Hints only: recovery trusts the records, not these
+    quint64 writeIndex;
+    quint64 nextSequence;
+};
+
+TelemetryJournal::TelemetryJournal(const QString &path, int capacity)
+    : m_path(path)
+    , m_capacity(qMax(2, capacity))
+{
+    if (open()) {
+        recover();
+    }
+}
+
+TelemetryJournal::~TelemetryJournal()
+{
+    if (m_map) {
+        msync(m_map, m_mapSize, MS_SYNC);
+        munmap(m_map, m_mapSize);
+    }
+    if (m_fd >= 0) {
+        ::close(m_fd);
+    }
+}
+
+QString TelemetryJournal::defaultPath()
+{
+    if (geteuid() == 0) {
+        return SysRoot::path("/var/lib/asus-tuf-fan-control/telemetry.journal");
+    }
+
+    QString base = qEnvironmentVariable("XDG_STATE_HOME");
+    if (base.isEmpty()) base = QDir::homePath() + "/.local/state";
+    return SysRoot::path(base + "/asus-tuf-fan-control/telemetry.journal");
+}
+
+bool TelemetryJournal::open()
+{
+    QDir().mkpath(QFileInfo(m_path).absolutePath());
+
+    m_fd = ::open(m_path.toLocal8Bit().constData(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (m_fd < 0) {
+        qWarning() << "TelemetryJournal: cannot open" << m_path << "-" << strerror(errno);
+        return false;
+    }
+
+    if (flock(m_fd, LOCK_EX | LOCK_NB) != 0) {
+        qWarning() << "TelemetryJournal:" << m_path << "is in use by another instance, history will not persist";
+        ::close(m_fd);
+        m_fd = -1;
+        return false;
+    }
+
+    m_mapSize = kHeaderSize + static_cast<qint64>(m_capacity) * sizeof(Record);
+
+    // Anything that is not our layout at our size starts over
+    Header header;
+    struct stat st = {};
+    const bool reuse = fstat(m_fd, &st) == 0 && st.st_size == m_mapSize
+                       && pread(m_fd, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header))
+                       && memcmp(header.magic, kMagic, sizeof(kMagic)) == 0
+                       && header.version == kVersion
+                       && header.recordSize == sizeof(Record)
+                       && header.capacity == static_cast<quint32>(m_capacity);
+    if (!reuse) {
+        if (st.st_size > 0) {
+            qInfo() << "TelemetryJournal: unrecognised journal at" << m_path << ", starting a new one";
+        }
+        if (ftruncate(m_fd, 0) != 0) {
+            qWarning() << "TelemetryJournal: cannot reset" << m_path << "-" << strerror(errno);
+        }
+    }
+
+    // Reserve the blocks up front: a store into a hole on a full disk would
+    // be a SIGBUS instead of an error
+    const int err = posix_fallocate(m_fd, 0, m_mapSize);
+    if (err != 0) {
+        qWarning() << "TelemetryJournal: cannot allocate" << m_mapSize << "bytes for" << m_path << "-" << strerror(err);
+        ::close(m_fd);
+        m_fd = -1;
+        return false;
+    }
+
+    void *map = mmap(nullptr, m_mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+    if (map == MAP_FAILED) {
+        qWarning() << "TelemetryJournal: cannot map" << m_path << "-" << strerror(errno);
+        ::close(m_fd);
+        m_fd = -1;
+        return false;
+    }
+
+    m_map = static_cast<uchar *>(map);
+    m_header = reinterpret_cast<Header *>(m_map);
+    m_records = reinterpret_cast<Record *>(m_map + kHeaderSize);
+
+    if (!reuse) {
+        memcpy(m_header->magic, kMagic, sizeof(kMagic));
+        m_header->version = kVersion;
+        m_header->recordSize = sizeof(Record);
+        m_header->capacity = static_cast<quint32>(m_capacity);
+        m_header->reserved = 0;
+        m_header->writeIndex = 0;
+        m_header->nextSequence = 1;
+    }
+    return true;
+}
+
+quint32 TelemetryJournal::checksum(const Record &record)
+{
+    const uchar *p = reinterpret_cast<const uchar *>(&record);
+    quint32 hash = 2166136261u;
+    for (size_t i = 0; i < offsetof(Record, checksum); ++i) {
+        hash = (hash ^ p[i]) * 16777619u;
+    }
+    return hash;
+}
+
+bool TelemetryJournal::isValid(int slot) const
+{
+    const Record &record = m_records[slot];
+    return record.sequence != 0 && record.checksum == checksum(record);
+}
+
+void TelemetryJournal::recover()
+{
+    const int cap = m_capacity;
+    int newest = -1;
+
+    // Fast path: the header's cursor points just past a valid record with
+    // the sequence it expects
+    const int hint = static_cast<int>(m_header->writeIndex % cap);
+    const int beforeHint = (hint - 1 + cap) % cap;
+    if (isValid(beforeHint) && m_records[beforeHint].sequence + 1 == m_header->nextSequence) {
+        newest = beforeHint;
+        // Records that reached the disk after the header did
+        for (int i = 0; i < cap; ++i) {
+            const int next = (newest + 1) % cap;
+            if (!isValid(next) || m_records[next].sequence != m_records[newest].sequence + 1) break;
+            newest = next;
+        }
+    } else {
+        // Stale or lost header page: the newest record is the highest valid sequence
+        quint64 best = 0;
+        for (int slot = 0; slot < cap; ++slot) {
+            if (isValid(slot) && m_records[slot].sequence > best) {
+                best = m_records[slot].sequence;
+                newest = slot;
+            }
+        }
+    }
+
+    if (newest < 0) {
+        m_writeIndex = 0;
+        m_count = 0;
+        m_nextSequence = 1;
+    } else {
+        // Walk back over the unbroken chain; a gap ends the recoverable history
+        int oldest = newest;
+        m_count = 1;
+        while (m_count < cap) {
+            const int prev = (oldest - 1 + cap) % cap;
+            if (!isValid(prev) || m_records[prev].sequence + 1 != m_records[oldest].sequence) break;
+            oldest = prev;
+            ++m_count;
+        }
+        m_writeIndex = (newest + 1) % cap;
+        m_nextSequence = m_records[newest].sequence + 1;
+    }
+
+    m_header->writeIndex = m_writeIndex;
+    m_header->nextSequence = m_nextSequence;
+    qInfo() << "TelemetryJournal:" << m_count << "records recovered from" << m_path;
+}
+
+void TelemetryJournal::append(Record record)
+{
+    if (!m_records) return;
+
+    record.sequence = m_nextSequence++;
+    record.checksum = checksum(record);
+    m_records[m_writeIndex] = record;
+
+    m_writeIndex = (m_writeIndex + 1) % m_capacity;
+    if (m_count < m_capacity) ++m_count;
+    m_header->writeIndex = m_writeIndex;
+    m_header->nextSequence = m_nextSequence;
+}
+
+void TelemetryJournal::replay(const std::function<void(const Record &)> &fn) const
+{
+    if (!m_records) return;
+
+    const int start = (m_writeIndex - m_count + m_capacity) % m_capacity;
+    for (int i = 0; i < m_count; ++i) {
+        fn(m_records[(start + i) % m_capacity]);
+    }
+}
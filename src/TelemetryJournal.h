@@ -0,0 +1,97 @@
+#ifndef TELEMETRYJOURNAL_H
+#define TELEMETRYJOURNAL_H
+
+#include <QString>
+#include <QtGlobal>
+#include <functional>
+
+// Persistent ring of per-second telemetry records, so history survives the
+// frequent restarts (the app runs as root through pkexec).
+//
+// The file is a 4 KiB header followed by `capacity` fixed-size records and
+// is mapped MAP_SHARED: append() is a plain memory copy, no syscall per
+// sample. The kernel writes dirty pages back on its own schedule (there is
+// no periodic msync: MS_ASYNC is a no-op on Linux) and the destructor
+// flushes with msync(MS_SYNC).
+//
+// Crash safety comes from the records themselves: each carries a sequence
+// number and a checksum over its payload, written in one copy. The header's
+// write cursor is only a hint. On open the newest valid record is located
+// (from the hint, else by scanning) and the journal is the chain of valid
+// records with consecutive sequence numbers ending there, so a torn record
+// or a page lost to power failure truncates history instead of corrupting
+// it.
+//
+// Single writer: the file is flock()ed, a second instance runs without a
+// journal.
+class TelemetryJournal
+{
+public:
+    // 64 bytes, little-endian host layout
+    struct Record {
+        quint64 sequence;       // 0 = never written
+        qint64 timestampMs;     // Wall clock, ms since the epoch
+        float cpuUsage;         // Percent
+        float cpuFreq;          // MHz
+        float memoryUsage;      // Percent
+        float gpuUsage;         // Percent
+        float gpuFreq;          // MHz
+        float diskUsage;        // Percent
+        float netDown;          // KB/s
+        float netUp;            // KB/s
+        qint16 cpuTemp;         // °C
+        qint16 gpuTemp;         // °C
+        quint16 cpuFanRpm;
+        quint16 gpuFanRpm;
+        qint8 thermalPolicy;    // throttle_thermal_policy, -1 = unknown
+        quint8 batteryPercent;
+        quint8 batteryState;    // SensorSnapshot::BatteryState
+        quint8 reserved;
+        quint32 checksum;       // FNV-1a over everything above
+    };
+
+    static const int kDefaultCapacity = 86400;    // 24 h at one record per second
+
+    explicit TelemetryJournal(const QString &path = defaultPath(), int capacity = kDefaultCapacity);
+    ~TelemetryJournal();
+
+    bool isOpen() const { return m_records != nullptr; }
+    QString path() const { return m_path; }
+    int capacity() const { return m_capacity; }
+    int count() const { return m_count; }
+
+    // Stamps sequence and checksum; a no-op when the journal is not open
+    void append(Record record);
+
+    // Recovered records, oldest first
+    void replay(const std::function<void(const Record &)> &fn) const;
+
+    // /var/lib/asus-tuf-fan-control when running as root, else
+    // $XDG_STATE_HOME/asus-tuf-fan-control (~/.local/state by default);
+    // under SysRoot either way
+    static QString defaultPath();
+
+private:
+    Q_DISABLE_COPY(TelemetryJournal)
+
+    struct Header;
+
+    bool open();
+    void recover();
+    bool isValid(int slot) const;
+    static quint32 checksum(const Record &record);
+
+    QString m_path;
+    int m_capacity;
+    int m_fd = -1;
+    uchar *m_map = nullptr;
+    qint64 m_mapSize = 0;
+    Header *m_header = nullptr;
+    Record *m_records = nullptr;
+
+    int m_writeIndex = 0;       // Slot the next record goes into
+    int m_count = 0;            // Valid records ending just before m_writeIndex
+    quint64 m_nextSequence = 1;
+};
+
+#endif // TELEMETRYJOURNAL_H
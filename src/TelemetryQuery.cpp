@@ -0,0 +1,205 @@
+#include "TelemetryQuery.h"
+#include "TelemetryHistory.h"
+
+#include <QDebug>
+#include <QMutexLocker>
+#include <QThread>
+#include <cfloat>
+
+static_assert(TelemetryQuery::BatteryPercent + 1 == TelemetryBlock::MetricCount,
+              "TelemetryQuery::Metric must mirror TelemetryBlock::Metric");
+
+TelemetryQuery::TelemetryQuery(TelemetryArchive *archive, QObject *parent)
+    : QObject(parent)
+    , m_archive(archive)
+    , m_thread(new QThread(this))
+    , m_worker(new QObject())
+{
+    m_worker->moveToThread(m_thread);
+    m_thread->setObjectName("TelemetryQuery");
+    m_thread->start(QThread::LowPriority);
+}
+
+TelemetryQuery::~TelemetryQuery()
+{
+    {
+        QMutexLocker locker(&m_pendingMutex);
+        m_pending.clear();  // Lets a running query stop at its next block
+    }
+    m_thread->quit();
+    m_thread->wait();
+    delete m_worker;
+}
+
+qint64 TelemetryQuery::oldestMs() const
+{
+    if (!m_archive->blocks().isEmpty()) return m_archive->blocks().first().summary.startMs;
+
+    TelemetryBlock::Summary summary;
+    QByteArray payload;
+    m_archive->pending(&summary, &payload);
+    return summary.count > 0 ? summary.startMs : 0;
+}
+
+bool TelemetryQuery::isPending(int requestId)
+{
+    QMutexLocker locker(&m_pendingMutex);
+    return m_pending.contains(requestId);
+}
+
+bool TelemetryQuery::takePending(int requestId)
+{
+    QMutexLocker locker(&m_pendingMutex);
+    return m_pending.remove(requestId);
+}
+
+void TelemetryQuery::cancel(int requestId)
+{
+    QMutexLocker locker(&m_pendingMutex);
+    m_pending.remove(requestId);
+}
+
+int TelemetryQuery::query(int metric, qint64 fromMs, qint64 toMs, int maxPoints)
+{
+    if (metric < 0 || metric >= TelemetryBlock::MetricCount) {
+        qWarning() << "TelemetryQuery: unknown metric" << metric;
+        return -1;
+    }
+
+    const int id = m_nextId++;
+
+    // Sealed blocks are never rewritten, so the worker can read them from
+    // disk while the archive keeps appending; the open block is copied
+    Source source;
+    source.blocks = m_archive->blocks();
+    m_archive->pending(&source.pendingSummary, &source.pendingPayload);
+
+    {
+        QMutexLocker locker(&m_pendingMutex);
+        m_pending.insert(id);
+    }
+
+    QMetaObject::invokeMethod(m_worker, [this, id, source, metric, fromMs, toMs, maxPoints]() {
+        if (!isPending(id)) return;
+
+        const Result result = run(source, static_cast<TelemetryBlock::Metric>(metric), fromMs, toMs, maxPoints,
+                                   [this, id]() { return !isPending(id); });
+        if (!takePending(id)) return;
+
+        QVariantList points;
+        points.reserve(result.points.size());
+        for (const QPointF &p : result.points) {
+            points.append(p);
+        }
+
+        QVariantMap map;
+        map["points"] = points;
+        map["min"] = result.min;
+        map["max"] = result.max;
+        map["mean"] = result.mean;
+        map["count"] = result.count;
+        map["fromMs"] = fromMs;
+        map["toMs"] = toMs;
+        map["metric"] = metric;
+
+        QMetaObject::invokeMethod(this, [this, id, map]() {
+            emit queryFinished(id, map);
+        }, Qt::QueuedConnection);
+    }, Qt::QueuedConnection);
+
+    return id;
+}
+
+TelemetryQuery::Result TelemetryQuery::run(const Source &source, TelemetryBlock::Metric metric, qint64 fromMs,
+                                           qint64 toMs, int maxPoints, const std::function<bool()> &cancelled)
+{
+    Result result;
+    if (toMs < fromMs) return result;
+
+    // Oversample the output a few times before LTTB, but never below one second per bucket
+    const qint64 spanMs = toMs - fromMs + 1;
+    const int bucketCount = maxPoints > 0 ? static_cast<int>(qBound<qint64>(1, (spanMs + 999) / 1000, maxPoints * 4)) : 0;
+    const double bucketMs = bucketCount > 0 ? static_cast<double>(spanMs) / bucketCount : 0;
+    auto bucketOf = [&](qint64 timestampMs) {
+        return qMin(bucketCount - 1, static_cast<int>((timestampMs - fromMs) / bucketMs));
+    };
+
+    struct Bucket {
+        double sum = 0;
+        quint64 count = 0;
+    };
+    QVector<Bucket> buckets(bucketCount);
+    double sum = 0;
+    double min = DBL_MAX;
+    double max = -DBL_MAX;
+
+    auto visit = [&](const TelemetryBlock::Summary &summary, const QByteArray *inMemory, const TelemetryArchive::BlockRef *onDisk) {
+        if (summary.count == 0 || summary.endMs < fromMs || summary.startMs > toMs) {
+            ++result.blocksSkipped;
+            return;
+        }
+
+        const bool inside = summary.startMs >= fromMs && summary.endMs <= toMs;
+        if (inside && (bucketCount == 0 || bucketOf(summary.startMs) == bucketOf(summary.endMs))) {
+            sum += summary.sum[metric];
+            result.count += summary.count;
+            min = qMin(min, static_cast<double>(summary.min[metric]));
+            max = qMax(max, static_cast<double>(summary.max[metric]));
+            if (bucketCount > 0) {
+                Bucket &b = buckets[bucketOf(summary.startMs)];
+                b.sum += summary.sum[metric];
+                b.count += summary.count;
+            }
+            ++result.blocksFromSummary;
+            return;
+        }
+
+        QByteArray payload;
+        if (inMemory) {
+            payload = *inMemory;
+        } else if (!TelemetryArchive::readPayload(*onDisk, &payload)) {
+            return;
+        }
+
+        TelemetryBlock::Decoder decoder(summary, payload);
+        TelemetryJournal::Record record;
+        while (decoder.next(&record)) {
+            if (record.timestampMs < fromMs) continue;
+            if (record.timestampMs > toMs) break;
+
+            const double value = TelemetryBlock::metricValue(record, metric);
+            sum += value;
+            ++result.count;
+            min = qMin(min, value);
+            max = qMax(max, value);
+            if (bucketCount > 0) {
+                Bucket &b = buckets[bucketOf(record.timestampMs)];
+                b.sum += value;
+                ++b.count;
+            }
+        }
+        ++result.blocksDecoded;
+    };
+
+    for (const TelemetryArchive::BlockRef &block : source.blocks) {
+        if (cancelled && cancelled()) return result;
+        visit(block.summary, nullptr, &block);
+    }
+    visit(source.pendingSummary, &source.pendingPayload, nullptr);
+
+    if (result.count == 0) return result;
+    result.min = min;
+    result.max = max;
+    result.mean = sum / result.count;
+
+    if (bucketCount > 0) {
+        QVector<QPointF> points;
+        points.reserve(bucketCount);
+        for (int i = 0; i < bucketCount; ++i) {
+            if (buckets[i].count == 0) continue;
+            points.append(QPointF(fromMs + (i + 0.5) * bucketMs, buckets[i].sum / buckets[i].count));
+        }
+        result.points = TelemetryHistory::lttb(points, maxPoints);
+    }
+    return result;
+}
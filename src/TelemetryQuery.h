@@ -0,0 +1,96 @@
+#ifndef TELEMETRYQUERY_H
+#define TELEMETRYQUERY_H
+
+#include <QObject>
+#include <QVector>
+#include <QPointF>
+#include <QVariantMap>
+#include <QMutex>
+#include <QSet>
+#include <functional>
+#include "TelemetryArchive.h"
+
+class QThread;
+
+// Time-range queries over the TelemetryArchive, answered on a worker thread
+// so zooming or panning a graph never stalls the GUI.
+//
+// query() takes a snapshot of the archive's block index (plus the block
+// still being encoded) and returns a request id straight away; the result
+// arrives later through queryFinished(). Per block:
+//
+//   - blocks outside [fromMs, toMs] are skipped on their time bounds
+//   - a block that lies inside the range and within one output bucket (any
+//     block inside the range, for aggregate-only queries) is folded in from
+//     its min/max/sum summary without being read
+//   - only the remaining intersecting blocks are read and decoded
+//
+// Points are per-bucket means reduced to maxPoints with LTTB, like
+// TelemetryHistory::series().
+class TelemetryQuery : public QObject
+{
+    Q_OBJECT
+
+public:
+    // Same order as TelemetryBlock::Metric
+    enum Metric {
+        CpuUsage, CpuFreq, MemoryUsage, GpuUsage, GpuFreq, DiskUsage, NetDown, NetUp,
+        CpuTemp, GpuTemp, CpuFanRpm, GpuFanRpm, ThermalPolicy, BatteryPercent
+    };
+    Q_ENUM(Metric)
+
+    // What a query reads: copied on the GUI thread, then owned by the worker
+    struct Source {
+        QVector<TelemetryArchive::BlockRef> blocks;
+        TelemetryBlock::Summary pendingSummary;
+        QByteArray pendingPayload;
+    };
+
+    struct Result {
+        QVector<QPointF> points;    // x = bucket midpoint (ms since epoch), y = mean
+        double min = 0;
+        double max = 0;
+        double mean = 0;
+        quint64 count = 0;          // Records covered
+        int blocksSkipped = 0;
+        int blocksFromSummary = 0;
+        int blocksDecoded = 0;
+    };
+
+    explicit TelemetryQuery(TelemetryArchive *archive, QObject *parent = nullptr);
+    ~TelemetryQuery() override;
+
+    // maxPoints <= 0 asks for the aggregate only. Returns the request id
+    // (-1 for an unknown metric).
+    Q_INVOKABLE int query(int metric, qint64 fromMs, qint64 toMs, int maxPoints);
+
+    // Drop a request that hasn't finished, e.g. superseded while panning
+    Q_INVOKABLE void cancel(int requestId);
+
+    // Oldest timestamp in the archive (0 when empty)
+    Q_INVOKABLE qint64 oldestMs() const;
+
+    // The query itself: pure function of its source, safe on any thread.
+    // Stops early (returning a partial result) once cancelled() is true.
+    static Result run(const Source &source, TelemetryBlock::Metric metric, qint64 fromMs, qint64 toMs,
+                      int maxPoints, const std::function<bool()> &cancelled = std::function<bool()>());
+
+signals:
+    // result: points (list of point), min, max, mean, count, fromMs, toMs,
+    // metric. Cancelled requests never report.
+    void queryFinished(int requestId, const QVariantMap &result);
+
+private:
+    bool isPending(int requestId);
+    bool takePending(int requestId);
+
+    TelemetryArchive *m_archive;
+    QThread *m_thread;
+    QObject *m_worker;          // Lives on m_thread; queries are queued to it
+    int m_nextId = 1;
+
+    QMutex m_pendingMutex;
+    QSet<int> m_pending;        // Requests queued or running, not cancelled
+};
+
+#endif // TELEMETRYQUERY_H
@@ -0,0 +1,85 @@
+#include "ThermalPolicyBackend.h"
+#include "SysRoot.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+
+bool ThermalPolicyBackend::detect()
+{
+    m_path.clear();
+    forgetSubmitted();
+
+    // Search for ASUS WMI platform device in sysfs
+    const QString platformDir = SysRoot::path("/sys/devices/platform/");
+    const QStringList devices = QDir(platformDir).entryList(QStringList() << "asus*", QDir::Dirs);
+    for (const QString &device : devices) {
+        const QString path = platformDir + device + "/throttle_thermal_policy";
+        if (QFile::exists(path) && isControlPath(path)) {
+            m_path = path;
+            qInfo() << "✓ Found Thermal Policy at:" << platformDir + device;
+            return true;
+        }
+    }
+    return false;
+}
+
+FanBackend::Probe ThermalPolicyBackend::measure()
+{
+    Probe probe;
+    QElapsedTimer timer;
+    timer.start();
+
+    const int policy = readback();
+    if (policy >= 0 && writeNow(HardwareWriteQueue::ThermalPolicy, m_path, QString::number(policy))) {
+        probe.faithful = readback() == policy;
+    }
+    probe.latencyUs = timer.nsecsElapsed() / 1000;
+    return probe;
+}
+
+int ThermalPolicyBackend::policyFor(int percentage)
+{
+    if (percentage < 34) return 2;  // Silent
+    if (percentage < 67) return 0;  // Balanced
+    return 1;                       // Turbo
+}
+
+void ThermalPolicyBackend::apply(int percentage, QObject *context, HardwareWriteQueue::Callback onResult)
+{
+    const int policy = policyFor(percentage);
+
+    // Write only if changed to avoid spamming WMI
+    if (submitIfChanged(HardwareWriteQueue::ThermalPolicy, m_path, policy, context, onResult)) {
+        QString modeName;
+        if (policy == 2) modeName = "Silent (0 RPM < 60°C)";
+        else if (policy == 0) modeName = "Balanced (0 RPM < 60°C)";
+        else modeName = "Turbo (Active Cooling)";
+
+        qInfo() << "Switched Thermal Policy to" << modeName << "(" << policy << ")";
+    }
+}
+
+void ThermalPolicyBackend::revertToAuto()
+{
+    // 0 = Balanced
+    submitIfChanged(HardwareWriteQueue::ThermalPolicy, m_path, 0, nullptr, HardwareWriteQueue::Callback());
+}
+
+QString ThermalPolicyBackend::describe(int percentage) const
+{
+    QString modeName;
+    switch (policyFor(percentage)) {
+    case 2: modeName = QCoreApplication::translate("FanController", "Silent (Absolute Quiet)"); break;
+    case 0: modeName = QCoreApplication::translate("FanController", "Balanced (Starts > 60°C)"); break;
+    case 1: modeName = QCoreApplication::translate("FanController", "Turbo (Always Active)"); break;
+    default: modeName = QCoreApplication::translate("FanController", "Unknown Mode"); break;
+    }
+    return QCoreApplication::translate("FanController", "Mode: %1").arg(modeName);
+}
+
+QString ThermalPolicyBackend::readyMessage() const
+{
+    return QCoreApplication::translate("FanController", "Ready - Using Thermal Policy");
+}
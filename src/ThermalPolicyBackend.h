@@ -0,0 +1,34 @@
+#ifndef THERMALPOLICYBACKEND_H
+#define THERMALPOLICYBACKEND_H
+
+#include "FanBackend.h"
+
+// asus-wmi throttle_thermal_policy. The fan hardware is locked on these
+// models, so the slider maps onto the firmware profiles:
+//   0-33 %   Silent   (policy 2)
+//   34-66 %  Balanced (policy 0)
+//   67-100 % Turbo    (policy 1)
+class ThermalPolicyBackend : public FanBackend
+{
+public:
+    QString name() const override { return "thermal-policy"; }
+    int capabilities() const override { return Profiles | Readback; }
+
+    void apply(int percentage, QObject *context = nullptr,
+               HardwareWriteQueue::Callback onResult = HardwareWriteQueue::Callback()) override;
+    void revertToAuto() override;
+    int readback() const override { return readInt(m_path); }
+    QString describe(int percentage) const override;
+    QString readyMessage() const override;
+
+    static int policyFor(int percentage);
+
+protected:
+    bool detect() override;
+    Probe measure() override;
+
+private:
+    QString m_path;     // .../throttle_thermal_policy
+};
+
+#endif // THERMALPOLICYBACKEND_H
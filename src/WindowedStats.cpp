@@ -0,0 +1,81 @@
+#include "WindowedStats.h"
+
+#include <cmath>
+
+WindowedStats::WindowedStats(int windowSeconds, QObject *parent)
+    : QObject(parent)
+    , m_windowMs(static_cast<qint64>(qMax(1, windowSeconds)) * 1000)
+{
+}
+
+void WindowedStats::setWindowSeconds(int seconds)
+{
+    const qint64 windowMs = static_cast<qint64>(qMax(1, seconds)) * 1000;
+    if (windowMs == m_windowMs) return;
+    m_windowMs = windowMs;
+    emit windowSecondsChanged();
+
+    if (m_samples.empty()) return;
+    const int before = count();
+    expire(m_samples.back().timestampMs);
+    if (count() != before) emit updated();
+}
+
+void WindowedStats::append(qint64 timestampMs, double value)
+{
+    if (!std::isfinite(value)) return;
+
+    m_samples.push_back({ timestampMs, value });
+    m_sum += value;
+    m_sketch.add(value);
+
+    // A new sample retires every deque entry it beats; those could never
+    // become the min (max) again while it is in the window
+    while (!m_min.empty() && m_min.back().value >= value) m_min.pop_back();
+    m_min.push_back({ timestampMs, value });
+    while (!m_max.empty() && m_max.back().value <= value) m_max.pop_back();
+    m_max.push_back({ timestampMs, value });
+
+    expire(timestampMs);
+    emit updated();
+}
+
+void WindowedStats::expire(qint64 nowMs)
+{
+    const qint64 cutoff = nowMs - m_windowMs;
+    while (!m_samples.empty() && m_samples.front().timestampMs <= cutoff) {
+        const Sample &oldest = m_samples.front();
+        m_sum -= oldest.value;
+        m_sketch.remove(oldest.value);
+        ++m_removedSinceResum;
+        m_samples.pop_front();
+    }
+    while (!m_min.empty() && m_min.front().timestampMs <= cutoff) m_min.pop_front();
+    while (!m_max.empty() && m_max.front().timestampMs <= cutoff) m_max.pop_front();
+
+    // Adding and subtracting drifts over days of samples; re-add now and
+    // then (amortised O(1) per sample)
+    if (m_removedSinceResum >= 65536 || m_samples.empty()) {
+        m_sum = 0;
+        for (const Sample &s : m_samples) m_sum += s.value;
+        m_removedSinceResum = 0;
+    }
+}
+
+void WindowedStats::clear()
+{
+    if (m_samples.empty()) return;
+    m_samples.clear();
+    m_min.clear();
+    m_max.clear();
+    m_sum = 0;
+    m_removedSinceResum = 0;
+    m_sketch.clear();
+    emit updated();
+}
+
+double WindowedStats::quantile(double q) const
+{
+    if (m_samples.empty()) return 0.0;
+    return qBound(min(), m_sketch.quantile(q), max());
+}
@@ -0,0 +1,71 @@
+#ifndef WINDOWEDSTATS_H
+#define WINDOWEDSTATS_H
+
+#include <QObject>
+#include <deque>
+#include "QuantileSketch.h"
+
+// Sliding-window aggregates of one metric over the last windowSeconds,
+// updated in O(1) amortised time per sample:
+//
+//   min / max   monotonic deques (each sample enters and leaves each once)
+//   mean        running sum over the samples in the window
+//   quantiles   QuantileSketch, which supports removing expired samples
+//
+// The window is by sample timestamp, so the result doesn't depend on the
+// sampling rate. Quantiles are worked out when read, not per sample.
+class WindowedStats : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(int windowSeconds READ windowSeconds WRITE setWindowSeconds NOTIFY windowSecondsChanged)
+    Q_PROPERTY(int count READ count NOTIFY updated)
+    Q_PROPERTY(double min READ min NOTIFY updated)
+    Q_PROPERTY(double max READ max NOTIFY updated)
+    Q_PROPERTY(double mean READ mean NOTIFY updated)
+    Q_PROPERTY(double p50 READ p50 NOTIFY updated)
+    Q_PROPERTY(double p95 READ p95 NOTIFY updated)
+
+public:
+    explicit WindowedStats(int windowSeconds = 300, QObject *parent = nullptr);
+
+    int windowSeconds() const { return static_cast<int>(m_windowMs / 1000); }
+    // Shrinking drops the samples that fall out at once; growing can only
+    // take in new samples
+    void setWindowSeconds(int seconds);
+
+    // Timestamps must not go backwards; non-finite values are ignored
+    void append(qint64 timestampMs, double value);
+    Q_INVOKABLE void clear();
+
+    int count() const { return static_cast<int>(m_samples.size()); }
+    double min() const { return m_min.empty() ? 0.0 : m_min.front().value; }
+    double max() const { return m_max.empty() ? 0.0 : m_max.front().value; }
+    double mean() const { return m_samples.empty() ? 0.0 : m_sum / m_samples.size(); }
+    double p50() const { return quantile(0.5); }
+    double p95() const { return quantile(0.95); }
+
+    // Within 1 % of the true value, clamped to [min, max]
+    Q_INVOKABLE double quantile(double q) const;
+
+signals:
+    void updated();
+    void windowSecondsChanged();
+
+private:
+    struct Sample {
+        qint64 timestampMs;
+        double value;
+    };
+
+    void expire(qint64 nowMs);
+
+    qint64 m_windowMs;
+    std::deque<Sample> m_samples;   // Everything in the window, oldest first
+    std::deque<Sample> m_min;       // Increasing values: front is the minimum
+    std::deque<Sample> m_max;       // Decreasing values: front is the maximum
+    double m_sum = 0;
+    int m_removedSinceResum = 0;
+    QuantileSketch m_sketch;
+};
+
+#endif // WINDOWEDSTATS_H
@@ -0,0 +1,45 @@
+#ifndef BENCHSUPPORT_H
+#define BENCHSUPPORT_H
+
+#include <QElapsedTimer>
+#include <QVector>
+#include <algorithm>
+#include <cstdio>
+
+// Per-iteration timings for the benchmark programs, reported as
+// mean / p50 / p95 / max in microseconds.
+class BenchTimings
+{
+public:
+    void start() { m_timer.start(); }
+    void stop() { m_ns.append(m_timer.nsecsElapsed()); }
+
+    int count() const { return m_ns.size(); }
+    double meanUs() const
+    {
+        if (m_ns.isEmpty()) return 0;
+        double sum = 0;
+        for (qint64 ns : m_ns) sum += ns;
+        return sum / m_ns.size() / 1000.0;
+    }
+    double quantileUs(double q) const
+    {
+        if (m_ns.isEmpty()) return 0;
+        QVector<qint64> sorted = m_ns;
+        std::sort(sorted.begin(), sorted.end());
+        const int index = std::min(static_cast<int>(q * sorted.size()), static_cast<int>(sorted.size()) - 1);
+        return sorted[index] / 1000.0;
+    }
+
+    void print(const char *label) const
+    {
+        std::printf("%-28s n=%-6d mean %10.1f us   p50 %10.1f us   p95 %10.1f us   max %10.1f us\n",
+                    label, count(), meanUs(), quantileUs(0.5), quantileUs(0.95), quantileUs(1.0));
+    }
+
+private:
+    QElapsedTimer m_timer;
+    QVector<qint64> m_ns;
+};
+
+#endif // BENCHSUPPORT_H
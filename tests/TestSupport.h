@@ -0,0 +1,45 @@
+#ifndef TESTSUPPORT_H
+#define TESTSUPPORT_H
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// Minimal checks for the QtCore-only test programs: a failed CHECK prints
+// where and what, and the program exits non-zero at the end so ctest
+// reports it. No QtTest, so the tests build wherever the app does.
+namespace TestSupport
+{
+    inline int &failures()
+    {
+        static int count = 0;
+        return count;
+    }
+
+    inline bool check(bool ok, const char *expr, const char *file, int line)
+    {
+        if (!ok) {
+            std::fprintf(stderr, "FAIL %s:%d: %s\n", file, line, expr);
+            ++failures();
+        }
+        return ok;
+    }
+
+    // Exit status for main()
+    inline int result(const char *name)
+    {
+        if (failures() == 0) {
+            std::printf("PASS %s\n", name);
+            return EXIT_SUCCESS;
+        }
+        std::fprintf(stderr, "%s: %d check(s) failed\n", name, failures());
+        return EXIT_FAILURE;
+    }
+}
+
+#define CHECK(expr) TestSupport::check(static_cast<bool>(expr), #expr, __FILE__, __LINE__)
+#define CHECK_EQ(a, b) TestSupport::check((a) == (b), #a " == " #b, __FILE__, __LINE__)
+#define CHECK_NEAR(a, b, eps) TestSupport::check(((a) - (b)) <= (eps) && ((b) - (a)) <= (eps), \
+                                                 #a " ~= " #b, __FILE__, __LINE__)
+
+#endif // TESTSUPPORT_H
@@ -0,0 +1,83 @@
+#ifndef TRACESUPPORT_H
+#define TRACESUPPORT_H
+
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QList>
+#include <QVector>
+#include <cstring>
+#include "TelemetryJournal.h"
+
+// Telemetry traces for the benchmarks: either a CSV of record fields (a
+// header row naming the TelemetryJournal::Record fields, '#' lines
+// ignored; fake_hwtree.py --trace writes one) or a copy of an app journal.
+namespace TraceSupport
+{
+    using Record = TelemetryJournal::Record;
+
+    inline bool loadCsv(const QString &path, QVector<Record> *records)
+    {
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly)) return false;
+
+        QHash<QByteArray, int> column;
+        const QList<QByteArray> lines = file.readAll().split('\n');
+        for (const QByteArray &raw : lines) {
+            const QByteArray line = raw.trimmed();
+            if (line.isEmpty() || line.startsWith("#")) continue;
+
+            const QList<QByteArray> fields = line.split(',');
+            if (column.isEmpty()) {
+                for (int i = 0; i < fields.size(); ++i) column.insert(fields[i].trimmed(), i);
+                continue;
+            }
+            auto value = [&](const char *name) {
+                const int i = column.value(name, -1);
+                return i >= 0 && i < fields.size() ? fields[i].toDouble() : 0.0;
+            };
+
+            Record r;
+            std::memset(&r, 0, sizeof(r));
+            r.timestampMs = fields.value(column.value("timestampMs", -1)).toLongLong();
+            r.cpuUsage = static_cast<float>(value("cpuUsage"));
+            r.cpuFreq = static_cast<float>(value("cpuFreq"));
+            r.memoryUsage = static_cast<float>(value("memoryUsage"));
+            r.gpuUsage = static_cast<float>(value("gpuUsage"));
+            r.gpuFreq = static_cast<float>(value("gpuFreq"));
+            r.diskUsage = static_cast<float>(value("diskUsage"));
+            r.netDown = static_cast<float>(value("netDown"));
+            r.netUp = static_cast<float>(value("netUp"));
+            r.cpuTemp = static_cast<qint16>(value("cpuTemp"));
+            r.gpuTemp = static_cast<qint16>(value("gpuTemp"));
+            r.cpuFanRpm = static_cast<quint16>(value("cpuFanRpm"));
+            r.gpuFanRpm = static_cast<quint16>(value("gpuFanRpm"));
+            r.thermalPolicy = static_cast<qint8>(value("thermalPolicy"));
+            r.batteryPercent = static_cast<quint8>(value("batteryPercent"));
+            r.batteryState = static_cast<quint8>(value("batteryState"));
+            records->append(r);
+        }
+        return !column.isEmpty();
+    }
+
+    inline bool loadJournal(const QString &path, QVector<Record> *records)
+    {
+        // Open at the capacity the file already has: any other size would
+        // make TelemetryJournal start the file over
+        const qint64 size = QFileInfo(path).size();
+        if (size <= 4096 || (size - 4096) % sizeof(Record) != 0) return false;
+
+        TelemetryJournal journal(path, static_cast<int>((size - 4096) / sizeof(Record)));
+        if (!journal.isOpen()) return false;
+        journal.replay([records](const Record &record) { records->append(record); });
+        return true;
+    }
+
+    // By extension: *.csv, anything else is taken for a journal
+    inline bool load(const QString &path, QVector<Record> *records)
+    {
+        return path.endsWith(".csv") ? loadCsv(path, records) : loadJournal(path, records);
+    }
+}
+
+#endif // TRACESUPPORT_H
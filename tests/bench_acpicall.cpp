@@ -0,0 +1,90 @@
+// acpi_call round trip: AcpiCallTransport::call() (one descriptor kept
+// open, pwrite + pread, reply parsed in place) against the callACPI path it
+// replaced (QFile + QTextStream, opened and closed twice per call).
+//
+//   bench_acpicall --sysroot=<dir> [iterations]
+//
+// Only runs against a tree built by fake_hwtree.py, whose acpi_call is a
+// plain file: on a real machine every iteration would call an ACPI method.
+// A plain file also costs the transport a stat and a look for canned
+// replies per call, which the real module doesn't, so the gap on hardware
+// is wider; the kernel's own time for the method is not measured.
+
+#include "AcpiCallTransport.h"
+#include "BenchSupport.h"
+#include "SysRoot.h"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QTextStream>
+
+static const char kMethod[] = "\\_SB.PCI0.LPCB.EC0.SFNV";
+
+// The old FanController::callACPI, minus the existence check
+static QString legacyCall(const QString &path, const QString &command)
+{
+    QFile acpiCall(path);
+    if (!acpiCall.open(QIODevice::WriteOnly | QIODevice::Text)) return "Error: Cannot open acpi_call";
+    QTextStream out(&acpiCall);
+    out << command;
+    acpiCall.close();
+
+    if (!acpiCall.open(QIODevice::ReadOnly | QIODevice::Text)) return "Error: Cannot read acpi_call";
+    QTextStream in(&acpiCall);
+    const QString response = in.readAll().trimmed();
+    acpiCall.close();
+    return response;
+}
+
+int main(int argc, char **argv)
+{
+    QCoreApplication app(argc, argv);
+
+    int iterations = 2000;
+    for (int i = 1; i < argc; ++i) {
+        const QString arg = QString::fromLocal8Bit(argv[i]);
+        if (arg.startsWith("--sysroot=")) SysRoot::setRoot(arg.mid(10));
+        else iterations = qMax(1, arg.toInt());
+    }
+    if (!SysRoot::isRelocated()) {
+        std::fprintf(stderr, "usage: %s --sysroot=<fake tree> [iterations]\n", argv[0]);
+        return 2;
+    }
+
+    AcpiCallTransport &transport = AcpiCallTransport::instance();
+    const QString path = transport.path();
+    if (!transport.isAvailable()) {
+        std::fprintf(stderr, "no %s\n", qPrintable(path));
+        return 1;
+    }
+    std::printf("%s, %d iterations\n", qPrintable(path), iterations);
+
+    BenchTimings current;
+    int failures = 0;
+    for (int i = 0; i < iterations; ++i) {
+        const QByteArray args = QByteArray::number(i & 1) + ' ' + QByteArray::number(i & 255);
+        current.start();
+        const AcpiCallTransport::Reply reply = transport.call(kMethod, args);
+        current.stop();
+        if (!reply.ok()) ++failures;
+    }
+
+    BenchTimings legacy;
+    for (int i = 0; i < iterations; ++i) {
+        const QString command = QString("%1 %2 %3").arg(QString::fromLatin1(kMethod)).arg(i & 1).arg(i & 255);
+        legacy.start();
+        const QString response = legacyCall(path, command);
+        legacy.stop();
+        if (response.startsWith("Error")) ++failures;
+    }
+
+    current.print("AcpiCallTransport::call");
+    legacy.print("QFile + QTextStream (old)");
+    std::printf("speedup (mean): %.1fx\n", legacy.meanUs() / qMax(0.001, current.meanUs()));
+
+    if (failures) {
+        std::fprintf(stderr, "%d call(s) failed\n", failures);
+        return 1;
+    }
+    return 0;
+}
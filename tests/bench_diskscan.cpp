@@ -0,0 +1,87 @@
+// Disk refresh latency: BlockDeviceScanner::scan() against the lsblk
+// subprocess readDiskUsage used to run (fork + exec + wait, then a regex
+// and a QMap per output line).
+//
+//   bench_diskscan [--sysroot=<dir>] [iterations]
+//
+// With a sysroot (e.g. one built by fake_hwtree.py) both sides read the
+// same tree: the scanner through SysRoot, lsblk through --sysroot.
+
+#include "BlockDeviceScanner.h"
+#include "BenchSupport.h"
+#include "SysRoot.h"
+
+#include <QCoreApplication>
+#include <QMap>
+#include <QProcess>
+#include <QRegularExpression>
+#include <QStringList>
+
+// The old readDiskUsage, minus its filtering and naming (unchanged by the
+// scanner, so not part of what is compared). Returns the rows, -1 if lsblk
+// could not be run.
+static int legacyLsblkRows()
+{
+    QStringList args;
+    if (SysRoot::isRelocated()) args << "--sysroot" << SysRoot::root();
+    args << "-P" << "-b" << "-o" << "NAME,LABEL,PARTLABEL,MOUNTPOINT,FSTYPE,SIZE,TYPE,FSUSE%,FSAVAIL,PATH";
+
+    QProcess lsblk;
+    lsblk.start("lsblk", args);
+    if (!lsblk.waitForFinished(1500) || lsblk.exitCode() != 0) return -1;
+
+    const QStringList lines = QString(lsblk.readAllStandardOutput()).split('\n', Qt::SkipEmptyParts);
+    int rows = 0;
+    for (const QString &line : lines) {
+        QMap<QString, QString> props;
+        QRegularExpression re("([A-Z%]+)=\"([^\"]*)\"");
+        QRegularExpressionMatchIterator i = re.globalMatch(line);
+        while (i.hasNext()) {
+            QRegularExpressionMatch match = i.next();
+            props[match.captured(1)] = match.captured(2);
+        }
+        if (!props.value("NAME").isEmpty()) ++rows;
+    }
+    return rows;
+}
+
+int main(int argc, char **argv)
+{
+    QCoreApplication app(argc, argv);
+
+    int iterations = 200;
+    for (int i = 1; i < argc; ++i) {
+        const QString arg = QString::fromLocal8Bit(argv[i]);
+        if (arg.startsWith("--sysroot=")) SysRoot::setRoot(arg.mid(10));
+        else iterations = qMax(1, arg.toInt());
+    }
+    std::printf("root: %s, %d iterations\n",
+                SysRoot::isRelocated() ? qPrintable(SysRoot::root()) : "/", iterations);
+
+    BenchTimings scanner;
+    int scannerRows = 0;
+    for (int i = 0; i < iterations; ++i) {
+        scanner.start();
+        scannerRows = BlockDeviceScanner::scan().size();
+        scanner.stop();
+    }
+
+    BenchTimings legacy;
+    int legacyRows = 0;
+    for (int i = 0; i < iterations && legacyRows >= 0; ++i) {
+        legacy.start();
+        legacyRows = legacyLsblkRows();
+        legacy.stop();
+    }
+
+    scanner.print("BlockDeviceScanner::scan");
+    std::printf("  rows: %d\n", scannerRows);
+    if (legacyRows < 0) {
+        std::printf("lsblk not available, no baseline\n");
+        return 0;
+    }
+    legacy.print("lsblk -P + regex (old)");
+    std::printf("  rows: %d\n", legacyRows);
+    std::printf("speedup (mean): %.1fx\n", legacy.meanUs() / qMax(0.001, scanner.meanUs()));
+    return 0;
+}
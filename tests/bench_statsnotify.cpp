@@ -0,0 +1,106 @@
+// SystemStatsMonitor change notifications on a recorded trace: the single
+// statsChanged every pass used to emit, against StatsPublisher's deadbanded
+// groups, and the QML binding evaluations each one costs.
+//
+//   bench_statsnotify <trace> [usage deadband] [freq deadband] [rate deadband]
+//
+// Each record is replayed as one hub pass, with a network pass every 4th
+// and a disk refresh every 20th (the monitor's 500 ms / 2 s / 10 s
+// periods). Journal records are one per second, so consecutive passes
+// differ more than real 500 ms passes do: the grouped counts are an upper
+// bound. The trace has no sysfs savings, so diagnosticsChanged is not
+// exercised.
+
+#include "StatsPublisher.h"
+#include "TraceSupport.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+// Bindings on each group's properties in ui/ (one per line that reads
+// monitor.<property>, counted with grep). Update with the pages.
+static int bindings(StatsPublisher::Group group)
+{
+    switch (group) {
+    case StatsPublisher::Cpu: return 3;
+    case StatsPublisher::Gpu: return 3;
+    case StatsPublisher::Memory: return 1;
+    case StatsPublisher::Network: return 2;
+    case StatsPublisher::Disks: return 2;       // Plus the partition Repeater's model
+    case StatsPublisher::Battery: return 30;
+    case StatsPublisher::Diagnostics: return 0;
+    }
+    return 0;
+}
+
+static SensorSnapshot snapshotOf(const TelemetryJournal::Record &record)
+{
+    SensorSnapshot s;
+    s.cpuUsage = record.cpuUsage;
+    s.cpuFreq = record.cpuFreq;
+    s.memoryUsage = record.memoryUsage;
+    s.gpuUsage = record.gpuUsage;
+    s.gpuFreq = record.gpuFreq;
+    s.batteryPercent = record.batteryPercent;
+    s.batteryState = static_cast<SensorSnapshot::BatteryState>(record.batteryState);
+    s.timestampMs = record.timestampMs;
+    return s;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <trace.csv | journal> [usage] [freq] [rate deadband]\n", argv[0]);
+        return 2;
+    }
+
+    QVector<TelemetryJournal::Record> records;
+    if (!TraceSupport::load(QString::fromLocal8Bit(argv[1]), &records) || records.isEmpty()) {
+        std::fprintf(stderr, "no records in %s\n", argv[1]);
+        return 1;
+    }
+
+    StatsPublisher publisher;
+    if (argc > 2) publisher.setUsageDeadband(std::atof(argv[2]));
+    if (argc > 3) publisher.setFreqDeadband(std::atof(argv[3]));
+    if (argc > 4) publisher.setRateDeadband(std::atof(argv[4]));
+
+    int totalBindings = 0;
+    for (int i = 0; i < StatsPublisher::kGroupCount; ++i) {
+        totalBindings += bindings(static_cast<StatsPublisher::Group>(1 << i));
+    }
+
+    for (int i = 0; i < records.size(); ++i) {
+        const TelemetryJournal::Record &record = records[i];
+        publisher.publishSnapshot(snapshotOf(record));
+        if (i % 4 == 3) publisher.publishNetwork(record.netDown, record.netUp);
+        if (i % 20 == 19) publisher.publishDisks(record.diskUsage, false, false);
+    }
+
+    // Replayed at 2 passes per second
+    const double minutes = records.size() / 2.0 / 60.0;
+    const quint64 passes = publisher.passes();
+    std::printf("%s: %d records, deadbands %.2f %% / %.2f MHz / %.2f KB/s\n\n", argv[1], records.size(),
+                publisher.usageDeadband(), publisher.freqDeadband(), publisher.rateDeadband());
+    std::printf("%-20s %10s %10s %12s %14s\n", "signal", "emitted", "per min", "bindings", "evals per min");
+
+    std::printf("%-20s %10llu %10.1f %12d %14.1f\n", "statsChanged (old)", static_cast<unsigned long long>(passes),
+                passes / minutes, totalBindings, passes * totalBindings / minutes);
+
+    quint64 emitted = 0;
+    double evaluations = 0;
+    for (int i = 0; i < StatsPublisher::kGroupCount; ++i) {
+        const auto group = static_cast<StatsPublisher::Group>(1 << i);
+        const quint64 count = publisher.notifications(group);
+        emitted += count;
+        evaluations += static_cast<double>(count) * bindings(group);
+        std::printf("%-20s %10llu %10.1f %12d %14.1f\n", StatsPublisher::groupSignal(group),
+                    static_cast<unsigned long long>(count), count / minutes, bindings(group),
+                    count * bindings(group) / minutes);
+    }
+    std::printf("%-20s %10llu %10.1f %12s %14.1f\n", "grouped total", static_cast<unsigned long long>(emitted),
+                emitted / minutes, "", evaluations / minutes);
+    std::printf("\nbinding evaluations: %.1fx fewer\n",
+                evaluations > 0 ? passes * totalBindings / evaluations : 0.0);
+    return 0;
+}
@@ -0,0 +1,133 @@
+// TelemetryBlock against the uncompressed 64-byte journal record: bytes per
+// sample, and encode/decode time per sample, on a recorded trace.
+//
+//   bench_telemetryblock <trace> [repeats]
+//
+// The trace is a CSV of record fields or a copy of an app journal (see
+// TraceSupport.h), e.g.
+//
+//   sudo cp /var/lib/asus-tuf-fan-control/telemetry.journal /tmp/tuf.journal
+//   bench_telemetryblock /tmp/tuf.journal
+//
+// Blocks are cut the way TelemetryArchive cuts them (kBlockSpanMs), and
+// every decoded record is compared with its source, so a lossy round trip
+// fails the run.
+
+#include "BenchSupport.h"
+#include "TelemetryBlock.h"
+#include "TraceSupport.h"
+
+#include <cstddef>
+#include <cstring>
+
+using Record = TelemetryJournal::Record;
+
+// Sampled values only: sequence and checksum belong to the journal
+static bool sameSample(const Record &a, const Record &b)
+{
+    return a.timestampMs == b.timestampMs &&
+           std::memcmp(&a.cpuUsage, &b.cpuUsage, offsetof(Record, reserved) - offsetof(Record, cpuUsage)) == 0;
+}
+
+struct Block {
+    TelemetryBlock::Summary summary;
+    QByteArray payload;
+};
+
+static QVector<Block> encode(const QVector<Record> &records)
+{
+    QVector<Block> blocks;
+    TelemetryBlock::Encoder encoder;
+    for (const Record &record : records) {
+        if (!encoder.isEmpty() &&
+            record.timestampMs - encoder.summary().startMs >= TelemetryBlock::kBlockSpanMs) {
+            const TelemetryBlock::Summary summary = encoder.summary();
+            blocks.append({ summary, encoder.finish() });
+        }
+        encoder.append(record);
+    }
+    if (!encoder.isEmpty()) {
+        const TelemetryBlock::Summary summary = encoder.summary();
+        blocks.append({ summary, encoder.finish() });
+    }
+    return blocks;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <trace.csv | journal> [repeats]\n", argv[0]);
+        return 2;
+    }
+    const QString path = QString::fromLocal8Bit(argv[1]);
+    const int repeats = argc > 2 ? qMax(1, std::atoi(argv[2])) : 20;
+
+    QVector<Record> records;
+    if (!TraceSupport::load(path, &records) || records.isEmpty()) {
+        std::fprintf(stderr, "no records in %s\n", argv[1]);
+        return 1;
+    }
+    const double n = records.size();
+    std::printf("%s: %d records, %.1f h\n", argv[1], records.size(),
+                (records.last().timestampMs - records.first().timestampMs) / 3600000.0);
+
+    // Uncompressed: the journal's append is one record-sized copy
+    BenchTimings rawEncode, rawDecode;
+    QByteArray raw;
+    volatile quint64 sink = 0;
+    for (int rep = 0; rep < repeats; ++rep) {
+        rawEncode.start();
+        raw = QByteArray(records.size() * static_cast<int>(sizeof(Record)), Qt::Uninitialized);
+        for (int i = 0; i < records.size(); ++i) {
+            std::memcpy(raw.data() + i * sizeof(Record), &records[i], sizeof(Record));
+        }
+        rawEncode.stop();
+
+        rawDecode.start();
+        Record record;
+        for (int i = 0; i < records.size(); ++i) {
+            std::memcpy(&record, raw.constData() + i * sizeof(Record), sizeof(Record));
+            sink += record.cpuTemp;
+        }
+        rawDecode.stop();
+    }
+
+    BenchTimings blockEncode, blockDecode;
+    QVector<Block> blocks;
+    int mismatches = 0;
+    for (int rep = 0; rep < repeats; ++rep) {
+        blockEncode.start();
+        blocks = encode(records);
+        blockEncode.stop();
+
+        blockDecode.start();
+        int index = 0;
+        for (const Block &block : blocks) {
+            TelemetryBlock::Decoder decoder(block.summary, block.payload);
+            Record record;
+            while (decoder.next(&record)) {
+                if (index >= records.size() || !sameSample(record, records[index])) ++mismatches;
+                ++index;
+            }
+        }
+        blockDecode.stop();
+        if (index != records.size()) ++mismatches;
+    }
+
+    qint64 blockBytes = 0;
+    for (const Block &block : blocks) blockBytes += block.payload.size() + sizeof(TelemetryBlock::Summary);
+
+    std::printf("%d blocks, %d repeats\n\n", blocks.size(), repeats);
+    std::printf("%-14s %10s %14s %14s\n", "", "bytes/rec", "encode ns/rec", "decode ns/rec");
+    std::printf("%-14s %10.2f %14.1f %14.1f\n", "uncompressed", static_cast<double>(sizeof(Record)),
+                rawEncode.meanUs() * 1000 / n, rawDecode.meanUs() * 1000 / n);
+    std::printf("%-14s %10.2f %14.1f %14.1f\n", "TelemetryBlock", blockBytes / n,
+                blockEncode.meanUs() * 1000 / n, blockDecode.meanUs() * 1000 / n);
+    std::printf("\nratio %.1fx (payload + summary per block)\n", sizeof(Record) * n / blockBytes);
+
+    if (mismatches) {
+        std::fprintf(stderr, "FAIL: %d records did not round-trip\n", mismatches);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,161 @@
+// WindowedStats at 100 metrics x 10 Hz with a 300 s window: cost of a
+// sampling tick (one append per metric) and of reading every metric's
+// aggregates, as the stats page does once a second.
+//
+//   bench_windowedstats [simulated seconds] [metrics] [hz] [window seconds]
+//
+// Periodically one metric is checked against a brute-force window: count,
+// min, max and mean must match, p50/p95/p99 must be within the sketch's
+// relative accuracy. A mismatch fails the run.
+
+#include "BenchSupport.h"
+#include "WindowedStats.h"
+
+#include <QCoreApplication>
+#include <cmath>
+#include <deque>
+#include <memory>
+#include <vector>
+
+// Deterministic stand-ins for the kinds of metric SystemStatsMonitor feeds
+class MetricSource
+{
+public:
+    explicit MetricSource(int index) : m_kind(index % 4), m_state(0x9E3779B97F4A7C15ULL * (index + 1)) {}
+
+    double next()
+    {
+        switch (m_kind) {
+        case 0:     // Temperature, whole degrees
+            m_value = qBound(30.0, m_value + (uniform() - 0.5) * 2.0, 95.0);
+            return std::round(m_value);
+        case 1:     // Fan RPM, off for long stretches
+            m_value = qBound(0.0, m_value + (uniform() - 0.5) * 400.0, 6000.0);
+            return m_value < 1500 ? 0.0 : std::round(m_value);
+        case 2:     // Percent
+            m_value = qBound(0.0, m_value + (uniform() - 0.5) * 10.0, 100.0);
+            return m_value;
+        default:    // Network KB/s: mostly idle, with bursts
+            return uniform() < 0.7 ? 0.0 : uniform() * uniform() * 100000.0;
+        }
+    }
+
+private:
+    double uniform()
+    {
+        m_state ^= m_state << 13;
+        m_state ^= m_state >> 7;
+        m_state ^= m_state << 17;
+        return (m_state >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    int m_kind;
+    quint64 m_state;
+    double m_value = 50;
+};
+
+static bool near(double actual, double expected, double relative)
+{
+    return std::fabs(actual - expected) <= relative * std::fabs(expected) + 1e-9;
+}
+
+// Returns the number of mismatches
+static int verify(const WindowedStats &stats, const std::deque<double> &window, int metric)
+{
+    std::vector<double> sorted(window.begin(), window.end());
+    std::sort(sorted.begin(), sorted.end());
+    double sum = 0;
+    for (double v : sorted) sum += v;
+
+    int failures = 0;
+    auto expect = [&](bool ok, const char *what, double actual, double expected) {
+        if (ok) return;
+        std::fprintf(stderr, "FAIL metric %d %s: %g, brute force %g\n", metric, what, actual, expected);
+        ++failures;
+    };
+    expect(stats.count() == static_cast<int>(sorted.size()), "count", stats.count(), sorted.size());
+    if (sorted.empty()) return failures;
+    expect(stats.min() == sorted.front(), "min", stats.min(), sorted.front());
+    expect(stats.max() == sorted.back(), "max", stats.max(), sorted.back());
+    expect(near(stats.mean(), sum / sorted.size(), 1e-9), "mean", stats.mean(), sum / sorted.size());
+
+    for (double q : { 0.5, 0.95, 0.99 }) {
+        const double exact = sorted[static_cast<size_t>(q * (sorted.size() - 1))];
+        expect(near(stats.quantile(q), exact, QuantileSketch::kRelativeAccuracy), "quantile",
+               stats.quantile(q), exact);
+    }
+    return failures;
+}
+
+int main(int argc, char **argv)
+{
+    QCoreApplication app(argc, argv);
+
+    const int seconds = argc > 1 ? std::atoi(argv[1]) : 1800;
+    const int metrics = argc > 2 ? std::atoi(argv[2]) : 100;
+    const int hz = argc > 3 ? std::atoi(argv[3]) : 10;
+    const int windowSeconds = argc > 4 ? std::atoi(argv[4]) : 300;
+    const qint64 periodMs = 1000 / hz;
+
+    std::vector<std::unique_ptr<WindowedStats>> stats;
+    std::vector<MetricSource> sources;
+    for (int m = 0; m < metrics; ++m) {
+        stats.emplace_back(new WindowedStats(windowSeconds));
+        sources.emplace_back(m);
+    }
+
+    // Brute-force windows, kept outside the timed part
+    std::vector<std::deque<std::pair<qint64, double>>> brute(metrics);
+    int checked = 0;
+    int failures = 0;
+
+    BenchTimings tick, read;
+    std::vector<double> values(metrics);
+    volatile double sink = 0;
+    const int ticks = seconds * hz;
+
+    for (int t = 0; t < ticks; ++t) {
+        const qint64 now = t * periodMs;
+        for (int m = 0; m < metrics; ++m) values[m] = sources[m].next();
+
+        tick.start();
+        for (int m = 0; m < metrics; ++m) stats[m]->append(now, values[m]);
+        tick.stop();
+
+        for (int m = 0; m < metrics; ++m) {
+            brute[m].emplace_back(now, values[m]);
+            while (brute[m].front().first <= now - windowSeconds * 1000LL) brute[m].pop_front();
+        }
+
+        if ((t + 1) % hz == 0) {
+            read.start();
+            for (int m = 0; m < metrics; ++m) {
+                const WindowedStats &s = *stats[m];
+                sink += s.count() + s.min() + s.max() + s.mean() + s.p50() + s.p95();
+            }
+            read.stop();
+        }
+
+        // Once a simulated minute, check one metric and move on to the next
+        if ((t + 1) % (60 * hz) == 0) {
+            std::deque<double> window;
+            for (const auto &sample : brute[checked]) window.push_back(sample.second);
+            failures += verify(*stats[checked], window, checked);
+            checked = (checked + 1) % metrics;
+        }
+    }
+
+    std::printf("%d metrics x %d Hz, %d s window, %d s simulated (%d samples per metric)\n\n",
+                metrics, hz, windowSeconds, seconds, ticks);
+    tick.print("tick (append every metric)");
+    read.print("read (all aggregates)");
+    std::printf("\nappend %.1f ns/sample, read %.1f ns/metric\n",
+                tick.meanUs() * 1000 / metrics, read.meanUs() * 1000 / metrics);
+    std::printf("sampling load %.4f%% of one core\n", tick.meanUs() * hz / 1e6 * 100);
+
+    if (failures) {
+        std::fprintf(stderr, "%d mismatch(es) against the brute-force window\n", failures);
+        return 1;
+    }
+    return 0;
+}
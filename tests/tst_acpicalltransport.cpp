@@ -0,0 +1,208 @@
+// AcpiCallTransport against a plain file standing in for /proc/acpi/call:
+// reply parsing, canned replies, batches, reopening after the file goes
+// away, and AcpiFanBackend's method detection driven by those replies.
+//
+//   tst_acpicalltransport
+
+#include "AcpiCallTransport.h"
+#include "AcpiFanBackend.h"
+#include "TestSupport.h"
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <string>
+
+using Reply = AcpiCallTransport::Reply;
+
+static bool writeFile(const std::string &path, const std::string &text)
+{
+    FILE *out = std::fopen(path.c_str(), "wb");
+    if (!out) return false;
+    const bool ok = std::fwrite(text.data(), 1, text.size(), out) == text.size();
+    return std::fclose(out) == 0 && ok;
+}
+
+static std::string readFile(const std::string &path)
+{
+    FILE *in = std::fopen(path.c_str(), "rb");
+    if (!in) return std::string();
+    char data[4096];
+    const size_t n = std::fread(data, 1, sizeof(data), in);
+    std::fclose(in);
+    return std::string(data, n);
+}
+
+static Reply parse(const char *text)
+{
+    return AcpiCallTransport::parse(text, static_cast<int>(std::strlen(text)));
+}
+
+static void testParse()
+{
+    Reply reply = parse("0x1234\n");
+    CHECK_EQ(reply.type, Reply::Integer);
+    CHECK_EQ(reply.integer, 0x1234ULL);
+    CHECK(reply.toString() == "0x1234");
+
+    reply = parse("{0x01, 0xff, 0x80}");
+    CHECK_EQ(reply.type, Reply::Buffer);
+    CHECK(reply.data == QByteArray("\x01\xff\x80", 3));
+    CHECK(reply.toString() == "{0x01, 0xff, 0x80}");
+
+    reply = parse("\"FX506HM\"");
+    CHECK_EQ(reply.type, Reply::String);
+    CHECK(reply.data == "FX506HM");
+
+    reply = parse("[0x1, 0x2]");
+    CHECK_EQ(reply.type, Reply::Package);
+    CHECK(reply.data == "[0x1, 0x2]");
+
+    // What a plain file echoes back
+    reply = parse("\\_SB.PCI0.LPCB.EC0.SFNV 0 255");
+    CHECK_EQ(reply.type, Reply::Raw);
+    CHECK(reply.ok());
+
+    reply = parse("0xzz");
+    CHECK_EQ(reply.type, Reply::Raw);
+
+    reply = parse("Error: AE_NOT_FOUND\n");
+    CHECK_EQ(reply.type, Reply::Error);
+    CHECK(!reply.ok());
+    CHECK(reply.data == "AE_NOT_FOUND");
+    CHECK(reply.toString() == "Error: AE_NOT_FOUND");
+
+    reply = parse("not called");
+    CHECK_EQ(reply.type, Reply::Error);
+    CHECK(reply.data == "not called");
+
+    reply = parse("\n");
+    CHECK_EQ(reply.type, Reply::Error);
+}
+
+static void testCalls(const std::string &dir)
+{
+    AcpiCallTransport &transport = AcpiCallTransport::instance();
+    const std::string call = dir + "/call";
+    const std::string replies = call + ".replies";
+    CHECK(writeFile(call, ""));
+    transport.setPath(QString::fromStdString(call));
+    CHECK(transport.isAvailable());
+
+    // No canned reply: the command reads back
+    Reply reply = transport.call("\\_SB.ATKD.QMOD", "1");
+    CHECK_EQ(reply.type, Reply::Raw);
+    CHECK(reply.data == "\\_SB.ATKD.QMOD 1");
+    CHECK_EQ(readFile(call), std::string("\\_SB.ATKD.QMOD 1"));
+
+    // Shorter command after a longer one: the file is truncated
+    transport.call("\\_SB.X");
+    CHECK_EQ(readFile(call), std::string("\\_SB.X"));
+
+    CHECK(writeFile(replies, "\\_SB.EC0.SFNV 1\tError: AE_BAD_PARAMETER\n"
+                             "\\_SB.EC0.SFNV\t0x0\n"
+                             "\\_SB.EC0.GBUF\t{0x10, 0x20}\n"
+                             "\\_SB.EC0.NAME\t\"TUF\"\n"
+                             "\\_SB\tError: AE_NOT_FOUND\n"));
+    reply = transport.call("\\_SB.EC0.SFNV", "0 128");
+    CHECK_EQ(reply.type, Reply::Integer);
+    CHECK_EQ(reply.integer, 0ULL);
+    reply = transport.call("\\_SB.EC0.SFNV", "1 128");
+    CHECK_EQ(reply.type, Reply::Error);
+    CHECK(reply.data == "AE_BAD_PARAMETER");
+    reply = transport.call("\\_SB.EC0.GBUF");
+    CHECK_EQ(reply.type, Reply::Buffer);
+    CHECK(reply.data == QByteArray("\x10\x20", 2));
+    reply = transport.call("\\_SB.EC0.NAME");
+    CHECK_EQ(reply.type, Reply::String);
+    reply = transport.call("\\_SB.PCI0.NONE");
+    CHECK(!reply.ok());
+    CHECK(reply.data == "AE_NOT_FOUND");
+    // A command no line matches still reads back
+    CHECK_EQ(transport.call("\\_TZ.THRM").type, Reply::Raw);
+
+    // Batches: all calls, or up to the first failure
+    const QVector<AcpiCallTransport::Call> calls = {
+        { "\\_SB.EC0.SFNV", "0 0" }, { "\\_SB.EC0.SFNV", "1 0" }, { "\\_SB.EC0.GBUF", QByteArray() }
+    };
+    QVector<Reply> batch = transport.batch(calls);
+    CHECK_EQ(batch.size(), 3);
+    if (batch.size() == 3) CHECK_EQ(batch[2].type, Reply::Buffer);
+    batch = transport.batch(calls, true);
+    CHECK_EQ(batch.size(), 2);
+    if (batch.size() == 2) {
+        CHECK(batch[0].ok());
+        CHECK(!batch[1].ok());
+    }
+    // The failed call was the last one to reach the file
+    CHECK_EQ(readFile(call), std::string("\\_SB.EC0.SFNV 1 0"));
+
+    // Module unloaded: the file goes away and the descriptor with it
+    CHECK(::unlink(call.c_str()) == 0);
+    reply = transport.call("\\_SB.EC0.SFNV", "0 0");
+    CHECK(!reply.ok());
+    CHECK(reply.data == "acpi_call not available");
+
+    // ...and reloaded: a new file, reopened on the next call
+    CHECK(writeFile(call, "stale"));
+    reply = transport.call("\\_SB.EC0.SFNV", "0 64");
+    CHECK_EQ(reply.type, Reply::Integer);
+    CHECK_EQ(readFile(call), std::string("\\_SB.EC0.SFNV 0 64"));
+
+    // Replaced while open (rename over it): the old inode isn't written
+    const std::string next = dir + "/call.next";
+    CHECK(writeFile(next, ""));
+    CHECK(::rename(next.c_str(), call.c_str()) == 0);
+    transport.call("\\_SB.EC0.SFNV", "0 32");
+    CHECK_EQ(readFile(call), std::string("\\_SB.EC0.SFNV 0 32"));
+
+    ::unlink(replies.c_str());
+    ::unlink(call.c_str());
+}
+
+static void testFanDetection(const std::string &dir)
+{
+    const std::string call = dir + "/call";
+    const std::string replies = call + ".replies";
+    CHECK(writeFile(call, ""));
+    AcpiCallTransport::instance().setPath(QString::fromStdString(call));
+
+    // Every SFNV path is missing, FANC answers for the CPU fan only
+    CHECK(writeFile(replies, "\\_SB.PCI0.SBRG.EC0.FANC 1\tError: AE_BAD_PARAMETER\n"
+                             "\\_SB.PCI0.SBRG.EC0.FANC\t0x0\n"
+                             "\\_SB\tError: AE_NOT_FOUND\n"));
+    AcpiFanBackend fanc;
+    const FanBackend::Probe &probe = fanc.probe();
+    CHECK(probe.available);
+    CHECK(!probe.faithful);
+    CHECK(fanc.method() == "\\_SB.PCI0.SBRG.EC0.FANC");
+    CHECK_EQ(fanc.capabilities(), static_cast<int>(FanBackend::DutyCycle));
+
+    // Nothing answers
+    CHECK(writeFile(replies, "\\\tError: AE_NOT_FOUND\n"));
+    AcpiFanBackend none;
+    CHECK(!none.probe().available);
+    CHECK(none.method().isEmpty());
+
+    // A plain file without replies echoes, so the first path is taken,
+    // with both fans
+    ::unlink(replies.c_str());
+    AcpiFanBackend echo;
+    CHECK(echo.probe().available);
+    CHECK(echo.method() == "\\_SB.PCI0.LPCB.EC0.SFNV");
+    CHECK(echo.capabilities() & FanBackend::PerFan);
+
+    ::unlink(call.c_str());
+}
+
+int main()
+{
+    char dir[] = "/tmp/tst_acpicalltransport.XXXXXX";
+    if (!::mkdtemp(dir)) return EXIT_FAILURE;
+
+    testParse();
+    testCalls(dir);
+    testFanDetection(dir);
+
+    ::rmdir(dir);
+    return TestSupport::result("tst_acpicalltransport");
+}
@@ -0,0 +1,118 @@
+// ArcGauge's sweep update (copy the grown range out of the cached
+// tessellation, rewrite the end cap, collapse what the longer sweep used)
+// against a gauge tessellated from scratch at the same value, for a run of
+// random values: the progress strips, the knob position and the visibility
+// must be the same.
+//
+//   tst_arcgauge [values]
+
+#include "ArcGauge.h"
+#include "TestSupport.h"
+
+#include <QGuiApplication>
+#include <QSGGeometryNode>
+#include <QSGOpacityNode>
+#include <QSGTransformNode>
+#include <cmath>
+#include <random>
+
+class Gauge : public ArcGauge
+{
+public:
+    QSGNode *sync(QSGNode *node) { return updatePaintNode(node, nullptr); }
+};
+
+// Root: shadow, track, progress (main, glow, knob transform), ticks
+static const QSGOpacityNode *progressNode(const QSGNode *root)
+{
+    return static_cast<const QSGOpacityNode *>(root->childAtIndex(2));
+}
+
+static const QSGGeometry *strip(const QSGNode *root, int index)
+{
+    return static_cast<const QSGGeometryNode *>(progressNode(root)->childAtIndex(index))->geometry();
+}
+
+static const QMatrix4x4 &knob(const QSGNode *root)
+{
+    return static_cast<const QSGTransformNode *>(progressNode(root)->childAtIndex(2))->matrix();
+}
+
+// Largest position difference over the strip, -1 on a count or colour
+// mismatch
+static double compare(const QSGGeometry *a, const QSGGeometry *b)
+{
+    if (a->vertexCount() != b->vertexCount()) return -1;
+    const QSGGeometry::ColoredPoint2D *va = a->vertexDataAsColoredPoint2D();
+    const QSGGeometry::ColoredPoint2D *vb = b->vertexDataAsColoredPoint2D();
+    double worst = 0;
+    for (int i = 0; i < a->vertexCount(); ++i) {
+        if (va[i].r != vb[i].r || va[i].g != vb[i].g || va[i].b != vb[i].b || va[i].a != vb[i].a) return -1;
+        worst = qMax(worst, double(std::fabs(va[i].x - vb[i].x) + std::fabs(va[i].y - vb[i].y)));
+    }
+    return worst;
+}
+
+static void setUp(Gauge *gauge)
+{
+    gauge->setSize(QSizeF(220, 220));
+    gauge->setArcRadius(82);
+    gauge->setMaxValue(6000);
+    gauge->setGlowOpacity(0.25);
+}
+
+int main(int argc, char **argv)
+{
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+    QGuiApplication app(argc, argv);
+    const int values = argc > 1 ? qMax(1, atoi(argv[1])) : 2000;
+
+    Gauge gauge;
+    setUp(&gauge);
+    QSGNode *node = gauge.sync(nullptr);
+
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<int> rpm(0, 6000);
+    double worst = 0;
+    int visible = 0, hidden = 0, mismatches = 0;
+    for (int i = 0; i < values; ++i) {
+        // Mostly random jumps; every tenth value pins an end of the range
+        const int value = i % 10 == 3 ? 0 : i % 10 == 7 ? 6000 : rpm(rng);
+        gauge.setValue(value);
+        node = gauge.sync(node);
+
+        Gauge reference;
+        setUp(&reference);
+        reference.setValue(value);
+        QSGNode *fresh = reference.sync(nullptr);
+
+        const double opacity = progressNode(node)->opacity();
+        if (opacity != progressNode(fresh)->opacity()) {
+            ++mismatches;
+        } else if (opacity > 0) {
+            // Hidden strips keep whatever they last showed; only compare
+            // what is drawn
+            ++visible;
+            const double main = compare(strip(node, 0), strip(fresh, 0));
+            const double glow = compare(strip(node, 1), strip(fresh, 1));
+            const QPointF at = knob(node).map(QPointF(0, 0));
+            const QPointF want = knob(fresh).map(QPointF(0, 0));
+            if (main < 0 || glow < 0) ++mismatches;
+            worst = qMax(worst, qMax(main, glow));
+            worst = qMax(worst, std::fabs(at.x() - want.x()) + std::fabs(at.y() - want.y()));
+        } else {
+            ++hidden;
+        }
+        delete fresh;
+    }
+
+    CHECK_EQ(mismatches, 0);
+    CHECK(worst < 1e-3);
+    CHECK(visible > 0);
+    CHECK(values < 10 || hidden > 0);
+    std::printf("%d values (%d visible, %d hidden), worst vertex difference %g px\n",
+                values, visible, hidden, worst);
+
+    delete node;
+    return TestSupport::result("tst_arcgauge");
+}
@@ -0,0 +1,328 @@
+// EmbeddedController and EcFanBackend against plain files: the 256 byte
+// ec_sys io file, and a stand-in for /dev/port to run the 0x62/0x66
+// handshake. pwrite() is interposed to count what reaches the "EC".
+//
+//   tst_embeddedcontroller
+
+#include "EcFanBackend.h"
+#include "EmbeddedController.h"
+#include "HardwareWriteQueue.h"
+#include "SysRoot.h"
+#include "TestSupport.h"
+
+#include <QElapsedTimer>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// Every pwrite the code under test makes, as (offset, length)
+struct PwriteCall {
+    long long offset;
+    size_t length;
+};
+static std::mutex g_logMutex;
+static std::vector<PwriteCall> g_pwrites;
+
+static ssize_t loggedPwrite(int fd, const void *buf, size_t count, long long offset)
+{
+    {
+        std::lock_guard<std::mutex> lock(g_logMutex);
+        g_pwrites.push_back({ offset, count });
+    }
+    return ::syscall(SYS_pwrite64, fd, buf, count, offset);
+}
+
+extern "C" ssize_t pwrite(int fd, const void *buf, size_t count, off_t offset)
+{
+    return loggedPwrite(fd, buf, count, offset);
+}
+
+extern "C" ssize_t pwrite64(int fd, const void *buf, size_t count, off64_t offset)
+{
+    return loggedPwrite(fd, buf, count, offset);
+}
+
+static std::vector<PwriteCall> takePwrites()
+{
+    std::lock_guard<std::mutex> lock(g_logMutex);
+    std::vector<PwriteCall> calls;
+    calls.swap(g_pwrites);
+    return calls;
+}
+
+static bool writeFile(const std::string &path, const std::string &data)
+{
+    const size_t slash = path.rfind('/');
+    for (size_t i = 1; i <= slash; ++i) {
+        if (path[i] == '/') ::mkdir(path.substr(0, i).c_str(), 0755);
+    }
+    FILE *out = std::fopen(path.c_str(), "wb");
+    if (!out) return false;
+    const bool ok = std::fwrite(data.data(), 1, data.size(), out) == data.size();
+    return std::fclose(out) == 0 && ok;
+}
+
+// Byte access that bypasses the pwrite log
+static int byteAt(const std::string &path, int offset)
+{
+    FILE *in = std::fopen(path.c_str(), "rb");
+    if (!in) return -1;
+    std::fseek(in, offset, SEEK_SET);
+    const int c = std::fgetc(in);
+    std::fclose(in);
+    return c;
+}
+
+static void setByte(const std::string &path, int offset, int value)
+{
+    FILE *out = std::fopen(path.c_str(), "r+b");
+    if (!out) return;
+    std::fseek(out, offset, SEEK_SET);
+    std::fputc(value, out);
+    std::fclose(out);
+}
+
+static void testDebugFs(const std::string &dir)
+{
+    EmbeddedController &ec = EmbeddedController::instance();
+    const std::string io = dir + "/io";
+    CHECK(writeFile(io, std::string(256, '\0')));
+    ec.setPath(QString::fromStdString(io));
+    CHECK_EQ(ec.method(), EmbeddedController::DebugFs);
+    takePwrites();
+
+    // 0x2f..0x31 is one run, 0x40 another
+    QString error;
+    CHECK(ec.batch({ { 0x2f, 1 }, { 0x30, 0x80 }, { 0x31, 0x81 }, { 0x40, 5 } }, &error));
+    const std::vector<PwriteCall> calls = takePwrites();
+    CHECK_EQ(calls.size(), size_t(2));
+    if (calls.size() == 2) {
+        CHECK_EQ(calls[0].offset, 0x2fLL);
+        CHECK_EQ(calls[0].length, size_t(3));
+        CHECK_EQ(calls[1].offset, 0x40LL);
+        CHECK_EQ(calls[1].length, size_t(1));
+    }
+    CHECK_EQ(byteAt(io, 0x31), 0x81);
+
+    CHECK_EQ(ec.read(0x2f), 1);
+    CHECK_EQ(ec.read(0x30), 0x80);
+    CHECK_EQ(ec.read(0x41), 0);
+    CHECK_EQ(ec.read(256), -1);
+    CHECK_EQ(ec.read(-1), -1);
+
+    // Out of range: refused before anything is written
+    CHECK(!ec.write(0x10, 256, &error));
+    CHECK(!ec.batch({ { 0x10, 1 }, { 300, 1 } }, &error));
+    CHECK(takePwrites().empty());
+    CHECK_EQ(byteAt(io, 0x10), 0);
+
+    ::unlink(io.c_str());
+}
+
+static void testLookup(const std::string &dir)
+{
+    const std::string map = dir + "/ec_registers.json";
+    const QString path = QString::fromStdString(map);
+    CHECK(writeFile(map, "{ \"models\": [\n"
+                         "  { \"boards\": [\"GA401\"], \"cpuDuty\": 16, \"mode\": 17 },\n"
+                         "  { \"boards\": [\"FX506HM\", \"FX506HC\"], \"cpuDuty\": \"0x97\", \"gpuDuty\": \"0x98\",\n"
+                         "    \"maxDuty\": 100, \"mode\": \"0x96\", \"modeManual\": 1, \"modeAuto\": 0 },\n"
+                         "  { \"boards\": [\"FA507\"], \"cpuDuty\": \"0x1ff\", \"mode\": \"0x96\" }\n"
+                         "] }\n"));
+
+    // Matched on the product name, case-insensitively
+    EcFanBackend::Registers registers = EcFanBackend::lookup(path, "Unknown", "ASUS TUF Gaming F15 fx506hm");
+    CHECK(registers.isValid());
+    CHECK_EQ(registers.cpuDuty, 0x97);
+    CHECK_EQ(registers.gpuDuty, 0x98);
+    CHECK_EQ(registers.maxDuty, 100);
+    CHECK_EQ(registers.mode, 0x96);
+    CHECK_EQ(registers.modeManual, 1);
+
+    // Numbers as numbers; gpuDuty and maxDuty optional
+    registers = EcFanBackend::lookup(path, "GA401QM", QString());
+    CHECK(registers.isValid());
+    CHECK_EQ(registers.cpuDuty, 16);
+    CHECK_EQ(registers.gpuDuty, -1);
+    CHECK_EQ(registers.maxDuty, 255);
+
+    // An offset past the register space voids the entry
+    CHECK(!EcFanBackend::lookup(path, "FA507RM", QString()).isValid());
+    // No entry for the model
+    CHECK(!EcFanBackend::lookup(path, "G513QY", "ROG Strix G15").isValid());
+    // No board name at all must not match an entry
+    CHECK(!EcFanBackend::lookup(path, QString(), QString()).isValid());
+
+    CHECK(writeFile(map, "{ \"models\": [ { \"boards\": [\"FX506HM\"], "));
+    CHECK(!EcFanBackend::lookup(path, "FX506HM", QString()).isValid());
+    ::unlink(map.c_str());
+    CHECK(!EcFanBackend::lookup(path, "FX506HM", QString()).isValid());
+}
+
+static void testBackend(const std::string &dir)
+{
+    // A tree with just what EcFanBackend looks at
+    const std::string root = dir + "/root";
+    const std::string io = root + "/sys/kernel/debug/ec/ec0/io";
+    CHECK(writeFile(root + "/sys/class/dmi/id/board_name", "FX506HM\n"));
+    CHECK(writeFile(root + "/sys/class/dmi/id/product_name", "ASUS TUF Gaming F15\n"));
+    CHECK(writeFile(root + "/sys/module/ec_sys/parameters/write_support", "Y\n"));
+    CHECK(writeFile(io, std::string(256, '\0')));
+    CHECK(writeFile(root + "/etc/asus_tuf_ec_registers.json",
+                    "{ \"models\": [ { \"boards\": [\"FX506HM\"], \"mode\": \"0x2f\", \"cpuDuty\": \"0x30\","
+                    " \"gpuDuty\": \"0x31\", \"modeManual\": 1, \"modeAuto\": 0 } ] }\n"));
+    SysRoot::setRoot(QString::fromStdString(root));
+    EmbeddedController::instance().setPath(QString());
+
+    EcFanBackend backend;
+    const FanBackend::Probe &probe = backend.probe();
+    CHECK(probe.available);
+    CHECK(probe.faithful);
+    CHECK_EQ(backend.capabilities(), FanBackend::DutyCycle | FanBackend::PerFan | FanBackend::Readback);
+    takePwrites();
+
+    std::atomic<int> written(0), unchanged(0), failed(0);
+    const HardwareWriteQueue::Callback count = [&](const HardwareWriteQueue::Result &result) {
+        if (result.superseded) return;
+        if (!result.ok) ++failed;
+        else if (result.unchanged) ++unchanged;
+        else ++written;
+    };
+    HardwareWriteQueue &queue = HardwareWriteQueue::instance();
+
+    // Mode and both duties are consecutive: one pwrite
+    backend.apply(50, nullptr, count);
+    queue.drain();
+    CHECK_EQ(written.load(), 1);
+    CHECK_EQ(takePwrites().size(), size_t(1));
+    CHECK_EQ(byteAt(io, 0x2f), 1);
+    CHECK_EQ(byteAt(io, 0x30), FanBackend::scale(50, 255));
+    CHECK_EQ(byteAt(io, 0x31), FanBackend::scale(50, 255));
+    CHECK_EQ(backend.readback(), FanBackend::scale(50, 255));
+
+    // The same batch again: the worker reads the registers and skips it
+    backend.apply(50, nullptr, count);
+    queue.drain();
+    backend.apply(50, nullptr, count);
+    queue.drain();
+    CHECK_EQ(unchanged.load(), 2);
+    CHECK(takePwrites().empty());
+
+    // The firmware took the fan back: the next repeat is written
+    setByte(io, 0x2f, 0);
+    backend.apply(50, nullptr, count);
+    queue.drain();
+    CHECK_EQ(written.load(), 2);
+    CHECK_EQ(byteAt(io, 0x2f), 1);
+
+    // skipIfHeld on a raw EcRegister command
+    HardwareWriteQueue::Command command;
+    command.kind = HardwareWriteQueue::EcRegister;
+    command.target = "fan";
+    const int duty = FanBackend::scale(50, 255);
+    command.value = QString("0x30 %1\n0x31 %2").arg(duty).arg(duty);
+    command.skipIfHeld = true;
+    HardwareWriteQueue::Result result = queue.execute(command);
+    CHECK(result.ok);
+    CHECK(result.unchanged);
+    command.value = "0x30 200";
+    result = queue.execute(command);
+    CHECK(result.ok);
+    CHECK(!result.unchanged);
+    CHECK_EQ(byteAt(io, 0x30), 200);
+
+    backend.revertToAuto();
+    queue.drain();
+    CHECK_EQ(byteAt(io, 0x2f), 0);
+    CHECK_EQ(failed.load(), 0);
+
+    EmbeddedController::instance().setPath(QString::fromStdString(dir + "/none"));
+    SysRoot::setRoot(QString());
+}
+
+static void testPortIo(const std::string &dir)
+{
+    EmbeddedController &ec = EmbeddedController::instance();
+    const std::string port = dir + "/port";
+    CHECK(writeFile(port, std::string(0x67, '\0')));
+    ec.setPortPath(QString::fromStdString(port));
+    CHECK_EQ(ec.method(), EmbeddedController::PortIo);
+    takePwrites();
+
+    // Write: command, register and value, one byte per port write. The file
+    // keeps the last byte written to each port.
+    QString error;
+    CHECK(ec.write(0x30, 0x7f, &error));
+    const std::vector<PwriteCall> calls = takePwrites();
+    CHECK_EQ(calls.size(), size_t(3));
+    if (calls.size() == 3) {
+        CHECK_EQ(calls[0].offset, 0x66LL);
+        CHECK_EQ(calls[1].offset, 0x62LL);
+        CHECK_EQ(calls[2].offset, 0x62LL);
+    }
+    CHECK_EQ(byteAt(port, 0x66), 0x81);
+    CHECK_EQ(byteAt(port, 0x62), 0x7f);
+
+    // Read, against an EC that answers: it waits for the read command and
+    // the register after it, then fills the data port and raises OBF
+    const int kMarker = 0xee;
+    setByte(port, 0x66, 0);
+    setByte(port, 0x62, kMarker);
+    std::atomic<bool> stop(false);
+    std::atomic<int> asked(-1);
+    std::thread firmware([&]() {
+        while (!stop) {
+            const int data = byteAt(port, 0x62);
+            if (byteAt(port, 0x66) == 0x80 && data != kMarker) {
+                asked = data;
+                setByte(port, 0x62, 0x5a);
+                setByte(port, 0x66, 0x01);
+                return;
+            }
+        }
+    });
+    const int value = ec.read(0x30);
+    stop = true;
+    firmware.join();
+    CHECK_EQ(asked.load(), 0x30);
+    CHECK_EQ(value, 0x5a);
+    CHECK_EQ(takePwrites().size(), size_t(2));
+
+    // Stuck EC: input buffer never drains
+    setByte(port, 0x66, 0x02);
+    QElapsedTimer timer;
+    timer.start();
+    CHECK(!ec.write(0x30, 1, &error));
+    CHECK(error == "EC handshake timed out");
+    CHECK(timer.elapsed() >= 100);
+    CHECK_EQ(ec.read(0x30), -1);
+    CHECK(takePwrites().empty());
+
+    // Output buffer never fills: the read times out after sending
+    setByte(port, 0x66, 0);
+    CHECK_EQ(ec.read(0x30), -1);
+
+    ec.setPortPath(QString());
+    ::unlink(port.c_str());
+}
+
+int main()
+{
+    char dir[] = "/tmp/tst_embeddedcontroller.XXXXXX";
+    if (!::mkdtemp(dir)) return EXIT_FAILURE;
+
+    testDebugFs(dir);
+    testLookup(dir);
+    testBackend(dir);
+    testPortIo(dir);
+
+    const std::string rm = std::string("rm -rf ") + dir;
+    if (std::system(rm.c_str()) != 0) return EXIT_FAILURE;
+    return TestSupport::result("tst_embeddedcontroller");
+}
@@ -0,0 +1,128 @@
+// GpuSampler against a tree built by fake_hwtree.py --gpu amdgpu or i915:
+// the values as built, then after rewriting the attributes the way the
+// driver would update them.
+//
+//   tst_gpusampler --sysroot=<fake tree> amdgpu|i915
+//
+// The tree is modified, so give it one of its own.
+
+#include "GpuSampler.h"
+#include "SysRoot.h"
+#include "TestSupport.h"
+
+#include <stdlib.h>
+#include <string>
+#include <unistd.h>
+
+static const char kDevice[] = "/sys/devices/pci0000:00/0000:03:00.0";
+
+static void writeFile(const QString &path, const std::string &text)
+{
+    FILE *out = std::fopen(SysRoot::path(path).toLocal8Bit().constData(), "wb");
+    CHECK(out != nullptr);
+    if (!out) return;
+    std::fwrite(text.data(), 1, text.size(), out);
+    std::fclose(out);
+}
+
+static void testAmdgpu(GpuSampler &sampler)
+{
+    const QString device = QString::fromLatin1(kDevice);
+    double clock = -1, usage = -1;
+    qint64 used = 0, total = 0;
+
+    // As built: idle, lowest clock, 40 °C, 256 MiB of 4 GiB VRAM
+    CHECK(sampler.sample(&clock, &usage));
+    CHECK_NEAR(clock, 500.0, 0.001);
+    CHECK_NEAR(usage, 0.0, 0.001);
+    CHECK_EQ(sampler.temperature(), 40);
+    CHECK(sampler.vram(&used, &total));
+    CHECK_EQ(used, 256LL << 20);
+    CHECK_EQ(total, 4LL << 30);
+
+    // Under load
+    writeFile(device + "/gpu_busy_percent", "63\n");
+    writeFile(device + "/hwmon/hwmon2/freq1_input", "1850000000\n");
+    writeFile(device + "/hwmon/hwmon2/temp1_input", "71500\n");
+    writeFile(device + "/mem_info_vram_used", "1610612736\n");
+    CHECK(sampler.sample(&clock, &usage));
+    CHECK_NEAR(clock, 1850.0, 0.001);
+    CHECK_NEAR(usage, 63.0, 0.001);
+    CHECK_EQ(sampler.temperature(), 71);
+    CHECK(sampler.vram(&used, &total));
+    CHECK_EQ(used, 1610612736LL);
+
+    // No hwmon clock: the current pp_dpm_sclk level
+    writeFile(device + "/hwmon/hwmon2/freq1_input", "0\n");
+    writeFile(device + "/pp_dpm_sclk", "0: 500Mhz\n1: 1400Mhz *\n2: 2200Mhz\n");
+    CHECK(sampler.sample(&clock, &usage));
+    CHECK_NEAR(clock, 1400.0, 0.001);
+
+    // Suspended: reported idle, nothing else read
+    writeFile(device + "/power/runtime_status", "suspended\n");
+    CHECK(sampler.sample(&clock, &usage));
+    CHECK_NEAR(clock, 0.0, 0.001);
+    CHECK_NEAR(usage, 0.0, 0.001);
+    CHECK_EQ(sampler.temperature(), 0);
+    CHECK(!sampler.vram(&used, &total));
+    writeFile(device + "/power/runtime_status", "active\n");
+    CHECK_EQ(sampler.temperature(), 71);
+}
+
+static void testI915(GpuSampler &sampler)
+{
+    const QString card = "/sys/class/drm/card0";
+    double clock = -1, usage = -1;
+    qint64 used = 0, total = 0;
+
+    // As built: in RC6, so the actual clock reads 0; no usage until there
+    // are two residency readings to compare
+    CHECK(sampler.sample(&clock, &usage));
+    CHECK_NEAR(clock, 0.0, 0.001);
+    CHECK_NEAR(usage, 0.0, 0.001);
+    // No sensor and no VRAM of its own
+    CHECK_EQ(sampler.temperature(), 0);
+    CHECK(!sampler.vram(&used, &total));
+
+    // 50 ms of 200 in RC6: about 75% busy
+    writeFile(card + "/gt_act_freq_mhz", "1100\n");
+    writeFile(card + "/gt/gt0/rc6_residency_ms", "50\n");
+    ::usleep(200 * 1000);
+    CHECK(sampler.sample(&clock, &usage));
+    CHECK_NEAR(clock, 1100.0, 0.001);
+    // Wider above than below: the sleep only ever runs long
+    CHECK(usage >= 70.0 && usage <= 80.0);
+
+    // The counter can run a little ahead of the clock: idle, not negative
+    writeFile(card + "/gt/gt0/rc6_residency_ms", "130\n");
+    ::usleep(50 * 1000);
+    CHECK(sampler.sample(&clock, &usage));
+    CHECK_NEAR(usage, 0.0, 0.001);
+
+    // The residency counter going backwards (driver reload) isn't busy time
+    writeFile(card + "/gt/gt0/rc6_residency_ms", "10\n");
+    CHECK(sampler.sample(&clock, &usage));
+    CHECK_NEAR(usage, 0.0, 0.001);
+}
+
+int main(int argc, char **argv)
+{
+    QString driver;
+    for (int i = 1; i < argc; ++i) {
+        const QString arg = QString::fromLocal8Bit(argv[i]);
+        if (arg.startsWith("--sysroot=")) SysRoot::setRoot(arg.mid(10));
+        else driver = arg;
+    }
+    if (!SysRoot::isRelocated() || (driver != "amdgpu" && driver != "i915")) {
+        std::fprintf(stderr, "usage: %s --sysroot=<fake tree> amdgpu|i915\n", argv[0]);
+        return 2;
+    }
+
+    GpuSampler &sampler = GpuSampler::instance();
+    CHECK(sampler.isAvailable());
+    CHECK(sampler.driver() == driver);
+    if (sampler.driver() == "amdgpu") testAmdgpu(sampler);
+    else if (sampler.driver() == "i915") testI915(sampler);
+
+    return TestSupport::result("tst_gpusampler");
+}
@@ -0,0 +1,131 @@
+// NetworkSampler's /proc/net/dev path against canned fixtures, and the
+// counter wrap/reset rule both backends share.
+//
+//   tst_networksampler <fixture dir>
+
+#include "NetworkSampler.h"
+#include "TestSupport.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <string>
+
+// The sampler keeps its descriptor open and preads at 0, so each fixture is
+// copied over the same file (same inode), as the kernel would update it.
+static bool install(int fd, const std::string &fixture)
+{
+    FILE *in = std::fopen(fixture.c_str(), "rb");
+    if (!in) return false;
+    char data[8192];
+    const size_t n = std::fread(data, 1, sizeof(data), in);
+    std::fclose(in);
+    return ::ftruncate(fd, 0) == 0 && ::pwrite(fd, data, n, 0) == static_cast<ssize_t>(n);
+}
+
+static const NetInterfaceStats *find(const NetworkSampler &sampler, const char *name)
+{
+    for (const NetInterfaceStats &iface : sampler.interfaces()) {
+        if (std::strcmp(iface.name, name) == 0) return &iface;
+    }
+    return nullptr;
+}
+
+static void testCounterDelta()
+{
+    CHECK_EQ(NetworkSampler::counterDelta(100, 250), 150ULL);
+    CHECK_EQ(NetworkSampler::counterDelta(7, 7), 0ULL);
+    // 32-bit counter wrapped
+    CHECK_EQ(NetworkSampler::counterDelta(0xFFFFFF00ULL, 0x10ULL), 0x110ULL);
+    CHECK_EQ(NetworkSampler::counterDelta(0xFFFFFFFFULL, 0ULL), 1ULL);
+    CHECK_EQ(NetworkSampler::counterDelta(0xC0000000ULL, 0x100ULL), 0x40000100ULL);
+    // A drop from low in the 32-bit range is a reset, not 3 GB of traffic
+    CHECK_EQ(NetworkSampler::counterDelta(1000000000ULL, 5ULL), 0ULL);
+    CHECK_EQ(NetworkSampler::counterDelta(0x80000000ULL, 0ULL), 0ULL);
+    // A 64-bit counter going down is a reset (driver reload), not a wrap
+    CHECK_EQ(NetworkSampler::counterDelta(0x100000000ULL, 5ULL), 0ULL);
+    CHECK_EQ(NetworkSampler::counterDelta(10000000000ULL, 5000ULL), 0ULL);
+}
+
+static void testProcNetDev(const std::string &fixtures)
+{
+    char path[] = "/tmp/tst_networksampler.XXXXXX";
+    const int fd = ::mkstemp(path);
+    if (!CHECK(fd >= 0)) return;
+
+    {
+        NetworkSampler sampler(QString::fromLocal8Bit(path), false);
+        CHECK(!sampler.usingNetlink());
+
+        CHECK(install(fd, fixtures + "/proc_net_dev.1"));
+        CHECK(!sampler.sample());    // No interval yet
+        CHECK_EQ(sampler.interfaces().size(), 6);   // lo is never listed
+        CHECK(find(sampler, "lo") == nullptr);
+        const NetInterfaceStats *eth0 = find(sampler, "eth0");
+        if (CHECK(eth0)) {
+            CHECK_EQ(eth0->rxBytes, 4294967000ULL);
+            CHECK_EQ(eth0->txBytes, 1000ULL);
+            CHECK_EQ(eth0->rxRate, 0.0);
+        }
+        const NetInterfaceStats *vmnet = find(sampler, "vmnet8");
+        if (CHECK(vmnet)) CHECK(!vmnet->counted);
+        // Other loopbacks are listed, but left out of the totals like lo
+        const NetInterfaceStats *lo1 = find(sampler, "lo1");
+        if (CHECK(lo1)) CHECK(!lo1->counted);
+        if (CHECK(eth0)) CHECK(eth0->counted);
+
+        ::usleep(20000);
+        CHECK(install(fd, fixtures + "/proc_net_dev.2"));
+        CHECK(sampler.sample());
+        const double seconds = sampler.intervalNs() / 1e9;
+        CHECK(seconds > 0);
+
+        // eth0 rx wrapped: (2^32 - 4294967000) + 704 = 1000 bytes
+        eth0 = find(sampler, "eth0");
+        if (CHECK(eth0)) {
+            CHECK_NEAR(eth0->rxRate, 1000 / seconds / 1024.0, 1e-6);
+            CHECK_NEAR(eth0->txRate, 2048 / seconds / 1024.0, 1e-6);
+            CHECK_EQ(eth0->rxBytes, 704ULL);
+        }
+        // eth1 rx reset from low in the 32-bit range: no rate either
+        const NetInterfaceStats *eth1 = find(sampler, "eth1");
+        if (CHECK(eth1)) {
+            CHECK_EQ(eth1->rxRate, 0.0);
+            CHECK_EQ(eth1->rxBytes, 500ULL);
+        }
+        // wlan0 rx reset from a 64-bit value: no rate, not a huge spike
+        const NetInterfaceStats *wlan0 = find(sampler, "wlan0");
+        if (CHECK(wlan0)) {
+            CHECK_EQ(wlan0->rxRate, 0.0);
+            CHECK_NEAR(wlan0->txRate, 1024 / seconds / 1024.0, 1e-6);
+        }
+        // New interface: counters kept, rates start at the next sample
+        const NetInterfaceStats *docker0 = find(sampler, "docker0");
+        if (CHECK(docker0)) {
+            CHECK(docker0->present);
+            CHECK_EQ(docker0->rxBytes, 77ULL);
+            CHECK_EQ(docker0->rxRate, 0.0);
+        }
+        // Gone interface stays listed, without a rate
+        const NetInterfaceStats *usb0 = find(sampler, "usb0");
+        if (CHECK(usb0)) {
+            CHECK(!usb0->present);
+            CHECK_EQ(usb0->rxRate, 0.0);
+        }
+
+        // Totals leave out lo* and vmnet*
+        CHECK_NEAR(sampler.rxRate(), 1000 / seconds / 1024.0, 1e-6);
+        CHECK_NEAR(sampler.txRate(), (2048 + 1024) / seconds / 1024.0, 1e-6);
+    }
+
+    ::close(fd);
+    ::unlink(path);
+}
+
+int main(int argc, char **argv)
+{
+    const std::string fixtures = argc > 1 ? argv[1] : "fixtures";
+
+    testCounterDelta();
+    testProcNetDev(fixtures);
+    return TestSupport::result("tst_networksampler");
+}
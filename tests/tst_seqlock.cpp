@@ -0,0 +1,124 @@
+// Seqlock under contention, with the payload SensorHub actually publishes:
+// one writer storing SensorSnapshots as fast as it can while several
+// readers load them. Every field of a stored snapshot is derived from its
+// sequence number, so a torn read (fields from two different stores) shows
+// up as a snapshot that doesn't match its own sequence.
+//
+//   tst_seqlock [milliseconds] [readers]
+
+#include "SensorHub.h"
+#include "Seqlock.h"
+#include "TestSupport.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+static SensorSnapshot make(quint64 n)
+{
+    SensorSnapshot s;
+    s.cpuTemp = static_cast<int>(n % 100);
+    s.gpuTemp = static_cast<int>((n * 7) % 100);
+    s.cpuFanRpm = static_cast<int>(n % 7000);
+    s.gpuFanRpm = static_cast<int>((n * 3) % 7000);
+    s.hasCpuTemp = n & 1;
+    s.hasGpuTemp = !(n & 1);
+    s.thermalPolicy = static_cast<int>(n % 3);
+    s.cpuUsage = (n % 1000) / 10.0;
+    s.cpuFreq = static_cast<double>(n);
+    s.memoryUsage = (n % 997) / 10.0;
+    s.gpuFreq = static_cast<double>(n) * 2;
+    s.gpuUsage = (n % 991) / 10.0;
+    s.batteryPercent = static_cast<int>(n % 101);
+    s.batteryState = static_cast<SensorSnapshot::BatteryState>(n % 5);
+    s.sysfsSyscallsSaved = static_cast<int>(n % 64);
+    s.sequence = n;
+    s.timestampMs = static_cast<qint64>(n) * 500;
+    return s;
+}
+
+static bool consistent(const SensorSnapshot &s)
+{
+    // Field by field: the padding between them isn't part of the value
+    const SensorSnapshot e = make(s.sequence);
+    return s.cpuTemp == e.cpuTemp && s.gpuTemp == e.gpuTemp && s.cpuFanRpm == e.cpuFanRpm &&
+           s.gpuFanRpm == e.gpuFanRpm && s.hasCpuTemp == e.hasCpuTemp && s.hasGpuTemp == e.hasGpuTemp &&
+           s.thermalPolicy == e.thermalPolicy && s.cpuUsage == e.cpuUsage && s.cpuFreq == e.cpuFreq &&
+           s.memoryUsage == e.memoryUsage && s.gpuFreq == e.gpuFreq && s.gpuUsage == e.gpuUsage &&
+           s.batteryPercent == e.batteryPercent && s.batteryState == e.batteryState &&
+           s.sysfsSyscallsSaved == e.sysfsSyscallsSaved && s.timestampMs == e.timestampMs;
+}
+
+struct ReaderStats {
+    quint64 loads = 0;
+    quint64 torn = 0;
+    quint64 backwards = 0;
+    quint64 distinct = 0;
+};
+
+int main(int argc, char **argv)
+{
+    const int durationMs = argc > 1 ? std::atoi(argv[1]) : 1000;
+    const int readerCount = argc > 2 ? std::atoi(argv[2])
+                                     : qBound(2, static_cast<int>(std::thread::hardware_concurrency()), 8);
+
+    Seqlock<SensorSnapshot> published(make(0));
+    CHECK(consistent(published.load()));
+    const quint32 startVersion = published.version();
+
+    std::atomic<bool> stop{false};
+    std::atomic<int> ready{0};
+    std::vector<ReaderStats> stats(readerCount);
+    std::vector<std::thread> readers;
+
+    for (int r = 0; r < readerCount; ++r) {
+        readers.emplace_back([&, r]() {
+            ReaderStats &mine = stats[r];
+            quint64 last = 0;
+            ready.fetch_add(1);
+            while (!stop.load(std::memory_order_relaxed)) {
+                const SensorSnapshot s = published.load();
+                ++mine.loads;
+                if (!consistent(s)) ++mine.torn;
+                if (s.sequence < last) ++mine.backwards;
+                if (s.sequence != last) ++mine.distinct;
+                last = s.sequence;
+            }
+        });
+    }
+    while (ready.load() < readerCount) std::this_thread::yield();
+
+    quint64 stores = 0;
+    std::thread writer([&]() {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(durationMs);
+        while (std::chrono::steady_clock::now() < deadline) {
+            published.store(make(++stores));
+        }
+        stop.store(true);
+    });
+
+    writer.join();
+    for (std::thread &reader : readers) reader.join();
+
+    ReaderStats total;
+    for (const ReaderStats &s : stats) {
+        total.loads += s.loads;
+        total.torn += s.torn;
+        total.backwards += s.backwards;
+        total.distinct += s.distinct;
+        CHECK(s.loads > 0);
+    }
+    std::printf("%d readers, %d ms: %llu stores, %llu loads, %llu distinct snapshots seen\n",
+                readerCount, durationMs, static_cast<unsigned long long>(stores),
+                static_cast<unsigned long long>(total.loads), static_cast<unsigned long long>(total.distinct));
+
+    CHECK_EQ(total.torn, 0ULL);
+    CHECK_EQ(total.backwards, 0ULL);
+    CHECK(stores > 1000);
+    CHECK(total.distinct > 1);       // Readers kept up with a moving value
+
+    // One version per store, and the last store is what everyone sees now
+    CHECK_EQ(published.version() - startVersion, static_cast<quint32>(stores));
+    CHECK_EQ(published.load().sequence, stores);
+    return TestSupport::result("tst_seqlock");
+}
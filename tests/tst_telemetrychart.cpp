@@ -0,0 +1,140 @@
+// TelemetryChart's incremental append (shift the strips by one sample,
+// rewrite the new point and its joins, scroll with the transform node)
+// against a full rebuild of the same history: after every sync the
+// incrementally kept vertices, mapped through the scroll transform, must
+// match what a rebuild writes.
+//
+//   tst_telemetrychart [appends]
+
+#include "MetricHistory.h"
+#include "TelemetryChart.h"
+#include "TestSupport.h"
+
+#include <QGuiApplication>
+#include <QSGGeometryNode>
+#include <QSGTransformNode>
+#include <cmath>
+
+// updatePaintNode() is what the render thread calls; reach it directly
+class Chart : public TelemetryChart
+{
+public:
+    QSGNode *sync(QSGNode *node) { return updatePaintNode(node, nullptr); }
+};
+
+// Root: grid, then the scroll transform holding fill and line
+struct Strips {
+    const QSGTransformNode *scroll;
+    const QSGGeometry *fill;
+    const QSGGeometry *line;
+};
+
+static Strips strips(const QSGNode *root)
+{
+    const QSGTransformNode *scroll = static_cast<const QSGTransformNode *>(root->childAtIndex(1));
+    return { scroll, static_cast<const QSGGeometryNode *>(scroll->childAtIndex(0))->geometry(),
+             static_cast<const QSGGeometryNode *>(scroll->childAtIndex(1))->geometry() };
+}
+
+// Largest distance between incremental and rebuilt vertices; -1 if the
+// layouts differ
+static double compare(const QSGNode *incremental, const QSGNode *rebuilt)
+{
+    const Strips a = strips(incremental);
+    const Strips b = strips(rebuilt);
+    if (a.line->vertexCount() != b.line->vertexCount() || a.fill->vertexCount() != b.fill->vertexCount())
+        return -1;
+    if (!b.scroll->matrix().isIdentity()) return -1;
+
+    double worst = 0;
+    const QMatrix4x4 &m = a.scroll->matrix();
+    const QSGGeometry::Point2D *la = a.line->vertexDataAsPoint2D();
+    const QSGGeometry::Point2D *lb = b.line->vertexDataAsPoint2D();
+    for (int i = 0; i < a.line->vertexCount(); ++i) {
+        const QPointF p = m.map(QPointF(la[i].x, la[i].y));
+        worst = qMax(worst, std::fabs(p.x() - lb[i].x) + std::fabs(p.y() - lb[i].y));
+    }
+    const QSGGeometry::ColoredPoint2D *fa = a.fill->vertexDataAsColoredPoint2D();
+    const QSGGeometry::ColoredPoint2D *fb = b.fill->vertexDataAsColoredPoint2D();
+    for (int i = 0; i < a.fill->vertexCount(); ++i) {
+        const QPointF p = m.map(QPointF(fa[i].x, fa[i].y));
+        worst = qMax(worst, std::fabs(p.x() - fb[i].x) + std::fabs(p.y() - fb[i].y));
+        if (fa[i].r != fb[i].r || fa[i].g != fb[i].g || fa[i].b != fb[i].b || fa[i].a != fb[i].a) return -1;
+    }
+    return worst;
+}
+
+// The chart under test keeps its node; the reference, set up the same way
+// (autoscale keeps state, so it has to see the same appends), builds a
+// new one on every sync
+struct Pair {
+    Chart chart;
+    Chart reference;
+    QSGNode *node = nullptr;
+
+    ~Pair() { delete node; }
+    void setSize(const QSizeF &size) { chart.setSize(size); reference.setSize(size); }
+    void setAutoScale(bool on) { chart.setAutoScale(on); reference.setAutoScale(on); }
+    void setHistory(MetricHistory *history) { chart.setHistory(history); reference.setHistory(history); }
+};
+
+// Appends `appends` samples, syncing after each (or after every second one
+// when `pairs`), and checks the chart against a rebuild every time.
+// Returns how many syncs took the incremental path.
+static int run(MetricHistory *history, Pair *charts, int appends, int seed, bool pairs = false)
+{
+    int incremental = 0;
+    double worst = 0;
+    for (int i = 0; i < appends; ++i) {
+        history->append(50 + 40 * std::sin((i + seed) * 0.21) + 5 * std::sin((i + seed) * 1.7));
+        if (pairs && i % 2 == 0) continue;
+
+        charts->node = charts->chart.sync(charts->node);
+        QSGNode *rebuilt = charts->reference.sync(nullptr);
+        if (!strips(charts->node).scroll->matrix().isIdentity()) ++incremental;
+
+        const double diff = compare(charts->node, rebuilt);
+        delete rebuilt;
+        if (diff < 0) {
+            CHECK(diff >= 0);
+            return incremental;
+        }
+        worst = qMax(worst, diff);
+    }
+    CHECK(worst < 1e-3);
+    return incremental;
+}
+
+int main(int argc, char **argv)
+{
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+    QGuiApplication app(argc, argv);
+    const int appends = argc > 1 ? qMax(200, atoi(argv[1])) : 400;
+    const int capacity = 60;
+
+    MetricHistory history(capacity);
+    Pair charts;
+    charts.setSize(QSizeF(300, 70));
+    charts.setHistory(&history);
+
+    // Fixed range: once the ring is full every sync is incremental except
+    // one rebuild per window to rebase x
+    int incremental = run(&history, &charts, appends, 0);
+    const int full = appends - capacity;
+    CHECK_EQ(incremental, full - full / capacity);
+
+    // Autoscale: range changes rebuild, the rest must still match
+    charts.setAutoScale(true);
+    incremental = run(&history, &charts, appends, 1000);
+    CHECK(incremental > 0);
+
+    // Two appends per sync can't be shifted in one step: always rebuilt
+    CHECK_EQ(run(&history, &charts, 40, 2000, true), 0);
+
+    // Resize and capacity change rebuild, then the incremental path resumes
+    charts.setSize(QSizeF(412, 96));
+    history.setCapacity(45);
+    CHECK(run(&history, &charts, appends, 3000) > 0);
+
+    return TestSupport::result("tst_telemetrychart");
+}
@@ -1,5 +1,6 @@
 import QtQuick 2.15
 import QtQuick.Layouts 1.15
+import AsusTufFanControl 1.0
 
 Item {
     id: root
@@ -58,103 +59,29 @@ Item {
         }
     }
     
-    // Canvas gauge
-    Canvas {
-        id: canvas
+    // Native gauge; only the sweep end is rewritten while animating
+    ArcGauge {
         anchors.fill: parent
-        antialiasing: true
-        renderStrategy: Canvas.Threaded
-        
-        onPaint: {
-            var ctx = getContext("2d")
-            if (!ctx) return
-            
-            ctx.clearRect(0, 0, width, height)
-            
-            var cx = width / 2
-            var cy = height / 2
-            var radius = (Math.min(width, height) / 2) - root.strokeWidth - 14
-            
-            var startAngle = 0.70 * Math.PI
-            var endAngle = 2.30 * Math.PI
-            var sweepAngle = endAngle - startAngle
-            
-            var progress = Math.min(1.0, root.animatedValue / root.maxValue)
-            var progressAngle = startAngle + (sweepAngle * progress)
-            
-            // Shadow for depth
-            if (appTheme && !_isDark) {
-                ctx.beginPath()
-                ctx.arc(cx, cy + 3, radius, 0, 2 * Math.PI)
-                ctx.fillStyle = Qt.rgba(0, 0, 0, 0.04)
-                ctx.fill()
-            }
-            
-            // Background track (shows full arc path)
-            ctx.beginPath()
-            ctx.arc(cx, cy, radius, startAngle, endAngle)
-            ctx.lineWidth = root.strokeWidth + 4
-            ctx.strokeStyle = _isDark ? Qt.rgba(0.25, 0.25, 0.25, 0.8) : Qt.rgba(0.80, 0.80, 0.80, 0.8)
-            ctx.lineCap = "round"
-            ctx.stroke()
-            
-            // Progress
-            if (progress > 0.01) {
-                var progressGrad = ctx.createLinearGradient(0, 0, width, height)
-                progressGrad.addColorStop(0, root.progressColor)
-                progressGrad.addColorStop(0.5, Qt.lighter(root.progressColor, 1.5))
-                progressGrad.addColorStop(1, root.progressColor)
-                
-                ctx.beginPath()
-                ctx.arc(cx, cy, radius, startAngle, progressAngle)
-                ctx.lineWidth = root.strokeWidth
-                ctx.strokeStyle = progressGrad
-                ctx.lineCap = "round"
-                ctx.stroke()
-                
-                // Glow
-                ctx.globalAlpha = 0.30
-                ctx.lineWidth = root.strokeWidth + 6
-                ctx.stroke()
-                ctx.globalAlpha = 1.0
-                
-                // Endpoint dot
-                var dotX = cx + radius * Math.cos(progressAngle)
-                var dotY = cy + radius * Math.sin(progressAngle)
-                
-                ctx.beginPath()
-                ctx.arc(dotX, dotY, 11, 0, 2 * Math.PI)
-                ctx.fillStyle = "#ffffff"
-                ctx.fill()
-                
-                ctx.beginPath()
-                ctx.arc(dotX, dotY, 9, 0, 2 * Math.PI)
-                ctx.fillStyle = root.progressColor
-                ctx.fill()
-            }
-            
-            // Ticks - solid color for visibility
-            ctx.strokeStyle = _isDark ? "#666666" : "#999999"
-            ctx.lineWidth = 3
-            for (var i = 0; i <= 10; i++) {
-                var tickAngle = startAngle + (sweepAngle * i / 10)
-                var major = (i % 5 === 0)
-                var tickR1 = radius + root.strokeWidth / 2 + 10
-                var tickR2 = tickR1 + (major ? 9 : 5)
-                
-                ctx.beginPath()
-                ctx.moveTo(cx + tickR1 * Math.cos(tickAngle), cy + tickR1 * Math.sin(tickAngle))
-                ctx.lineTo(cx + tickR2 * Math.cos(tickAngle), cy + tickR2 * Math.sin(tickAngle))
-                ctx.stroke()
-            }
-        }
-        
-        Connections {
-            target: root
-            function onAnimatedValueChanged() { canvas.requestPaint() }
-        }
-        
-        Component.onCompleted: requestPaint()
+        value: root.animatedValue
+        maxValue: root.maxValue
+        arcRadius: (Math.min(width, height) / 2) - root.strokeWidth - 14
+        trackWidth: root.strokeWidth + 4
+        progressWidth: root.strokeWidth
+        glowWidth: root.strokeWidth + 6
+        glowOpacity: 0.30
+        trackColor: _isDark ? Qt.rgba(0.25, 0.25, 0.25, 0.8) : Qt.rgba(0.80, 0.80, 0.80, 0.8)
+        progressColor: root.progressColor
+        highlightColor: Qt.lighter(root.progressColor, 1.5)
+        knobRadius: 11
+        knobInnerRadius: 9
+        tickColor: _isDark ? "#666666" : "#999999"
+        tickCount: 10
+        majorTickInterval: 5
+        tickOffset: root.strokeWidth / 2 + 10
+        majorTickLength: 9
+        minorTickLength: 5
+        // Shadow for depth
+        shadowColor: (appTheme && !_isDark) ? Qt.rgba(0, 0, 0, 0.04) : "transparent"
     }
     
     // Center display (no background circle)
@@ -1,12 +1,13 @@
 import QtQuick 2.15
 import QtQuick.Layouts 1.15
+import AsusTufFanControl 1.0
 
 Rectangle {
     id: root
     property string title: "Graph"
     property string icon: ""
     property string suffix: "%"
-    property var dataModel: [] // Array of values 0-100
+    property var history: null // MetricHistory (count / at(i)), read in place
     property string currentValue: "0"
     property string extraText: ""
     property color graphColor: "#0078d4"
@@ -119,162 +120,35 @@ Rectangle {
             
             Item { Layout.fillHeight: true; Layout.minimumHeight: 8 }
             
-            // Premium Graph Canvas with glow
-            Item {
+            // Native scene-graph chart; geometry is updated in C++ per sample
+            TelemetryChart {
+                id: chart
                 Layout.fillWidth: true
                 Layout.preferredHeight: 70
-                
-                // Subtle grid lines
-                Canvas {
-                    id: gridCanvas
-                    anchors.fill: parent
-                    onPaint: {
-                        var ctx = getContext("2d")
-                        ctx.clearRect(0, 0, width, height)
-                        ctx.strokeStyle = theme.isDark ? Qt.rgba(255,255,255,0.05) : Qt.rgba(0,0,0,0.05)
-                        ctx.lineWidth = 1
-                        
-                        // Horizontal lines
-                        for (var i = 0; i <= 4; i++) {
-                            var y = (height / 4) * i
-                            ctx.beginPath()
-                            ctx.moveTo(0, y)
-                            ctx.lineTo(width, y)
-                            ctx.stroke()
-                        }
-                    }
-                }
-                
-                // Main graph with glow effect
-                Canvas {
-                    id: graph
-                    anchors.fill: parent
-                    // NOTE: Do NOT set contextType here. In Qt6, contextType causes
-                    // `context` to be null on the first paint cycle, silently skipping
-                    // all rendering. Use getContext("2d") inside onPaint instead.
-                    
-                    onPaint: {
-                        var ctx = getContext("2d");
-                        if (!ctx) return; // Safety: skip if context not ready
-                        ctx.clearRect(0, 0, width, height);
-                        
-                        if (root.dataModel.length < 2) return;
-                        
-                        var stepX = width / (root.dataModel.length - 1);
-                        var minVal = 0;
-                        var maxVal = root.maxValue;
-                        
-                        if (root.autoScale) {
-                            minVal = 999999;
-                            maxVal = -999999;
-                            for(var k=0; k<root.dataModel.length; k++) {
-                                var v = root.dataModel[k];
-                                if(v < minVal) minVal = v;
-                                if(v > maxVal) maxVal = v;
-                            }
-                            var range = maxVal - minVal;
-                            if (range < 2) { 
-                                var mid = (minVal + maxVal) / 2;
-                                minVal = Math.max(0, mid - 1);
-                                maxVal = mid + 1;
-                            }
-                            minVal -= range * 0.1; 
-                            maxVal += range * 0.1;
-                            if (minVal < 0) minVal = 0;
-                        }
-                        
-                        // Premium gradient fill
-                        var gradient = ctx.createLinearGradient(0, 0, 0, height);
-                        gradient.addColorStop(0, Qt.rgba(root.graphColor.r, root.graphColor.g, root.graphColor.b, 0.35));
-                        gradient.addColorStop(0.5, Qt.rgba(root.graphColor.r, root.graphColor.g, root.graphColor.b, 0.15));
-                        gradient.addColorStop(1, Qt.rgba(root.graphColor.r, root.graphColor.g, root.graphColor.b, 0.02));
-                        
-                        ctx.beginPath();
-                        ctx.moveTo(0, height);
-                        
-                        for (var i = 0; i < root.dataModel.length; i++) {
-                            var val = root.dataModel[i];
-                            var norm = (val - minVal) / (maxVal - minVal);
-                            norm = Math.max(0, Math.min(1, norm));
-                            var y = height - (norm * height);
-                            
-                            // Smooth curve using quadratic bezier
-                            if (i === 0) {
-                                ctx.lineTo(0, y);
-                            } else {
-                                var prevX = (i - 1) * stepX;
-                                var prevVal = root.dataModel[i - 1];
-                                var prevNorm = (prevVal - minVal) / (maxVal - minVal);
-                                prevNorm = Math.max(0, Math.min(1, prevNorm));
-                                var prevY = height - (prevNorm * height);
-                                
-                                var cpX = (prevX + i * stepX) / 2;
-                                ctx.quadraticCurveTo(cpX, prevY, i * stepX, y);
-                            }
-                        }
-                        
-                        ctx.lineTo((root.dataModel.length-1) * stepX, height);
-                        ctx.closePath();
-                        ctx.fillStyle = gradient;
-                        ctx.fill();
-                        
-                        // Glowing stroke line
-                        ctx.beginPath();
-                        ctx.strokeStyle = root.graphColor;
-                        ctx.lineWidth = 3;
-                        ctx.lineCap = "round";
-                        ctx.lineJoin = "round";
-                        
-                        // Add shadow/glow
-                        ctx.shadowColor = root.graphColor;
-                        ctx.shadowBlur = 8;
-                        
-                        for (var j = 0; j < root.dataModel.length; j++) {
-                            var val2 = root.dataModel[j];
-                            var norm2 = (val2 - minVal) / (maxVal - minVal);
-                            norm2 = Math.max(0, Math.min(1, norm2));
-                            var y2 = height - (norm2 * height);
-                            
-                            if (j === 0) {
-                                ctx.moveTo(0, y2);
-                            } else {
-                                var prevX2 = (j - 1) * stepX;
-                                var prevVal2 = root.dataModel[j - 1];
-                                var prevNorm2 = (prevVal2 - minVal) / (maxVal - minVal);
-                                prevNorm2 = Math.max(0, Math.min(1, prevNorm2));
-                                var prevY2 = height - (prevNorm2 * height);
-                                
-                                var cpX2 = (prevX2 + j * stepX) / 2;
-                                ctx.quadraticCurveTo(cpX2, prevY2, j * stepX, y2);
-                            }
-                        }
-                        ctx.stroke();
-                        
-                        // Draw current value dot with glow
-                        if (root.dataModel.length > 0) {
-                            var lastVal = root.dataModel[root.dataModel.length - 1];
-                            var lastNorm = (lastVal - minVal) / (maxVal - minVal);
-                            lastNorm = Math.max(0, Math.min(1, lastNorm));
-                            var lastY = height - (lastNorm * height);
-                            var lastX = (root.dataModel.length - 1) * stepX;
-                            
-                            // Outer glow ring
-                            ctx.beginPath();
-                            ctx.arc(lastX, lastY, 8, 0, 2 * Math.PI);
-                            ctx.fillStyle = Qt.rgba(root.graphColor.r, root.graphColor.g, root.graphColor.b, 0.2);
-                            ctx.fill();
-                            
-                            // Inner dot
-                            ctx.beginPath();
-                            ctx.arc(lastX, lastY, 4, 0, 2 * Math.PI);
-                            ctx.fillStyle = root.graphColor;
-                            ctx.fill();
-                            
-                            // Center highlight
-                            ctx.beginPath();
-                            ctx.arc(lastX - 1, lastY - 1, 1.5, 0, 2 * Math.PI);
-                            ctx.fillStyle = "#ffffff";
-                            ctx.fill();
+                history: root.history
+                color: root.graphColor
+                gridColor: theme.isDark ? Qt.rgba(1, 1, 1, 0.05) : Qt.rgba(0, 0, 0, 0.05)
+                maxValue: root.maxValue
+                autoScale: root.autoScale
+
+                // Current value dot with glow
+                Rectangle {
+                    visible: root.history !== null && root.history.count > 0
+                    x: chart.lastPoint.x - width / 2
+                    y: chart.lastPoint.y - height / 2
+                    width: 16; height: 16; radius: 8
+                    color: Qt.rgba(root.graphColor.r, root.graphColor.g, root.graphColor.b, 0.2)
+
+                    Rectangle {
+                        anchors.centerIn: parent
+                        width: 8; height: 8; radius: 4
+                        color: root.graphColor
+
+                        // Center highlight
+                        Rectangle {
+                            x: 1.5; y: 1.5
+                            width: 3; height: 3; radius: 1.5
+                            color: "#ffffff"
                         }
                     }
                 }
@@ -283,9 +157,4 @@ Rectangle {
 
         }
     }
-    
-    onDataModelChanged: {
-        graph.requestPaint()
-        gridCanvas.requestPaint()
-    }
 }
@@ -1,5 +1,6 @@
 import QtQuick 2.15
 import QtQuick.Layouts 1.15
+import AsusTufFanControl 1.0
 
 Rectangle {
     id: root
@@ -159,99 +160,27 @@ Rectangle {
                     width: Math.min(parent.width, parent.height)
                     height: width
                     
-                    // Main gauge canvas
-                    Canvas {
-                        id: gaugeCanvas
+                    // Native gauge; only the sweep end is rewritten while animating
+                    ArcGauge {
                         anchors.fill: parent
-                        antialiasing: true
-                        renderStrategy: Canvas.Threaded
-                        
-                        property real displayValue: root.showRpm ? root.animatedRpm : root.animatedUsage
-                        
-                        onDisplayValueChanged: requestPaint()
-                        
-                        onPaint: {
-                            var ctx = getContext("2d")
-                            if (!ctx) return
-                            
-                            ctx.clearRect(0, 0, width, height)
-                            
-                            var cx = width / 2
-                            var cy = height / 2
-                            var outerR = (width / 2) - 20
-                            var innerR = outerR - 18
-                            
-                            var startAngle = 0.70 * Math.PI
-                            var endAngle = 2.30 * Math.PI
-                            var fullSweep = endAngle - startAngle
-                            
-                            // Calculate progress
-                            var progress = 0.0
-                            if (root.showRpm) {
-                                progress = Math.min(1.0, displayValue / 6000.0)
-                            } else {
-                                progress = Math.min(1.0, displayValue / 100.0)
-                            }
-                            
-                            // Background track (shows full arc path)
-                            ctx.beginPath()
-                            ctx.arc(cx, cy, outerR, startAngle, endAngle)
-                            ctx.lineWidth = 20
-                            ctx.strokeStyle = _isDark ? Qt.rgba(0.25, 0.25, 0.25, 0.8) : Qt.rgba(0.80, 0.80, 0.80, 0.8)
-                            ctx.lineCap = "round"
-                            ctx.stroke()
-                            
-                            // Progress arc with gradient
-                            if (progress > 0.01) {
-                                var progressGradient = ctx.createLinearGradient(0, 0, width, height)
-                                progressGradient.addColorStop(0, root.accentColor)
-                                progressGradient.addColorStop(0.5, Qt.lighter(root.accentColor, 1.4))
-                                progressGradient.addColorStop(1, root.accentColor)
-                                
-                                ctx.beginPath()
-                                ctx.arc(cx, cy, outerR, startAngle, startAngle + (fullSweep * progress))
-                                ctx.lineWidth = 22
-                                ctx.strokeStyle = progressGradient
-                                ctx.lineCap = "round"
-                                ctx.stroke()
-                                
-                                // Inner glow
-                                ctx.globalAlpha = 0.40
-                                ctx.lineWidth = 28
-                                ctx.stroke()
-                                ctx.globalAlpha = 1.0
-                                
-                                // Endpoint dot
-                                var progressAngle = startAngle + (fullSweep * progress)
-                                var dotX = cx + outerR * Math.cos(progressAngle)
-                                var dotY = cy + outerR * Math.sin(progressAngle)
-                                
-                                ctx.beginPath()
-                                ctx.arc(dotX, dotY, 12, 0, 2 * Math.PI)
-                                ctx.fillStyle = "#ffffff"
-                                ctx.fill()
-                                
-                                ctx.beginPath()
-                                ctx.arc(dotX, dotY, 9, 0, 2 * Math.PI)
-                                ctx.fillStyle = root.accentColor
-                                ctx.fill()
-                            }
-                            
-                            // Tick marks - solid color for visibility
-                            ctx.strokeStyle = _isDark ? "#666666" : "#999999"
-                            ctx.lineWidth = 3
-                            for (var i = 0; i <= 12; i++) {
-                                var tickAngle = startAngle + (fullSweep * i / 12)
-                                var isMajor = (i % 3 === 0)
-                                var tickR1 = outerR + 14
-                                var tickR2 = tickR1 + (isMajor ? 8 : 5)
-                                
-                                ctx.beginPath()
-                                ctx.moveTo(cx + tickR1 * Math.cos(tickAngle), cy + tickR1 * Math.sin(tickAngle))
-                                ctx.lineTo(cx + tickR2 * Math.cos(tickAngle), cy + tickR2 * Math.sin(tickAngle))
-                                ctx.stroke()
-                            }
-                        }
+                        value: root.showRpm ? root.animatedRpm : root.animatedUsage
+                        maxValue: root.showRpm ? 6000 : 100
+                        arcRadius: (width / 2) - 20
+                        trackWidth: 20
+                        progressWidth: 22
+                        glowWidth: 28
+                        glowOpacity: 0.40
+                        trackColor: _isDark ? Qt.rgba(0.25, 0.25, 0.25, 0.8) : Qt.rgba(0.80, 0.80, 0.80, 0.8)
+                        progressColor: root.accentColor
+                        highlightColor: Qt.lighter(root.accentColor, 1.4)
+                        knobRadius: 12
+                        knobInnerRadius: 9
+                        tickColor: _isDark ? "#666666" : "#999999"
+                        tickCount: 12
+                        majorTickInterval: 3
+                        tickOffset: 14
+                        majorTickLength: 8
+                        minorTickLength: 5
                     }
                     
                     // Center text display (no background circle)
@@ -11,35 +11,8 @@ Item {
     property var monitor
     property var theme
     
-    // History Data (Moved from Main.qml)
-    property var ramHistory: []
-    property var diskHistory: []
-    property var netDownHistory: []
-    property var netUpHistory: []
-    property var tempHistory: []
-    property var cpuHistory: []
-    property var gpuHistory: []
-
-    // Timer for Graphs
-    Timer { 
-        interval: 1000; running: true; repeat: true; 
-        onTriggered: {
-            backend.statsUpdated(); // Fetch backend temps
-            
-            // CRITICAL: Use .slice() to create a NEW array reference on every update.
-            // Without this, `var x = someHistory` copies the reference (not the data),
-            // and `someHistory = x` assigns the SAME reference back.
-            // QML compares property values by reference for arrays — identical ref = no
-            // change signal = onDataModelChanged never fires = requestPaint() never called
-            // = blank graphs. .slice() creates a shallow copy with a new identity.
-            var rh = ramHistory.slice(); rh.push(monitor.memoryUsage); if(rh.length>60) rh.shift(); ramHistory = rh;
-            var dh = diskHistory.slice(); dh.push(monitor.diskUsage); if(dh.length>60) dh.shift(); diskHistory = dh;
-            var th = tempHistory.slice(); th.push(backend.cpuTemp); if(th.length>60) th.shift(); tempHistory = th;
-            var nd = netDownHistory.slice(); nd.push(monitor.netDown); if(nd.length>60) nd.shift(); netDownHistory = nd;
-            var ch = cpuHistory.slice(); ch.push(monitor.cpuUsage); if(ch.length>60) ch.shift(); cpuHistory = ch;
-            var gh = gpuHistory.slice(); gh.push(monitor.gpuUsage); if(gh.length>60) gh.shift(); gpuHistory = gh;
-        } 
-    }
+    // Graph histories live in C++ (monitor.cpuHistory, ...): fixed ring
+    // buffers appended once per second, read in place by GraphCard
 
     // Helper
     function formatNet(kb) {
@@ -229,7 +202,7 @@ Item {
                     suffix: "%"
                     currentValue: monitor.cpuUsage.toFixed(1)
                     extraText: qsTr("History")
-                    dataModel: cpuHistory
+                    history: monitor.cpuHistory
                     maxValue: 100
                     graphColor: theme.accent // Revert to Blue
                 }
@@ -240,7 +213,7 @@ Item {
                     suffix: "%"
                     currentValue: monitor.gpuUsage.toFixed(1)
                     extraText: qsTr("History")
-                    dataModel: gpuHistory
+                    history: monitor.gpuHistory
                     maxValue: 100
                     graphColor: "#448aff" 
                 }
@@ -251,7 +224,7 @@ Item {
                     suffix: "%"
                     currentValue: monitor.memoryUsage.toFixed(1)
                     extraText: qsTr("System Memory")
-                    dataModel: ramHistory
+                    history: monitor.ramHistory
                     maxValue: 100
                     graphColor: "#00bfa5" 
                 }
@@ -262,7 +235,7 @@ Item {
                     suffix: ""
                     currentValue: formatNet(monitor.netDown)
                     extraText: qsTr("Up: ") + formatNet(monitor.netUp)
-                    dataModel: netDownHistory
+                    history: monitor.netDownHistory
                     maxValue: 1000 
                     autoScale: true
                     graphColor: "#e040fb"